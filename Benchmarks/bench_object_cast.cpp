@@ -0,0 +1,144 @@
+#include "Repository/FSRep/realisation/fs_repository.h"
+#include "Entity/FSObject/interface/object_cast.h"
+#include "Entity/User/user.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Листинг и обход дерева: dynamic_cast против тега типа и asDirectory()/asLockable().
+ *
+ * Дерево строится в FileSystemRepository: 8 поддиректорий на уровень, 3 уровня и files
+ * файлов в каждой директории. "listing" классифицирует детей одной большой директории
+ * (100 * files файлов и 10 * files поддиректорий), как
+ * FileSystemService::listDirectory; "scan" обходит всё дерево по снимкам детей, отделяя
+ * поддиректории от файлов и проверяя блокировку файлов, как FileSystemScanner.
+ * Прежние версии воспроизведены с dynamic_cast.
+ *
+ * Запуск: bench_object_cast [файлов в директории], по умолчанию 200.
+ */
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    volatile size_t sink = 0;  ///< Не даёт компилятору выбросить результаты
+
+    /**
+     * @brief Построить дерево глубины depth.
+     * @param repo Репозиторий
+     * @param parent Родительская директория
+     * @param depth Оставшаяся глубина
+     * @param fanout Поддиректорий в директории
+     * @param files Файлов в директории
+     * @param owner Владелец
+     */
+    void build(FileSystemRepository& repo, IDirectory* parent, int depth, int fanout, int files, const User& owner) {
+        unsigned int parentAddress = parent->asObject()->getAddress();
+        for (int i = 0; i < files; i++) {
+            ObjectPtr file = repo.allocateFile("f" + std::to_string(i), parentAddress, owner, repo.getAddress());
+            parent->addChild(file.get());
+            repo.saveObject(std::move(file));
+        }
+        if (depth == 0) return;
+        for (int i = 0; i < fanout; i++) {
+            ObjectPtr dir = repo.allocateDirectory("d" + std::to_string(i), parentAddress, owner, repo.getAddress());
+            IDirectory* child = dir->asDirectory();
+            parent->addChild(dir.get());
+            repo.saveObject(std::move(dir));
+            build(repo, child, depth - 1, fanout, files, owner);
+        }
+    }
+
+    /**
+     * @brief Классифицировать детей директории.
+     * @param directory Директория
+     * @return Количество файлов
+     */
+    template<bool Tagged>
+    size_t list(IDirectory* directory) {
+        size_t files = 0;
+        for (IFileSystemObject* child : *directory->snapshotChildren()) {
+            if constexpr (Tagged) files += child->getType() == ObjectType::File;
+            else files += dynamic_cast<IFile*>(child) != nullptr && dynamic_cast<IDirectory*>(child) == nullptr;
+        }
+        return files;
+    }
+
+    /**
+     * @brief Обойти дерево, как сканер статистики.
+     * @param root Корень
+     * @return Количество прочитанных файлов
+     */
+    template<bool Tagged>
+    size_t scan(IDirectory* root) {
+        size_t readable = 0;
+        std::vector<IDirectory*> pending = {root};
+        while (!pending.empty()) {
+            IDirectory* directory = pending.back();
+            pending.pop_back();
+            for (IFileSystemObject* child : *directory->snapshotChildren()) {
+                IDirectory* subdirectory = Tagged ? child->asDirectory() : dynamic_cast<IDirectory*>(child);
+                if (subdirectory) {
+                    pending.push_back(subdirectory);
+                    continue;
+                }
+                ILockable* lockable = Tagged ? child->asLockable() : dynamic_cast<ILockable*>(child);
+                readable += !lockable || lockable->isReadable();
+            }
+            IFileSystemObject* object = Tagged ? directory->asObject() : dynamic_cast<IFileSystemObject*>(directory);
+            readable += object->getAddress() == 0;
+        }
+        return readable;
+    }
+
+    /**
+     * @brief Измерить функцию.
+     * @param rounds Количество повторов
+     * @param objects Объектов за повтор
+     * @param body Функция
+     * @return Наносекунды на объект
+     */
+    template<typename Body>
+    double measure(int rounds, size_t objects, Body body) {
+        auto start = Clock::now();
+        for (int i = 0; i < rounds; i++) sink = sink + body();
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(objects * rounds);
+    }
+}
+
+int main(int argc, char** argv) {
+    int files = argc > 1 ? std::atoi(argv[1]) : 200;
+    if (files < 1) files = 1;
+    FileSystemRepository repo;
+    User owner(1, "admin");
+    IDirectory* root = repo.getRootDirectory();
+    build(repo, root, 3, 8, files, owner);
+    size_t objects = repo.getAllObjects().size();
+
+    ObjectPtr wide = repo.allocateDirectory("wide", 0, owner, repo.getAddress());
+    IDirectory* wideDir = wide->asDirectory();
+    root->addChild(wide.get());
+    repo.saveObject(std::move(wide));
+    build(repo, wideDir, 0, 0, files * 100, owner);
+    for (int i = 0; i < files * 10; i++) {
+        ObjectPtr dir = repo.allocateDirectory("w" + std::to_string(i), wideDir->asObject()->getAddress(), owner, repo.getAddress());
+        wideDir->addChild(dir.get());
+        repo.saveObject(std::move(dir));
+    }
+    size_t wideChildren = static_cast<size_t>(wideDir->getChildCount());
+
+    std::cout << "objects: " << objects << ", wide directory: " << wideChildren << " children (ns/object)\n"
+              << std::left << std::setw(10) << "pass" << std::right
+              << std::setw(14) << "dynamic_cast" << std::setw(14) << "type tag" << std::setw(10) << "speedup" << "\n";
+    auto row = [](const char* label, double before, double after) {
+        std::cout << std::left << std::setw(10) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << before << std::setw(14) << after << std::setw(10) << before / after << "\n";
+    };
+    row("listing", measure(50, wideChildren, [&] { return list<false>(wideDir); }),
+                   measure(50, wideChildren, [&] { return list<true>(wideDir); }));
+    row("scan", measure(5, objects, [&] { return scan<false>(root); }),
+                measure(5, objects, [&] { return scan<true>(root); }));
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "Entity/FSObject/realisation/fs_object.h"
+#include "Entity/ACL/acl_class.h"
+#include "Entity/User/user.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Память на заголовок объекта файловой системы: прежняя раскладка против компактной.
+ *
+ * Прежняя раскладка воспроизведена структурой LegacyHeader: полная копия User (с именем
+ * и множеством групп), две system_clock::time_point и ACL. Компактная - сам
+ * FileSystemObject: идентификатор владельца в ACL, 32-битные метки времени и тег типа.
+ * Учитываются sizeof объекта и все выделения кучи при его создании.
+ *
+ * Запуск: bench_object_header [количество объектов], по умолчанию 10 000 000.
+ */
+namespace {
+    std::atomic<size_t> allocated{0};  ///< Байт выделено через operator new
+
+    /**
+     * @brief ACL в прежней раскладке: владелец и собственное дерево записей.
+     */
+    struct LegacyACL {
+        unsigned int ownerId;                   ///< Идентификатор владельца
+        std::map<ACLKey, ACLEntry> entries;     ///< Записи ACL
+    };
+
+    /**
+     * @brief Заголовок объекта в прежней раскладке.
+     */
+    struct LegacyHeader {
+        virtual ~LegacyHeader() = default;
+        std::string name;                                       ///< Имя объекта
+        unsigned int address;                                   ///< Адрес в файловой системе
+        unsigned int parentAddress;                             ///< Адрес родительской директории
+        User owner;                                             ///< Полная копия владельца
+        LegacyACL acl;                                          ///< Список контроля доступа
+        std::chrono::system_clock::time_point creationTime;     ///< Время создания
+        std::chrono::system_clock::time_point lastModifyTime;   ///< Время последнего изменения
+
+        LegacyHeader(const std::string& n, unsigned int parAddress, const User& owner, unsigned int adr) :
+        name(n), address(adr), parentAddress(parAddress), owner(owner), acl{owner.getId(), {}},
+        creationTime(std::chrono::system_clock::now()), lastModifyTime(creationTime) {}
+    };
+
+    /**
+     * @brief Создать объекты и вернуть байт на объект.
+     * @param count Количество объектов
+     * @param make Функция, создающая объект по номеру
+     * @return Средний расход памяти на объект (sizeof + куча)
+     */
+    template<typename T, typename Make>
+    double measure(size_t count, Make make) {
+        std::vector<std::unique_ptr<T>> objects;
+        objects.reserve(count);
+        size_t before = allocated.load();
+        for (size_t i = 0; i < count; i++) objects.push_back(make(i));
+        size_t bytes = allocated.load() - before;
+        return static_cast<double>(bytes) / static_cast<double>(count);
+    }
+}
+
+void* operator new(std::size_t size) {
+    allocated.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    if (count == 0) count = 1;
+    User owner(1000, "developer");
+    owner.addToGroup(100);
+    owner.addToGroup(101);
+
+    double legacy = measure<LegacyHeader>(count, [&](size_t i) {
+        return std::make_unique<LegacyHeader>("f" + std::to_string(i % 100000), 0, owner, static_cast<unsigned int>(i));
+    });
+    double compact = measure<FileSystemObject>(count, [&](size_t i) {
+        return std::make_unique<FileSystemObject>("f" + std::to_string(i % 100000), 0, owner, static_cast<unsigned int>(i), ObjectType::File);
+    });
+
+    std::cout << "objects: " << count << "\n"
+              << std::left << std::setw(10) << "layout" << std::right
+              << std::setw(10) << "sizeof" << std::setw(16) << "bytes/object" << "\n"
+              << std::left << std::setw(10) << "before" << std::right
+              << std::setw(10) << sizeof(LegacyHeader) << std::setw(16) << std::fixed << std::setprecision(1) << legacy << "\n"
+              << std::left << std::setw(10) << "after" << std::right
+              << std::setw(10) << sizeof(FileSystemObject) << std::setw(16) << compact << "\n";
+    return 0;
+}
\ No newline at end of file
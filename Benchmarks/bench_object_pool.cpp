@@ -0,0 +1,90 @@
+#include "Repository/FSRep/realisation/fs_repository.h"
+#include "Entity/User/user.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Создание и очистка объектов репозитория: отдельные new против пулов.
+ *
+ * В обоих случаях объекты сохраняются в FileSystemRepository по адресам; отличается
+ * только источник памяти объекта: std::make_unique (прежний путь FileSystemService)
+ * или allocateFile/allocateDirectory (слабы пулов). Каждая десятая запись - директория.
+ *
+ * Запуск: bench_object_pool [количество объектов], по умолчанию 1 000 000.
+ */
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Результат одного прогона.
+     */
+    struct Timing {
+        double create;  ///< Наносекунды на создание и сохранение объекта
+        double clear;   ///< Наносекунды на объект при clear()
+        double remove;  ///< Наносекунды на удаление объекта по адресу
+    };
+
+    /**
+     * @brief Заполнить репозиторий, удалить половину объектов и очистить его.
+     * @param count Количество объектов
+     * @param pooled Создавать объекты в пулах репозитория
+     * @return Время на объект
+     */
+    Timing run(size_t count, bool pooled) {
+        FileSystemRepository repo;
+        User owner(1000, "developer");
+        Timing timing{};
+        for (int round = 0; round < 2; round++) {
+            auto start = Clock::now();
+            for (size_t i = 0; i < count; i++) {
+                std::string name = "f" + std::to_string(i % 1000);
+                unsigned int address = repo.getAddress();
+                bool directory = i % 10 == 0;
+                ObjectPtr object;
+                if (pooled) {
+                    object = directory ? repo.allocateDirectory(name, 0, owner, address) : repo.allocateFile(name, 0, owner, address);
+                } else if (directory) {
+                    object = std::make_unique<DirectoryDescriptor>(name, 0, owner, address, repo.getMemoryResource());
+                } else {
+                    object = std::make_unique<FileDescriptor>(name, 0, owner, address, repo.getMemoryResource());
+                }
+                repo.saveObject(std::move(object));
+            }
+            auto created = Clock::now();
+            for (size_t i = 1; i <= count; i += 2) repo.deleteObject(static_cast<unsigned int>(i));
+            auto removed = Clock::now();
+            repo.clear();
+            auto cleared = Clock::now();
+            // Первый раунд прогревает аллокатор, учитывается второй.
+            timing.create = std::chrono::duration<double, std::nano>(created - start).count() / static_cast<double>(count);
+            timing.remove = std::chrono::duration<double, std::nano>(removed - created).count() / static_cast<double>(count / 2);
+            timing.clear = std::chrono::duration<double, std::nano>(cleared - removed).count() / static_cast<double>(count - count / 2);
+        }
+        return timing;
+    }
+
+    /**
+     * @brief Вывести строку таблицы.
+     * @param label Название варианта
+     * @param timing Результат
+     */
+    void print(const char* label, const Timing& timing) {
+        std::cout << std::left << std::setw(10) << label << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(14) << timing.create << std::setw(14) << timing.remove << std::setw(14) << timing.clear << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    if (count < 2) count = 2;
+    std::cout << "objects: " << count << " (ns/object)\n"
+              << std::left << std::setw(10) << "alloc" << std::right
+              << std::setw(14) << "create+save" << std::setw(14) << "delete" << std::setw(14) << "clear" << "\n";
+    print("new", run(count, false));
+    print("pool", run(count, true));
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "Repository/FSRep/realisation/fs_repository.h"
+#include "Entity/User/user.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Разрешение путей: обход от корня против кэша путей FileSystemRepository.
+ *
+ * Строится цепочка директорий глубины 16 с files файлами на каждом уровне. Для уровней
+ * 1, 4 и 16 разрешаются пути всех файлов уровня. "walk" - прежний обход по сегментам:
+ * пути записаны с "//" в начале, такая запись не кэшируется. "cached" - те же пути в
+ * нормализованном виде после первого прохода, все обращения попадают в кэш.
+ *
+ * Запуск: bench_path_cache [файлов на уровне], по умолчанию 256.
+ */
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    volatile size_t sink = 0;  ///< Не даёт компилятору выбросить результаты
+
+    /**
+     * @brief Разрешить все пути и измерить время.
+     * @param repo Репозиторий
+     * @param paths Пути
+     * @param rounds Количество повторов
+     * @return Наносекунды на путь
+     */
+    double measure(const FileSystemRepository& repo, const std::vector<std::string>& paths, int rounds) {
+        auto start = Clock::now();
+        for (int i = 0; i < rounds; i++) {
+            for (const auto& path : paths) sink = sink + (repo.getObjectByPath(path) != nullptr);
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(paths.size() * rounds);
+    }
+}
+
+int main(int argc, char** argv) {
+    int files = argc > 1 ? std::atoi(argv[1]) : 256;
+    if (files < 1) files = 1;
+    FileSystemRepository repo;
+    User owner(1, "admin");
+    IDirectory* directory = repo.getRootDirectory();
+    std::string path;
+    std::vector<std::string> levelPaths;
+    for (int level = 1; level <= 16; level++) {
+        unsigned int parentAddress = directory->asObject()->getAddress();
+        ObjectPtr dir = repo.allocateDirectory("level" + std::to_string(level), parentAddress, owner, repo.getAddress());
+        IDirectory* child = dir->asDirectory();
+        directory->addChild(dir.get());
+        repo.saveObject(std::move(dir));
+        directory = child;
+        path += "/level" + std::to_string(level);
+        for (int i = 0; i < files; i++) {
+            ObjectPtr file = repo.allocateFile("f" + std::to_string(i), directory->asObject()->getAddress(), owner, repo.getAddress());
+            directory->addChild(file.get());
+            repo.saveObject(std::move(file));
+        }
+        levelPaths.push_back(path);
+    }
+
+    std::cout << "files per level: " << files << " (ns/lookup)\n"
+              << std::left << std::setw(8) << "depth" << std::right
+              << std::setw(12) << "walk" << std::setw(12) << "cached" << std::setw(10) << "speedup" << "\n";
+    for (int depth : {1, 4, 16}) {
+        std::vector<std::string> canonical, uncached;
+        for (int i = 0; i < files; i++) {
+            canonical.push_back(levelPaths[depth - 1] + "/f" + std::to_string(i));
+            uncached.push_back("/" + canonical.back());
+        }
+        double walk = measure(repo, uncached, 200);
+        measure(repo, canonical, 1);
+        double cached = measure(repo, canonical, 200);
+        std::cout << std::left << std::setw(8) << depth + 1 << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << walk << std::setw(12) << cached << std::setw(10) << walk / cached << "\n";
+    }
+    auto stats = repo.getPathCacheStats();
+    std::cout << "cache: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.size << " entries\n";
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "Table/table.h"
+#include "Table/split_table.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Сравнение раскладок Table (пары подряд) и SplitTable (ключи и значения в разных массивах).
+ *
+ * Для каждого размера измеряются поиск по ключу и полный просмотр ключей с фильтром
+ * по подстроке - типичная нагрузка поиска объектов по шаблону.
+ */
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    volatile size_t sink = 0;  ///< Не даёт компилятору выбросить результаты
+
+    /**
+     * @brief Значение размером с небольшой дескриптор, чтобы разница раскладок была заметна.
+     */
+    struct Payload {
+        uint64_t fields[6] = {};  ///< Данные значения
+    };
+
+    /**
+     * @brief Сгенерировать имя файла.
+     * @param gen Генератор случайных чисел
+     * @return Имя
+     */
+    std::string randomName(std::mt19937_64& gen) {
+        static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789_";
+        std::uniform_int_distribution<size_t> length(4, 20);
+        std::uniform_int_distribution<size_t> symbol(0, sizeof(alphabet) - 2);
+        std::string name(length(gen), 'a');
+        for (auto& c : name) c = alphabet[symbol(gen)];
+        return name;
+    }
+
+    /**
+     * @brief Измерить среднее время одного поиска.
+     * @param table Таблица
+     * @param queries Ключи для поиска
+     * @return Наносекунды на поиск
+     */
+    template<typename TableType>
+    double measureLookup(const TableType& table, const std::vector<std::string>& queries) {
+        size_t found = 0;
+        auto start = Clock::now();
+        for (int round = 0; round < 4; round++) {
+            for (const auto& key : queries) found += table.contains(key);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        sink = found;
+        return elapsed / static_cast<double>(queries.size() * 4);
+    }
+
+    /**
+     * @brief Измерить среднее время просмотра одного ключа при фильтрации по подстроке.
+     * @param scan Функция, возвращающая количество подходящих ключей
+     * @param size Количество ключей
+     * @return Наносекунды на ключ
+     */
+    template<typename Scan>
+    double measureScan(Scan scan, size_t size) {
+        size_t rounds = std::max<size_t>(1, 4000000 / size);
+        size_t matched = 0;
+        auto start = Clock::now();
+        for (size_t r = 0; r < rounds; r++) matched += scan();
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        sink = matched;
+        return elapsed / static_cast<double>(size * rounds);
+    }
+
+    /**
+     * @brief Запустить сравнение для одного размера.
+     * @param size Количество ключей
+     */
+    void run(size_t size) {
+        std::mt19937_64 gen(size);
+        std::vector<std::string> names;
+        for (size_t i = 0; i < size; i++) names.push_back(randomName(gen));
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+
+        Table<std::string, Payload> pairs;
+        SplitTable<std::string, Payload> split;
+        std::vector<TablePair<std::string, Payload>> items;
+        for (const auto& name : names) items.emplace_back(name, Payload{});
+        pairs.insert_bulk(items.begin(), items.end());
+        split.insert_bulk(items.begin(), items.end());
+
+        std::vector<std::string> queries;
+        std::uniform_int_distribution<size_t> pick(0, names.size() - 1);
+        for (size_t i = 0; i < (1u << 15); i++) queries.push_back(i % 2 ? names[pick(gen)] : randomName(gen) + ".");
+
+        double pairsLookup = measureLookup(pairs, queries);
+        double splitLookup = measureLookup(split, queries);
+        double pairsScan = measureScan([&] {
+            size_t n = 0;
+            for (const auto& pair : pairs) n += pair.key.find("ab") != std::string::npos;
+            return n;
+        }, names.size());
+        double splitScan = measureScan([&] {
+            size_t n = 0;
+            for (const auto& key : split.keys()) n += key.find("ab") != std::string::npos;
+            return n;
+        }, names.size());
+
+        std::cout << std::right << std::setw(10) << names.size()
+                  << std::setw(14) << std::fixed << std::setprecision(1) << pairsLookup
+                  << std::setw(14) << splitLookup
+                  << std::setw(14) << std::setprecision(2) << pairsScan
+                  << std::setw(14) << splitScan << "\n";
+    }
+}
+
+int main() {
+    std::cout << std::right << std::setw(10) << "size"
+              << std::setw(14) << "pairs find"
+              << std::setw(14) << "split find"
+              << std::setw(14) << "pairs scan"
+              << std::setw(14) << "split scan" << "\n";
+    for (size_t size : {1000u, 10000u, 100000u, 1000000u}) run(size);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "Table/table.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Сравнение поэлементного и побайтового переноса элементов Table.
+ *
+ * Значение - владеющая ссылка на объект с пользовательским перемещающим конструктором.
+ * Две версии отличаются только признаком TriviallyRelocatable, поэтому разница во времени
+ * вставки в середину таблицы и роста массива - это цена поэлементного сдвига.
+ */
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    volatile size_t sink = 0;  ///< Не даёт компилятору выбросить результаты
+
+    /**
+     * @brief Ссылка на объект, обнуляющая источник при перемещении.
+     * @tparam Relocatable Включён ли признак тривиальной перемещаемости
+     */
+    template<bool Relocatable>
+    struct ObjectRef {
+        uint64_t* object = nullptr;  ///< Объект
+
+        ObjectRef() = default;
+        explicit ObjectRef(uint64_t* o) noexcept : object(o) {}
+        ObjectRef(ObjectRef&& other) noexcept : object(other.object) { other.object = nullptr; }
+        ObjectRef& operator=(ObjectRef&& other) noexcept { std::swap(object, other.object); return *this; }
+        ~ObjectRef() { object = nullptr; }
+    };
+}
+
+template<>
+struct TriviallyRelocatable<ObjectRef<true>> : std::true_type {};
+
+namespace {
+    /**
+     * @brief Измерить вставки в середину заполненной таблицы.
+     * @param size Начальный размер таблицы
+     * @param inserts Количество вставок
+     * @return Наносекунды на вставку
+     */
+    template<bool Relocatable>
+    double measureMiddleInsert(size_t size, size_t inserts) {
+        static uint64_t object = 0;
+        Table<uint64_t, ObjectRef<Relocatable>> table;
+        table.reserve(size + inserts);
+        for (size_t i = 0; i < size; i++) table.insert({i * 2, ObjectRef<Relocatable>(&object)});
+
+        std::mt19937_64 gen(size);
+        std::uniform_int_distribution<size_t> pick(size / 4, size * 3 / 4);
+        std::vector<uint64_t> keys;
+        for (size_t i = 0; i < inserts; i++) keys.push_back(pick(gen) * 2 + 1);
+
+        auto start = Clock::now();
+        for (uint64_t key : keys) table.insert({key, ObjectRef<Relocatable>(&object)});
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        sink = table.size();
+        return elapsed / static_cast<double>(inserts);
+    }
+
+    /**
+     * @brief Измерить заполнение таблицы возрастающими ключами (время уходит на рост массива).
+     * @param size Количество элементов
+     * @return Наносекунды на элемент
+     */
+    template<bool Relocatable>
+    double measureGrowth(size_t size) {
+        static uint64_t object = 0;
+        auto start = Clock::now();
+        Table<uint64_t, ObjectRef<Relocatable>> table;
+        for (size_t i = 0; i < size; i++) table.insert({i, ObjectRef<Relocatable>(&object)});
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        sink = table.size();
+        return elapsed / static_cast<double>(size);
+    }
+
+    /**
+     * @brief Запустить сравнение для одного размера.
+     * @param size Количество элементов
+     */
+    void run(size_t size) {
+        size_t inserts = std::max<size_t>(64, 20000000 / size);
+        double moveInsert = measureMiddleInsert<false>(size, inserts);
+        double relocateInsert = measureMiddleInsert<true>(size, inserts);
+        double moveGrowth = measureGrowth<false>(size);
+        double relocateGrowth = measureGrowth<true>(size);
+
+        std::cout << std::right << std::setw(10) << size
+                  << std::setw(14) << std::fixed << std::setprecision(0) << moveInsert
+                  << std::setw(14) << relocateInsert
+                  << std::setw(10) << std::setprecision(2) << moveInsert / relocateInsert
+                  << std::setw(14) << moveGrowth
+                  << std::setw(14) << relocateGrowth << "\n";
+    }
+}
+
+int main() {
+    std::cout << std::right << std::setw(10) << "size"
+              << std::setw(14) << "move insert"
+              << std::setw(14) << "memmove ins"
+              << std::setw(10) << "speedup"
+              << std::setw(14) << "move grow"
+              << std::setw(14) << "memmove grow" << "\n";
+    for (size_t size : {10000u, 100000u, 1000000u}) run(size);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "Table/table.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Сравнение бинарного поиска и поиска по индексу Эйтцингера в Table.
+ *
+ * Для каждого размера таблица заполняется случайными ключами, затем выполняется
+ * одинаковая последовательность поисков (половина - существующие ключи) в обоих режимах.
+ */
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    volatile size_t sink = 0;  ///< Не даёт компилятору выбросить результаты поисков
+
+    /**
+     * @brief Сгенерировать имя файла, похожее на реальные имена в директориях.
+     * @param gen Генератор случайных чисел
+     * @return Имя
+     */
+    std::string randomName(std::mt19937_64& gen) {
+        static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789_";
+        std::uniform_int_distribution<size_t> length(4, 20);
+        std::uniform_int_distribution<size_t> symbol(0, sizeof(alphabet) - 2);
+        std::string name(length(gen), 'a');
+        for (auto& c : name) c = alphabet[symbol(gen)];
+        return name;
+    }
+
+    /**
+     * @brief Измерить среднее время одного поиска.
+     * @param table Таблица
+     * @param queries Ключи для поиска
+     * @param rounds Количество проходов по queries
+     * @return Наносекунды на поиск
+     */
+    template<typename Key>
+    double measure(const Table<Key, int>& table, const std::vector<Key>& queries, size_t rounds) {
+        size_t found = 0;
+        for (const auto& key : queries) found += table.contains(key);
+        auto start = Clock::now();
+        for (size_t r = 0; r < rounds; r++) {
+            for (const auto& key : queries) found += table.count(key);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        sink = found;
+        return elapsed / static_cast<double>(queries.size() * rounds);
+    }
+
+    /**
+     * @brief Запустить сравнение для одного размера таблицы.
+     * @param label Название набора ключей
+     * @param keys Ключи таблицы
+     * @param misses Ключи, которых нет в таблице
+     */
+    template<typename Key>
+    void run(const std::string& label, const std::vector<Key>& keys, const std::vector<Key>& misses) {
+        std::vector<Key> sorted(keys);
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        Table<Key, int> table;
+        table.reserve(sorted.size());
+        for (size_t i = 0; i < sorted.size(); i++) table.insert_or_assign(sorted[i], static_cast<int>(i));
+
+        std::mt19937_64 gen(7);
+        std::vector<Key> queries;
+        size_t queryCount = 1 << 16;
+        queries.reserve(queryCount);
+        std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+        std::uniform_int_distribution<size_t> pickMiss(0, misses.size() - 1);
+        for (size_t i = 0; i < queryCount; i++) {
+            queries.push_back(i % 2 ? keys[pick(gen)] : misses[pickMiss(gen)]);
+        }
+
+        size_t rounds = keys.size() >= 1000000 ? 2 : 8;
+        table.set_search_mode(TableSearchMode::Bisection);
+        double bisection = measure(table, queries, rounds);
+        table.set_search_mode(TableSearchMode::Eytzinger);
+        double eytzinger = measure(table, queries, rounds);
+
+        std::cout << std::left << std::setw(10) << label
+                  << std::right << std::setw(10) << table.size()
+                  << std::setw(14) << std::fixed << std::setprecision(1) << bisection
+                  << std::setw(14) << eytzinger
+                  << std::setw(10) << std::setprecision(2) << bisection / eytzinger << "x\n";
+    }
+}
+
+int main() {
+    std::cout << std::left << std::setw(10) << "keys"
+              << std::right << std::setw(10) << "size"
+              << std::setw(14) << "bisect ns"
+              << std::setw(14) << "eytz ns"
+              << std::setw(11) << "speedup" << "\n";
+
+    for (size_t size : {1000u, 10000u, 100000u, 1000000u}) {
+        std::mt19937_64 gen(size);
+        std::vector<uint64_t> keys, misses;
+        for (size_t i = 0; i < size; i++) {
+            keys.push_back(gen() & ~uint64_t(1));
+            misses.push_back(gen() | 1);
+        }
+        run("uint64", keys, misses);
+    }
+
+    for (size_t size : {1000u, 10000u, 100000u, 1000000u}) {
+        std::mt19937_64 gen(size);
+        std::vector<std::string> keys, misses;
+        for (size_t i = 0; i < size; i++) {
+            keys.push_back(randomName(gen));
+            misses.push_back(randomName(gen) + ".");
+        }
+        run("string", keys, misses);
+    }
+    return 0;
+}
\ No newline at end of file
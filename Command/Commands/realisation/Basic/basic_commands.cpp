@@ -2,6 +2,7 @@
 #include "Service/FSService/realisation/fs_service.h"
 #include "Service/SecurityService/realisation/security_service.h"
 #include "FileSystem/interface/i_file_system.h"
+#include <algorithm>
 #include <random>
 #include <chrono>
 
@@ -85,7 +86,7 @@ bool ReadFileCommand::validateArgs(const std::vector<std::string>& args) const {
 
 CommandResult ReadFileCommand::execute(const std::vector<std::string>& args, IFileSystem& fs) {
     auto result = fs.readFile(args[0]);
-    return CommandResult{result.success, result.messages, result.error};
+    return CommandResult{result.success, result.messages, result.error, std::move(result.content)};
 }
 
 // ========================================
@@ -129,10 +130,17 @@ CommandResult MoveCommand::execute(const std::vector<std::string>& args, IFileSy
 
 // ========================================
 ChangePermissionsCommand::ChangePermissionsCommand()
-    : BaseCommand("chmod", "Change file permissions", "chmod <path> <permissions> [-a for all]") {}
+    : BaseCommand("chmod", "Change file permissions", "chmod <path> <permissions> [-a for all] [-r recursive | -i inheritable]") {}
 
 bool ChangePermissionsCommand::validateArgs(const std::vector<std::string>& args) const {
-    return args.size() == 2 || args.size() == 3;
+    if (args.size() < 2 || args.size() > 4) return false;
+    bool scoped = false;
+    for (size_t i = 2; i < args.size(); ++i) {
+        if (args[i] == "-a") continue;
+        if ((args[i] != "-r" && args[i] != "-i") || scoped) return false;
+        scoped = true;
+    }
+    return true;
 }
 
 static std::map<PermissionType, PermissionEffect> parsePermissions(const std::string& permStr) {
@@ -164,7 +172,11 @@ static std::map<PermissionType, PermissionEffect> parsePermissions(const std::st
 CommandResult ChangePermissionsCommand::execute(const std::vector<std::string>& args, IFileSystem& fs) {
     auto permissions = parsePermissions(args[1]);
     if (permissions.empty()) return CommandResult{false, {}, "Invalid permissions format. Use format like 'r+w-xm+d-c'"};
-    auto result = fs.changePermissions(args[0], permissions, args[2] == "-a");
+    bool forAll = std::find(args.begin() + 2, args.end(), "-a") != args.end();
+    PermissionScope scope = PermissionScope::Object;
+    if (std::find(args.begin() + 2, args.end(), "-r") != args.end()) scope = PermissionScope::Subtree;
+    else if (std::find(args.begin() + 2, args.end(), "-i") != args.end()) scope = PermissionScope::Inheritable;
+    auto result = fs.changePermissions(args[0], permissions, forAll, scope);
     return CommandResult{result.success, result.messages, result.error};
 }
 
@@ -358,15 +370,7 @@ CommandResult EditFileCommand::execute(const std::vector<std::string>& args, IFi
             content += args[i];
         }
     }
-    if (append) {
-        auto readResult = fs.readFile(path);
-        if (!readResult.success) return CommandResult{false, {}, "Cannot read file: " + readResult.error};
-        std::string existingContent;
-        if (!readResult.messages.empty()) existingContent = readResult.messages[0];
-        auto writeResult = fs.writeFile(path, existingContent + content);
-        return CommandResult{writeResult.success, writeResult.messages, writeResult.error};
-    }
-    auto writeResult = fs.writeFile(path, content);
+    auto writeResult = fs.writeFile(path, content, append);
     return CommandResult{writeResult.success, writeResult.messages, writeResult.error};
 }
 
@@ -87,6 +87,12 @@ private:
      */
     virtual void cmdComposite(const std::vector<std::string>& args) = 0;
 
+    /**
+     * @brief Команда управления сжатием содержимого файлов
+     * @param args Аргументы команды
+     */
+    virtual void cmdCompress(const std::vector<std::string>& args) = 0;
+
     /**
      * @brief Выполнить команду файловой системы
      * @param command Имя команды
@@ -2,6 +2,7 @@
 #include "Entity/User/user.h"
 #include "../../Command/CommandService/realisation/command_service.h"
 #include <sstream>
+#include <iomanip>
 #include <algorithm>
 #include <cctype>
 
@@ -17,7 +18,7 @@ static inline void rtrim(std::string &s) {
     }).base(), s.end());
 }
 
-Controller::Controller(std::unique_ptr<ILoader> loader) : isRun(true), view(loader->getView()), commandService(loader->getCommandService()), fileSystem(std::make_unique<FileSystem>(std::move(loader))) {
+Controller::Controller(std::unique_ptr<ILoader> loader) : isRun(true), view(loader->getView()), commandService(loader->getCommandService()), compressionService(loader->getCompressionService()), fileSystem(std::make_unique<FileSystem>(std::move(loader))) {
     initializeControllerCommands();
 }
 
@@ -67,6 +68,7 @@ void Controller::initializeControllerCommands() {
     controllerCommands["pwd"] = [this](const std::vector<std::string>& args) { cmdPwd(args); };
     controllerCommands["man"] = [this](const std::vector<std::string>& args) { cmdMan(args); };
     controllerCommands["composite"] = [this](const std::vector<std::string>& args) { cmdComposite(args); };
+    controllerCommands["compress"] = [this](const std::vector<std::string>& args) { cmdCompress(args); };
 }
 
 void Controller::cmdHelp(const std::vector<std::string>& args) {
@@ -84,7 +86,7 @@ void Controller::cmdHelp(const std::vector<std::string>& args) {
     helpLines.push_back("  rmdir <path> [rec]                          - Delete file");
     helpLines.push_back("  cp <src> <dest>                             - Copy file");
     helpLines.push_back("  mv <src> <dest>                             - Move file");
-    helpLines.push_back("  chmod <path> <perms>                        - Change permissions");
+    helpLines.push_back("  chmod <path> <perms> [-a] [-r|-i]           - Change permissions (-r subtree, -i inheritable)");
     helpLines.push_back("  chown <path> <owner>                        - Change owner");
     helpLines.push_back("  find <pattern>                              - Find files");
     helpLines.push_back("  mkrand <N>                                   - Create N random files and directories");
@@ -92,6 +94,7 @@ void Controller::cmdHelp(const std::vector<std::string>& args) {
     helpLines.push_back("  save <filename>                             - Save entire filesystem state");
     helpLines.push_back("  load <filename>                             - Load filesystem state from file");
     helpLines.push_back("  composite create/add/remove/show/delete     - Read file");
+    helpLines.push_back("  compress [on [idle_sec] | off | now]        - Compress idle file contents in memory");
 
     helpLines.push_back("");
     helpLines.push_back("=== User Management Commands (Admin only) ===");
@@ -169,6 +172,7 @@ void Controller::executeFSCommand(const std::string& command, const std::vector<
         for (const auto& msg : result.message) {
             view.displayMessage(msg);
         }
+        if (result.content) view.displayContent(*result.content);
     } else view.displayError(result.error);
 }
 
@@ -195,6 +199,7 @@ void Controller::run() {
         std::vector<std::string> args;
         parseCommand(input, command, args);
         if (command.empty()) continue;
+        auto guard = compressionService.hold();
         try {
             auto it = controllerCommands.find(command);
             if (it != controllerCommands.end()) it->second(args);
@@ -281,4 +286,44 @@ void Controller::cmdComposite(const std::vector<std::string>& args) {
     } catch (const std::exception& e) {
         view.displayError(std::string("Error: ") + e.what());
     }
+}
+
+void Controller::cmdCompress(const std::vector<std::string>& args) {
+    const std::string action = args.empty() ? "status" : args[0];
+    if (action == "on" && args.size() <= 2) {
+        if (args.size() == 2) {
+            try {
+                int idle = std::stoi(args[1]);
+                if (idle < 0) throw std::invalid_argument(args[1]);
+                compressionService.setIdleInterval(std::chrono::seconds(idle));
+            } catch (...) {
+                view.displayError("Invalid idle interval: " + args[1]);
+                return;
+            }
+        }
+        compressionService.start();
+        view.displayMessage("Background compression enabled (idle " + std::to_string(compressionService.getIdleInterval().count()) + "s)");
+    }
+    else if (action == "off" && args.size() == 1) {
+        compressionService.stop();
+        view.displayMessage("Background compression disabled");
+    }
+    else if (action == "now" && args.size() == 1) {
+        size_t compressed = compressionService.compressIdle(std::chrono::system_clock::now(), std::chrono::seconds(0));
+        view.displayMessage("Compressed files: " + std::to_string(compressed));
+    }
+    else if (action != "status" || args.size() > 1) {
+        view.displayError("Usage: compress [on [idle_sec] | off | now]");
+        return;
+    }
+
+    MemoryReport report = compressionService.getMemoryReport();
+    std::ostringstream ratio;
+    ratio << std::fixed << std::setprecision(2) << (report.storedBytes ? static_cast<double>(report.contentBytes) / report.storedBytes : 1.0);
+    view.displayMessage("=== Memory Report ===");
+    view.displayMessage("Background compression: " + std::string(compressionService.isRunning() ? "on" : "off") +
+                        " (idle " + std::to_string(compressionService.getIdleInterval().count()) + "s)");
+    view.displayMessage("Files: " + std::to_string(report.files) + " (compressed: " + std::to_string(report.compressedFiles) + ")");
+    view.displayMessage("Content size: " + std::to_string(report.contentBytes) + " bytes");
+    view.displayMessage("Resident size: " + std::to_string(report.storedBytes) + " bytes (" + ratio.str() + "x)");
 }
\ No newline at end of file
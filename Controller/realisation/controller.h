@@ -22,6 +22,7 @@ private:
     bool isRun;                                                 ///< Флаг активности контроллера
     IView& view;                                                ///< Ссылка на представление
     ICommandService& commandService;                            ///< Ссылка на сервис команд
+    ICompressionService& compressionService;                    ///< Ссылка на сервис сжатия содержимого
     std::unique_ptr<IFileSystem> fileSystem;                    ///< Уникальный указатель на файловую систему
     std::map<std::string, std::function<void(const std::vector<std::string>&)>> controllerCommands; ///< Карта команд контроллера
 
@@ -100,6 +101,12 @@ private:
      */
     void cmdComposite(const std::vector<std::string>& args) override;
 
+    /**
+     * @brief Команда управления сжатием содержимого файлов
+     * @param args Аргументы команды (on [секунды], off, now или пусто для отчёта)
+     */
+    void cmdCompress(const std::vector<std::string>& args) override;
+
     /**
      * @brief Выполнить команду файловой системы
      * @param command Имя команды
@@ -1,91 +1,282 @@
 #include "acl_class.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
+/**
+ * @brief Пул содержимого ACL.
+ *
+ * Пул держит только std::weak_ptr и невладеющий указатель; содержимое снимается
+ * с учёта из своего деструктора, поэтому в таблице нет мёртвых записей. Пул не
+ * уничтожается при завершении программы, чтобы статические ACL можно было
+ * освобождать в любом порядке.
+ */
+class ACL::Pool {
+private:
+    /**
+     * @brief Запись пула.
+     */
+    struct Slot {
+        std::weak_ptr<const Body> owner;    ///< Слабая ссылка для выдачи новых владельцев
+        const Body* body;                   ///< Содержимое (живо, пока запись в таблице)
+    };
+
+    std::mutex mutex;                                   ///< Защищает таблицу
+    std::unordered_multimap<uint64_t, Slot> bodies;     ///< Содержимое по хешу
+
+public:
+    /**
+     * @brief Получить пул процесса.
+     * @return Пул
+     */
+    static Pool& instance() {
+        static Pool* pool = new Pool();
+        return *pool;
+    }
+
+    /**
+     * @brief Найти равное содержимое или зарегистрировать новое.
+     * @param ownerId Идентификатор владельца
+     * @param entries Отсортированные записи
+     * @param hash Хеш владельца и записей
+     * @return Общее содержимое
+     */
+    std::shared_ptr<const Body> intern(unsigned int ownerId, std::vector<Entry>&& entries, uint64_t hash) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto [first, last] = bodies.equal_range(hash);
+        for (auto it = first; it != last; ++it) {
+            // Пока запись в таблице, содержимое живо (его деструктор ждёт mutex).
+            const Body* candidate = it->second.body;
+            if (candidate->ownerId != ownerId || candidate->entries != entries) continue;
+            if (std::shared_ptr<const Body> owner = it->second.owner.lock()) return owner;
+        }
+        entries.shrink_to_fit();
+        auto body = std::make_shared<const Body>(ownerId, std::move(entries), hash);
+        bodies.emplace(hash, Slot{body, body.get()});
+        return body;
+    }
+
+    /**
+     * @brief Снять содержимое с учёта.
+     * @param hash Хеш содержимого
+     * @param body Уничтожаемое содержимое
+     */
+    void release(uint64_t hash, const Body* body) noexcept {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto [first, last] = bodies.equal_range(hash);
+        for (auto it = first; it != last; ++it) {
+            if (it->second.body != body) continue;
+            bodies.erase(it);
+            return;
+        }
+    }
+
+    /**
+     * @brief Получить количество зарегистрированного содержимого.
+     * @return Количество различных списков
+     */
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return bodies.size();
+    }
+};
+
+namespace {
+    /**
+     * @brief Сравнить запись с ключом (идентификатор, тип субъекта)
+     */
+    template<typename Entry>
+    bool entryLess(const Entry& entry, const ACLKey& key) {
+        return std::make_pair(entry.subjectId, entry.subjectType) < key;
+    }
+
+    /**
+     * @brief Перемешать значение в хеш
+     * @param hash Текущий хеш
+     * @param value Значение
+     * @return Новый хеш
+     */
+    uint64_t mixHash(uint64_t hash, uint64_t value) {
+        hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+        return hash * 0xFF51AFD7ED558CCDULL;
+    }
+}
+
+ACL::Body::~Body() {
+    Pool::instance().release(hash, this);
+}
+
+std::shared_ptr<const ACL::Body> ACL::intern(unsigned int ownerId, std::vector<Entry>&& entries) {
+    uint64_t hash = mixHash(0, ownerId);
+    for (const Entry& entry : entries) {
+        hash = mixHash(hash, (static_cast<uint64_t>(entry.subjectId) << 32) |
+                             (static_cast<uint64_t>(entry.subjectType) << 16) |
+                             (static_cast<uint64_t>(entry.allow) << 8) | entry.deny);
+    }
+    return Pool::instance().intern(ownerId, std::move(entries), hash);
+}
+
+size_t ACL::distinctCount() {
+    return Pool::instance().size();
+}
+
+ACL::ACL(unsigned int oId) : body(intern(oId, {})) {}
+
+size_t ACL::lowerBound(const std::vector<Entry>& entries, unsigned int id, SubjectType s_type) {
+    return std::lower_bound(entries.begin(), entries.end(), ACLKey(id, s_type), entryLess<Entry>) - entries.begin();
+}
+
+const ACL::Entry* ACL::findEntry(unsigned int id, SubjectType s_type) const {
+    const std::vector<Entry>& entries = body->entries;
+    size_t pos = lowerBound(entries, id, s_type);
+    if (pos == entries.size() || entries[pos].subjectId != id || entries[pos].subjectType != s_type) return nullptr;
+    return &entries[pos];
+}
+
+void ACL::setOwnerId(unsigned int id) {
+    if (id == body->ownerId) return;
+    body = intern(id, std::vector<Entry>(body->entries));
+}
+
+void ACL::updateEntry(unsigned int id, SubjectType s_type, PermissionMask clear, PermissionMask allow, PermissionMask deny) {
+    const std::vector<Entry>& current = body->entries;
+    size_t pos = lowerBound(current, id, s_type);
+    bool found = pos < current.size() && current[pos].subjectId == id && current[pos].subjectType == s_type;
+    Entry updated = found ? current[pos] : Entry{id, s_type, 0, 0};
+    updated.allow = static_cast<PermissionMask>((updated.allow & ~clear) | allow);
+    updated.deny = static_cast<PermissionMask>((updated.deny & ~clear) | deny);
+    bool empty = (updated.allow | updated.deny) == 0;
+    if (found ? updated == current[pos] : empty) return;
+
+    std::vector<Entry> entries(current);
+    if (!found) entries.insert(entries.begin() + pos, updated);
+    else if (empty) entries.erase(entries.begin() + pos);
+    else entries[pos] = updated;
+    body = intern(body->ownerId, std::move(entries));
+}
 
 void ACL::setPermission(unsigned int id, SubjectType s_type, PermissionType p_type, PermissionEffect effect) {
-    ACLKey key = std::make_pair(id, s_type);
-    if (entries.find(key) == entries.end()) {
-        ACLEntry acl;
-        acl.subjectId = id;
-        acl.subjectType = s_type;
-        acl.setPermission(p_type, effect);
-        entries[key] = acl;
-    } else entries[key].setPermission(p_type, effect);
+    PermissionMask bit = permissionBit(p_type);
+    bool deny = effect == PermissionEffect::Deny;
+    // Новая запись с одним разрешением всегда непуста, поэтому setPermission не удаляет записи.
+    updateEntry(id, s_type, bit, deny ? 0 : bit, deny ? bit : 0);
 }
 
 void ACL::setPermissions(unsigned int id, SubjectType s_type, const std::vector<PermissionType> &p_types, PermissionEffect effect) {
-    for (PermissionType p_type: p_types) setPermission(id, s_type, p_type, effect);
+    PermissionMask bits = 0;
+    for (PermissionType p_type: p_types) bits |= permissionBit(p_type);
+    if (bits == 0) return;
+    bool deny = effect == PermissionEffect::Deny;
+    updateEntry(id, s_type, bits, deny ? 0 : bits, deny ? bits : 0);
 }
 
 void ACL::removePermission(unsigned int id, SubjectType s_type, PermissionType p_type) {
-    ACLKey key = std::make_pair(id, s_type);
-    auto it = entries.find(key);
-    if (it != entries.end()) {
-        it->second.removePermission(p_type);
-        if (it->second.permissions.empty()) entries.erase(it);
-    }
+    if (!findEntry(id, s_type)) return;
+    updateEntry(id, s_type, permissionBit(p_type), 0, 0);
 }
 
-bool ACL::hasExplicitDeny(unsigned int userId, const std::vector<unsigned int> &userGroups, PermissionType p_type) const {
-    ACLKey userKey = std::make_pair(userId, SubjectType::User);
-    auto userIt = entries.find(userKey);
-    if (userIt != entries.end() && userIt->second.hasPermission(p_type) && userIt->second.getPermissionEffect(p_type) == PermissionEffect::Deny) {
-        return true;
+void ACL::collectMasks(unsigned int userId, const std::vector<unsigned int> &userGroups, PermissionMask& allow, PermissionMask& deny) const {
+    if (body->entries.empty()) return;
+    if (const Entry* user = findEntry(userId, SubjectType::User)) {
+        allow |= user->allow;
+        deny |= user->deny;
     }
     for (unsigned int groupId: userGroups) {
-        ACLKey groupKey = std::make_pair(groupId, SubjectType::Group);
-        auto groupIt = entries.find(groupKey);
-        if (groupIt != entries.end() && groupIt->second.hasPermission(p_type) && groupIt->second.
-            getPermissionEffect(p_type) == PermissionEffect::Deny) {
-            return true;
+        if (const Entry* group = findEntry(groupId, SubjectType::Group)) {
+            allow |= group->allow;
+            deny |= group->deny;
         }
     }
-    return false;
 }
 
-bool ACL::checkPermission(unsigned int userId, const std::vector<unsigned int> &userGroups, PermissionType p_type) const {
-    if (userId == ownerId) return !hasExplicitDeny(userId, userGroups, p_type);
-    bool hasAllow = false, hasDeny = false;
-    ACLKey userKey = std::make_pair(userId, SubjectType::User);
-    auto userIt = entries.find(userKey);
-    if (userIt != entries.end() && userIt->second.hasPermission(p_type)) {
-        if (userIt->second.getPermissionEffect(p_type) == PermissionEffect::Deny) hasDeny = true;
-        else hasAllow = true;
-    }
-    for (unsigned int groupId: userGroups) {
-        ACLKey groupKey = std::make_pair(groupId, SubjectType::Group);
-        auto groupIt = entries.find(groupKey);
-        if (groupIt != entries.end() && groupIt->second.hasPermission(p_type)) {
-            if (groupIt->second.getPermissionEffect(p_type) == PermissionEffect::Deny) hasDeny = true;
-            else hasAllow = true;
+PermissionMask ACL::getPermissionMask(unsigned int userId, const std::vector<unsigned int> &userGroups) const {
+    PermissionMask allow = 0, deny = 0;
+    collectMasks(userId, userGroups, allow, deny);
+    PermissionMask owner = static_cast<PermissionMask>(-static_cast<int>(userId == body->ownerId)) & ALL_PERMISSIONS;
+    return static_cast<PermissionMask>((allow | owner) & ~deny);
+}
+
+PermissionMask ACL::getPermissionMask(unsigned int userId, const std::vector<unsigned int> &userGroups, const ACL& inherited) const {
+    PermissionMask allow = 0, deny = 0;
+    collectMasks(userId, userGroups, allow, deny);
+    inherited.collectMasks(userId, userGroups, allow, deny);
+    PermissionMask owner = static_cast<PermissionMask>(-static_cast<int>(userId == body->ownerId)) & ALL_PERMISSIONS;
+    return static_cast<PermissionMask>((allow | owner) & ~deny);
+}
+
+ACL ACL::mergedWith(const ACL& other) const {
+    if (other.empty()) return *this;
+    const std::vector<Entry>& left = body->entries;
+    const std::vector<Entry>& right = other.body->entries;
+    std::vector<Entry> merged;
+    merged.reserve(left.size() + right.size());
+    size_t i = 0, j = 0;
+    while (i < left.size() || j < right.size()) {
+        if (j == right.size() || (i < left.size() && entryLess(left[i], ACLKey(right[j].subjectId, right[j].subjectType)))) {
+            merged.push_back(left[i++]);
+        } else if (i == left.size() || entryLess(right[j], ACLKey(left[i].subjectId, left[i].subjectType))) {
+            merged.push_back(right[j++]);
+        } else {
+            Entry entry = left[i++];
+            entry.allow |= right[j].allow;
+            entry.deny |= right[j++].deny;
+            merged.push_back(entry);
         }
     }
-    if (hasDeny) return false;
-    return hasAllow;
+    ACL result = *this;
+    result.body = intern(body->ownerId, std::move(merged));
+    return result;
+}
+
+bool ACL::checkPermission(unsigned int userId, const std::vector<unsigned int> &userGroups, PermissionType p_type) const {
+    return (getPermissionMask(userId, userGroups) & permissionBit(p_type)) != 0;
 }
 
 std::map<PermissionType, bool> ACL::getEffectivePermissions(unsigned int userId, const std::vector<unsigned int> &userGroups) const {
     std::map<PermissionType, bool> result;
+    PermissionMask mask = getPermissionMask(userId, userGroups);
     int minPerm = static_cast<int>(PermissionType::Read);
     int maxPerm = static_cast<int>(PermissionType::ChangePermissions);
     for (int i = minPerm; i <= maxPerm; i++) {
         PermissionType perm = static_cast<PermissionType>(i);
-        result[perm] = checkPermission(userId, userGroups, perm);
+        result[perm] = (mask & permissionBit(perm)) != 0;
     }
     return result;
 }
 
 std::vector<ACLEntry> ACL::getEntries() const {
     std::vector<ACLEntry> result;
-    for (const auto& [key, entry] : entries) {
-        result.push_back(entry);
+    result.reserve(body->entries.size());
+    for (const Entry& entry : body->entries) {
+        ACLEntry& out = result.emplace_back();
+        out.subjectId = entry.subjectId;
+        out.subjectType = entry.subjectType;
+        for (int i = static_cast<int>(PermissionType::Read); i <= static_cast<int>(PermissionType::ChangePermissions); i++) {
+            PermissionType perm = static_cast<PermissionType>(i);
+            if (entry.allow & permissionBit(perm)) out.permissions[perm] = PermissionEffect::Allow;
+            else if (entry.deny & permissionBit(perm)) out.permissions[perm] = PermissionEffect::Deny;
+        }
     }
     return result;
 }
 
 void ACL::setEntries(const std::vector<ACLEntry>& newEntries) {
-    entries.clear();
+    std::vector<Entry> entries;
+    entries.reserve(newEntries.size());
     for (const auto& entry : newEntries) {
-        ACLKey key(entry.subjectId, entry.subjectType);
-        entries[key] = entry;
+        Entry packed{entry.subjectId, entry.subjectType, 0, 0};
+        for (const auto& [perm, effect] : entry.permissions) {
+            if (effect == PermissionEffect::Deny) packed.deny |= permissionBit(perm);
+            else packed.allow |= permissionBit(perm);
+        }
+        entries.push_back(packed);
     }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return entryLess(a, ACLKey(b.subjectId, b.subjectType));
+    });
+    auto last = std::unique(entries.rbegin(), entries.rend(), [](const Entry& a, const Entry& b) {
+        return a.subjectId == b.subjectId && a.subjectType == b.subjectType;
+    });
+    entries.erase(entries.begin(), last.base());
+    body = intern(body->ownerId, std::move(entries));
 }
@@ -2,15 +2,32 @@
 #define LAB3_ACL_H
 
 #include "../../base.h"
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <vector>
 #include <utility>
 
+using PermissionMask = uint8_t;  ///< Набор разрешений: бит i соответствует PermissionType с номером i
+
+/// Маска всех разрешений (6 типов PermissionType)
+inline constexpr PermissionMask ALL_PERMISSIONS = 0x3F;
+
+/**
+ * @brief Получить бит разрешения в маске
+ * @param p_type Тип разрешения
+ * @return Маска с единственным битом
+ */
+constexpr PermissionMask permissionBit(PermissionType p_type) {
+    return static_cast<PermissionMask>(1u << static_cast<unsigned int>(p_type));
+}
+
 /**
  * @brief Запись ACL (Access Control List) для одного субъекта.
  *
  * Хранит идентификатор субъекта, тип субъекта и карту разрешений
- * с соответствующими эффектами (разрешить/запретить).
+ * с соответствующими эффектами (разрешить/запретить). Используется для обмена
+ * записями (getEntries/setEntries, ACLSerializer); сам ACL хранит записи в виде масок.
  */
 struct ACLEntry {
     unsigned int subjectId;         ///< Идентификатор субъекта
@@ -58,38 +75,109 @@ using ACLKey = std::pair<unsigned int, SubjectType>;  ///< Ключ для ка
  *
  * Реализует механизм контроля доступа на основе списков управления доступом
  * с поддержкой наследования прав от групп и явных запретов.
+ *
+ * Записи хранятся плоским вектором, отсортированным по (субъект, тип субъекта), а
+ * разрешения субъекта - парой 6-битных масок разрешения и запрета. Все разрешения
+ * пользователя вычисляются за один проход по его записям побитовыми операциями:
+ * (allow | владелец) & ~deny.
+ *
+ * Содержимое (владелец и записи) неизменяемо и хранится в общем для процесса пуле:
+ * равные списки разных объектов разделяют один экземпляр, а ACL - лишь указатель на
+ * него. Изменяющие методы собирают новое содержимое и регистрируют его в пуле
+ * (копирование при записи), поэтому копирование ACL - это копирование указателя.
  */
 class ACL {
 private:
-    unsigned int ownerId;                           ///< Идентификатор владельца
-    std::map<ACLKey, ACLEntry> entries;            ///< Карта записей ACL
+    /**
+     * @brief Запись субъекта в виде масок.
+     */
+    struct Entry {
+        unsigned int subjectId;     ///< Идентификатор субъекта
+        SubjectType subjectType;    ///< Тип субъекта
+        PermissionMask allow;       ///< Явно разрешённые права
+        PermissionMask deny;        ///< Явно запрещённые права (не пересекается с allow)
+
+        bool operator==(const Entry&) const = default;
+    };
+
+    class Pool;
+
+    /**
+     * @brief Неизменяемое содержимое ACL, общее для всех равных списков.
+     *
+     * Зарегистрировано в пуле, пока живо; деструктор снимает его с учёта.
+     */
+    struct Body {
+        unsigned int ownerId;           ///< Идентификатор владельца
+        std::vector<Entry> entries;     ///< Записи, отсортированные по (subjectId, subjectType)
+        uint64_t hash;                  ///< Хеш владельца и записей
+
+        ~Body();
+    };
+
+    std::shared_ptr<const Body> body;   ///< Общее неизменяемое содержимое
+
+    /**
+     * @brief Найти равное содержимое в пуле или зарегистрировать новое
+     * @param ownerId Идентификатор владельца
+     * @param entries Отсортированные записи
+     * @return Общее содержимое
+     */
+    static std::shared_ptr<const Body> intern(unsigned int ownerId, std::vector<Entry>&& entries);
+
+    /**
+     * @brief Найти позицию записи субъекта
+     * @param entries Отсортированные записи
+     * @param id Идентификатор субъекта
+     * @param s_type Тип субъекта
+     * @return Позиция первой записи не меньше (id, s_type)
+     */
+    static size_t lowerBound(const std::vector<Entry>& entries, unsigned int id, SubjectType s_type);
+
+    /**
+     * @brief Найти запись субъекта
+     * @param id Идентификатор субъекта
+     * @param s_type Тип субъекта
+     * @return Указатель на запись или nullptr
+     */
+    [[nodiscard]] const Entry* findEntry(unsigned int id, SubjectType s_type) const;
+
+    /**
+     * @brief Изменить маски субъекта с копированием содержимого при записи
+     * @param id Идентификатор субъекта
+     * @param s_type Тип субъекта
+     * @param clear Сбрасываемые биты обеих масок
+     * @param allow Устанавливаемые биты разрешения
+     * @param deny Устанавливаемые биты запрета
+     */
+    void updateEntry(unsigned int id, SubjectType s_type, PermissionMask clear, PermissionMask allow, PermissionMask deny);
 
     /**
-     * @brief Проверить наличие явного запрета для пользователя и его групп
+     * @brief Собрать явные разрешения и запреты пользователя и его групп
      * @param userId Идентификатор пользователя
      * @param userGroups Группы пользователя
-     * @param p_type Тип разрешения
-     * @return true если найден явный запрет, иначе false
+     * @param allow Куда добавить разрешённые права
+     * @param deny Куда добавить запрещённые права
      */
-    [[nodiscard]] bool hasExplicitDeny(unsigned int userId, const std::vector<unsigned int>& userGroups, PermissionType p_type) const;
+    void collectMasks(unsigned int userId, const std::vector<unsigned int>& userGroups, PermissionMask& allow, PermissionMask& deny) const;
 
 public:
     /**
      * @brief Конструктор
      */
-    ACL(unsigned int oId) : ownerId(oId) {}
+    ACL(unsigned int oId);
 
     /**
      * @brief Получить идентификатор владельца
      * @return Идентификатор владельца
      */
-    [[nodiscard]] unsigned int getOwner() const { return ownerId; }
+    [[nodiscard]] unsigned int getOwner() const { return body->ownerId; }
 
     /**
      * @brief Установить идентификатор владельца
      * @param id Новый идентификатор владельца
      */
-    void setOwnerId(unsigned int id) { ownerId = id; }
+    void setOwnerId(unsigned int id);
 
     /**
      * @brief Установить одно разрешение для субъекта
@@ -126,6 +214,27 @@ public:
      */
     [[nodiscard]] bool checkPermission(unsigned int userId, const std::vector<unsigned int>& userGroups, PermissionType p_type) const;
 
+    /**
+     * @brief Вычислить маску всех эффективных разрешений пользователя за один проход
+     * @param userId Идентификатор пользователя
+     * @param userGroups Группы пользователя
+     * @return Маска разрешений (бит permissionBit(p) - наличие разрешения p)
+     */
+    [[nodiscard]] PermissionMask getPermissionMask(unsigned int userId, const std::vector<unsigned int>& userGroups) const;
+
+    /**
+     * @brief Вычислить маску разрешений с учётом унаследованных записей
+     *
+     * Унаследованные записи действуют так же, как собственные: запрет из любого
+     * источника отменяет разрешение, владелец получает все незапрещённые права.
+     *
+     * @param userId Идентификатор пользователя
+     * @param userGroups Группы пользователя
+     * @param inherited Записи, унаследованные от родительских директорий (владелец не учитывается)
+     * @return Маска разрешений
+     */
+    [[nodiscard]] PermissionMask getPermissionMask(unsigned int userId, const std::vector<unsigned int>& userGroups, const ACL& inherited) const;
+
     /**
      * @brief Получить все эффективные разрешения для пользователя
      * @param userId Идентификатор пользователя
@@ -145,6 +254,44 @@ public:
      * @param newEntries Новый набор записей ACL
      */
     void setEntries(const std::vector<ACLEntry>& newEntries);
+
+    /**
+     * @brief Проверить, есть ли в списке записи
+     * @return true если записей нет
+     */
+    [[nodiscard]] bool empty() const noexcept { return body->entries.empty(); }
+
+    /**
+     * @brief Объединить записи с записями другого списка
+     *
+     * Маски разрешений и запретов одного субъекта объединяются. Владелец берётся из этого списка.
+     *
+     * @param other Добавляемый список
+     * @return Объединённый список
+     */
+    [[nodiscard]] ACL mergedWith(const ACL& other) const;
+
+    /**
+     * @brief Получить идентичность общего содержимого
+     *
+     * Равные списки (тот же владелец и те же записи) разделяют содержимое, поэтому
+     * идентичность годится ключом для запоминания результатов над ACL.
+     *
+     * @return Адрес общего содержимого
+     */
+    [[nodiscard]] const void* identity() const noexcept { return body.get(); }
+
+    /**
+     * @brief Получить количество различных живых списков в процессе
+     * @return Количество зарегистрированных содержимых
+     */
+    static size_t distinctCount();
+
+    /**
+     * @brief Сравнить списки
+     * @return true если владелец и записи совпадают
+     */
+    friend bool operator==(const ACL& lhs, const ACL& rhs) noexcept { return lhs.body == rhs.body; }
 };
 
 #endif
\ No newline at end of file
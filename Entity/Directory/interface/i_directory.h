@@ -1,8 +1,13 @@
 #ifndef LAB3_I_DIRECTORY_H
 #define LAB3_I_DIRECTORY_H
 
+#include "Entity/ACL/acl_class.h"
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <span>
 
 class IFileSystemObject;
 
@@ -14,8 +19,33 @@ class IFileSystemObject;
  */
 class IDirectory {
 public:
+    /// Неизменяемый снимок списка дочерних объектов
+    using ChildSnapshot = std::shared_ptr<const std::vector<IFileSystemObject*>>;
+
+    /**
+     * @brief Вычисленные наследуемые записи директории.
+     *
+     * Действительны, пока поколение совпадает с поколением наследования репозитория.
+     */
+    struct InheritedACL {
+        uint64_t generation;    ///< Поколение наследования, в котором записи вычислены
+        ACL acl;                ///< Записи директории и всех её предков
+    };
+
     virtual ~IDirectory() = default;
 
+    /**
+     * @brief Получить директорию как объект файловой системы
+     * @return Объект файловой системы
+     */
+    virtual IFileSystemObject* asObject() noexcept = 0;
+
+    /**
+     * @brief Получить директорию как объект файловой системы
+     * @return Объект файловой системы
+     */
+    virtual const IFileSystemObject* asObject() const noexcept = 0;
+
     /**
      * @brief Добавить дочерний объект
      * @param obj Умный указатель на дочерний объект
@@ -23,6 +53,13 @@ public:
      */
     virtual bool addChild(IFileSystemObject* obj) = 0;
 
+    /**
+     * @brief Добавить несколько дочерних объектов за одну операцию
+     * @param objs Добавляемые объекты (nullptr и объекты с занятыми именами пропускаются)
+     * @return Количество добавленных объектов
+     */
+    virtual int addChildren(std::span<IFileSystemObject* const> objs) = 0;
+
     /**
      * @brief Удалить дочерний объект по имени
      * @param name Имя удаляемого объекта
@@ -32,10 +69,13 @@ public:
 
     /**
      * @brief Получить дочерний объект по имени
+     *
+     * Не синхронизирован с изменением набора детей.
+     *
      * @param name Имя искомого объекта
      * @return Умный указатель на объект или nullptr если не найден
      */
-    virtual IFileSystemObject* getChild(const std::string &name) const = 0;
+    virtual IFileSystemObject* getChild(std::string_view name) const = 0;
 
     /**
      * @brief Получить количество дочерних объектов
@@ -49,12 +89,59 @@ public:
      */
     virtual std::vector<IFileSystemObject*> listChild() const = 0;
 
+    /**
+     * @brief Получить согласованный снимок дочерних объектов
+     *
+     * Снимок не меняется после получения, поэтому его можно обходить
+     * из нескольких потоков. Объекты, на которые он указывает, снимок не
+     * удерживает: пока он используется, дети не должны удаляться.
+     *
+     * @return Снимок дочерних объектов в порядке имён
+     */
+    virtual ChildSnapshot snapshotChildren() const = 0;
+
     /**
      * @brief Проверить наличие дочернего объекта по имени
+     *
+     * Не синхронизирован с изменением набора детей.
+     *
      * @param name Имя искомого объекта
      * @return true если объект существует, иначе false
      */
-    virtual bool containChild(const std::string &name) const = 0;
+    virtual bool containChild(std::string_view name) const = 0;
+
+    /**
+     * @brief Получить наследуемые записи ACL директории
+     *
+     * Записи действуют на все объекты поддерева, но не на саму директорию.
+     *
+     * @return Наследуемые записи (владелец не используется)
+     */
+    virtual const ACL& getInheritableACL() const = 0;
+
+    /**
+     * @brief Заменить наследуемые записи ACL директории
+     *
+     * Вызывающий должен сбросить кэши наследования (IFileSystemRepository::invalidateInheritance).
+     *
+     * @param acl Новые наследуемые записи
+     */
+    virtual void setInheritableACL(const ACL& acl) = 0;
+
+    /**
+     * @brief Получить кэш вычисленных наследуемых записей
+     * @return Кэш или nullptr, если он ещё не вычислялся
+     */
+    virtual std::shared_ptr<const InheritedACL> getInheritanceCache() const = 0;
+
+    /**
+     * @brief Сохранить вычисленные наследуемые записи
+     *
+     * Кэш можно обновлять из нескольких потоков одновременно.
+     *
+     * @param cache Новый кэш
+     */
+    virtual void setInheritanceCache(std::shared_ptr<const InheritedACL> cache) const = 0;
 };
 
 #endif
\ No newline at end of file
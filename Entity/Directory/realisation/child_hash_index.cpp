@@ -0,0 +1,88 @@
+#include "child_hash_index.h"
+#include "Entity/FSObject/interface/i_fs_object.h"
+#include "Entity/FSObject/realisation/name_pool.h"
+#include <algorithm>
+#include <bit>
+
+namespace {
+    constexpr size_t MIN_SLOTS = 16;    ///< Минимальное количество ячеек
+}
+
+uint64_t ChildHashIndex::hashName(std::string_view name) noexcept {
+    return NamePool::hashName(name);
+}
+
+void ChildHashIndex::build(std::span<IFileSystemObject* const> objects) {
+    slots.assign(std::bit_ceil(std::max(MIN_SLOTS, objects.size() * 2)), Slot{});
+    count = 0;
+    for (IFileSystemObject* object : objects) {
+        if (object && place(object->getInternedName().hash(), object)) count++;
+    }
+    active = true;
+}
+
+void ChildHashIndex::reset() noexcept {
+    std::vector<Slot>().swap(slots);
+    count = 0;
+    active = false;
+}
+
+void ChildHashIndex::rehash(size_t capacity) {
+    std::vector<Slot> old(capacity, Slot{});
+    old.swap(slots);
+    for (const Slot& slot : old) {
+        if (slot.object) place(slot.hash, slot.object);
+    }
+}
+
+bool ChildHashIndex::place(uint64_t hash, IFileSystemObject* object) {
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        Slot& slot = slots[i];
+        if (!slot.object) {
+            slot.hash = hash;
+            slot.object = object;
+            return true;
+        }
+        if (slot.hash == hash && slot.object->getInternedName() == object->getInternedName()) return false;
+    }
+}
+
+size_t ChildHashIndex::locate(std::string_view name, uint64_t hash) const noexcept {
+    if (slots.empty()) return 0;
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots[i];
+        if (!slot.object) return slots.size();
+        if (slot.hash == hash && slot.object->getName() == name) return i;
+    }
+}
+
+bool ChildHashIndex::insert(IFileSystemObject* object) {
+    if (!object) return false;
+    if ((count + 1) * 2 > slots.size()) rehash(std::max(MIN_SLOTS, slots.size() * 2));
+    if (!place(object->getInternedName().hash(), object)) return false;
+    count++;
+    return true;
+}
+
+bool ChildHashIndex::erase(std::string_view name) noexcept {
+    size_t i = locate(name, hashName(name));
+    if (i >= slots.size()) return false;
+    size_t mask = slots.size() - 1;
+    for (size_t j = (i + 1) & mask; slots[j].object; j = (j + 1) & mask) {
+        size_t home = slots[j].hash & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    slots[i] = Slot{};
+    count--;
+    return true;
+}
+
+IFileSystemObject* ChildHashIndex::find(std::string_view name) const noexcept {
+    size_t i = locate(name, hashName(name));
+    return i < slots.size() ? slots[i].object : nullptr;
+}
\ No newline at end of file
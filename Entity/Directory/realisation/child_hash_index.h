@@ -0,0 +1,112 @@
+#ifndef LAB3_CHILD_HASH_INDEX_H
+#define LAB3_CHILD_HASH_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+class IFileSystemObject;
+
+/**
+ * @brief Хеш-индекс дочерних объектов директории по имени.
+ *
+ * Открытая адресация с линейным пробированием. В ячейке хранится заранее
+ * вычисленный хеш имени и указатель на объект, поэтому при пробировании
+ * сравниваются 8-байтовые хеши, а строки - только при совпадении хеша.
+ * Хеш берётся из записи пула имён, а имена добавляемых объектов сравниваются
+ * как интернированные ссылки.
+ * Удаление выполняется обратным сдвигом, без надгробий. Заполненность
+ * не превышает половины таблицы.
+ */
+class ChildHashIndex {
+private:
+    /**
+     * @brief Ячейка индекса.
+     */
+    struct Slot {
+        uint64_t hash = 0;                      ///< Хеш имени объекта
+        IFileSystemObject* object = nullptr;    ///< Объект (nullptr - ячейка свободна)
+    };
+
+    std::vector<Slot> slots;    ///< Ячейки, размер - степень двойки
+    size_t count = 0;           ///< Количество занятых ячеек
+    bool active = false;        ///< Построен ли индекс
+
+    /**
+     * @brief Перераспределить ячейки.
+     * @param capacity Новое количество ячеек (степень двойки)
+     */
+    void rehash(size_t capacity);
+
+    /**
+     * @brief Вставить объект без проверки заполненности.
+     * @param hash Хеш имени объекта
+     * @param object Объект
+     * @return true если объект вставлен, false если имя уже занято
+     */
+    bool place(uint64_t hash, IFileSystemObject* object);
+
+    /**
+     * @brief Найти ячейку с объектом по имени.
+     * @param name Имя
+     * @param hash Хеш имени
+     * @return Номер ячейки или slots.size(), если объект не найден
+     */
+    size_t locate(std::string_view name, uint64_t hash) const noexcept;
+
+public:
+    /**
+     * @brief Вычислить хеш имени.
+     * @param name Имя
+     * @return Хеш
+     */
+    static uint64_t hashName(std::string_view name) noexcept;
+
+    /**
+     * @brief Построить индекс заново.
+     * @param objects Дочерние объекты директории
+     */
+    void build(std::span<IFileSystemObject* const> objects);
+
+    /**
+     * @brief Освободить индекс.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Проверить, построен ли индекс.
+     * @return true если индекс построен и поддерживается
+     */
+    bool isActive() const noexcept { return active; }
+
+    /**
+     * @brief Получить количество проиндексированных объектов.
+     * @return Количество объектов
+     */
+    size_t size() const noexcept { return count; }
+
+    /**
+     * @brief Добавить объект в индекс.
+     * @param object Объект
+     * @return true если объект добавлен, false если имя уже занято
+     */
+    bool insert(IFileSystemObject* object);
+
+    /**
+     * @brief Удалить объект из индекса по имени.
+     * @param name Имя объекта
+     * @return true если объект удалён
+     */
+    bool erase(std::string_view name) noexcept;
+
+    /**
+     * @brief Найти объект по имени.
+     * @param name Имя объекта
+     * @return Указатель на объект или nullptr
+     */
+    IFileSystemObject* find(std::string_view name) const noexcept;
+};
+
+#endif
\ No newline at end of file
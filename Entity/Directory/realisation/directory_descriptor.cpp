@@ -5,35 +5,139 @@
 #include <string>
 #include <vector>
 
-DirectoryDescriptor::DirectoryDescriptor(const std::string &name, unsigned int parentAddress, const User &owner, unsigned int adr)
-    : FileSystemObject(name, parentAddress, owner, adr) {}
+DirectoryDescriptor::DirectoryDescriptor(const std::string &name, unsigned int parentAddress, const User &owner, unsigned int adr,
+                                         std::pmr::memory_resource* resource)
+    : FileSystemObject(name, parentAddress, owner, adr, ObjectType::Directory), children(resource), largeChildren(resource), inheritable(0) {
+    children.set_search_mode(TableSearchMode::Eytzinger);
+}
+
+void DirectoryDescriptor::promoteChildren() {
+    for (auto it = children.begin(); it != children.end(); ++it) {
+        largeChildren.insert(ChildEntry(it->key, it->value));
+    }
+    ChildTable released(children.get_resource());
+    released.set_search_mode(children.search_mode());
+    released.swap(children);
+}
+
+void DirectoryDescriptor::demoteChildren() {
+    std::vector<ChildEntry> entries;
+    entries.reserve(largeChildren.size());
+    for (auto it = largeChildren.begin(); it != largeChildren.end(); ++it) {
+        entries.emplace_back(it->key, it->value);
+    }
+    children.insert_bulk(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+    largeChildren.clear();
+}
 
 bool DirectoryDescriptor::addChild(IFileSystemObject* obj) {
-    if (!obj || children.contains(obj->getName())) return false;
-    children.insert(TablePair<std::string, IFileSystemObject *>(obj->getName(), obj));
+    if (!obj) return false;
+    ChildEntry entry(obj->getInternedName(), obj);
+    auto lock = childrenSnapshot.write_lock();
+    if (isLarge()) {
+        if (!largeChildren.insert(std::move(entry)).second) return false;
+    } else {
+        if (!children.insert(std::move(entry)).second) return false;
+        if (children.size() > LARGE_DIRECTORY_THRESHOLD) promoteChildren();
+    }
+    if (nameIndex.isActive()) {
+        try {
+            nameIndex.insert(obj);
+        } catch (...) {
+            nameIndex.reset();
+        }
+    } else {
+        refreshNameIndex();
+    }
+    childrenSnapshot.invalidate();
     updateModificationTime();
     return true;
 }
 
+int DirectoryDescriptor::addChildren(std::span<IFileSystemObject* const> objs) {
+    size_t added = 0;
+    auto lock = childrenSnapshot.write_lock();
+    if (isLarge()) {
+        for (IFileSystemObject* obj : objs) {
+            if (obj && largeChildren.insert(ChildEntry(obj->getInternedName(), obj)).second) added++;
+        }
+    } else {
+        std::vector<ChildEntry> entries;
+        entries.reserve(objs.size());
+        for (IFileSystemObject* obj : objs) {
+            if (obj) entries.emplace_back(obj->getInternedName(), obj);
+        }
+        added = children.insert_bulk(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+        if (children.size() > LARGE_DIRECTORY_THRESHOLD) promoteChildren();
+    }
+    if (added == 0) return 0;
+    refreshNameIndex();
+    childrenSnapshot.invalidate();
+    updateModificationTime();
+    return static_cast<int>(added);
+}
+
 bool DirectoryDescriptor::removeChild(const std::string &name) {
     if (name.empty()) return false;
-    if (!children.erase(name)) return false;
+    auto lock = childrenSnapshot.write_lock();
+    if (isLarge()) {
+        auto it = largeChildren.find(std::string_view(name));
+        if (it == largeChildren.end()) return false;
+        largeChildren.erase(it);
+        if (largeChildren.size() < LARGE_DIRECTORY_THRESHOLD / 2) demoteChildren();
+    } else if (!children.erase(name)) return false;
+    if (nameIndex.isActive()) nameIndex.erase(name);
+    trimNameIndex();
+    childrenSnapshot.invalidate();
     updateModificationTime();
     return true;
 }
 
-IFileSystemObject* DirectoryDescriptor::getChild(const std::string &name) const {
+void DirectoryDescriptor::trimNameIndex() noexcept {
+    if (nameIndex.isActive() && static_cast<size_t>(getChildCount()) < HASH_INDEX_THRESHOLD / 2) nameIndex.reset();
+}
+
+void DirectoryDescriptor::refreshNameIndex() noexcept {
+    if (!nameIndex.isActive() && static_cast<size_t>(getChildCount()) < HASH_INDEX_THRESHOLD) return;
+    try {
+        nameIndex.build(collectChildren());
+    } catch (...) {
+        nameIndex.reset();
+    }
+}
+
+IFileSystemObject* DirectoryDescriptor::getChild(std::string_view name) const {
+    if (nameIndex.isActive()) return nameIndex.find(name);
+    if (isLarge()) {
+        auto it = largeChildren.find(name);
+        return it != largeChildren.end() ? it->value : nullptr;
+    }
     auto it = children.find(name);
     if (it != children.end()) return it->value;
     return nullptr;
 }
 
 int DirectoryDescriptor::getChildCount() const {
-    return static_cast<int>(children.size());
+    return static_cast<int>(isLarge() ? largeChildren.size() : children.size());
 }
 
 std::vector<IFileSystemObject*> DirectoryDescriptor::listChild() const {
+    return *snapshotChildren();
+}
+
+IDirectory::ChildSnapshot DirectoryDescriptor::snapshotChildren() const {
+    return childrenSnapshot.get([this] { return collectChildren(); });
+}
+
+std::vector<IFileSystemObject*> DirectoryDescriptor::collectChildren() const {
     std::vector<IFileSystemObject*> result;
+    if (isLarge()) {
+        result.reserve(largeChildren.size());
+        for (auto it = largeChildren.begin(); it != largeChildren.end(); ++it) {
+            result.push_back(it->value);
+        }
+        return result;
+    }
     result.reserve(children.size());
     for (auto it = children.begin(); it != children.end(); ++it) {
         result.push_back(it->value);
@@ -41,7 +145,21 @@ std::vector<IFileSystemObject*> DirectoryDescriptor::listChild() const {
     return result;
 }
 
-bool DirectoryDescriptor::containChild(const std::string &name) const {
+bool DirectoryDescriptor::containChild(std::string_view name) const {
     if (name.empty()) return false;
-    return children.contains(name);
+    if (nameIndex.isActive()) return nameIndex.find(name) != nullptr;
+    return isLarge() ? largeChildren.contains(name) : children.contains(name);
+}
+
+void DirectoryDescriptor::setInheritableACL(const ACL& acl) {
+    inheritable = acl;
+    inheritanceCache.store(nullptr, std::memory_order_release);
+}
+
+std::shared_ptr<const IDirectory::InheritedACL> DirectoryDescriptor::getInheritanceCache() const {
+    return inheritanceCache.load(std::memory_order_acquire);
+}
+
+void DirectoryDescriptor::setInheritanceCache(std::shared_ptr<const InheritedACL> cache) const {
+    inheritanceCache.store(std::move(cache), std::memory_order_release);
 }
\ No newline at end of file
@@ -4,7 +4,12 @@
 #include "Entity/FSObject/realisation/fs_object.h"
 #include "Entity/Directory/interface/i_directory.h"
 #include "Table/table.h"
+#include "Table/btree_table.h"
+#include "Table/snapshot_cell.h"
+#include "child_hash_index.h"
 #include "Entity/User/user.h"
+#include <atomic>
+#include <memory_resource>
 #include <vector>
 
 /**
@@ -12,20 +17,88 @@
  *
  * Реализует интерфейсы файловой системы и директории,
  * предоставляет методы для управления дочерними объектами.
+ *
+ * Изменения набора детей сериализуются, а listChild() и snapshotChildren() читают
+ * опубликованный неизменяемый снимок (см. SnapshotCell), поэтому несколько потоков сканера
+ * могут обходить одну директорию одновременно с изменением набора детей. Пока снимок
+ * актуален, читатель не ждёт писателей; первый читатель после изменения собирает новый
+ * снимок под мьютексом писателей. Снимок продлевает жизнь только списку указателей, но не
+ * самим объектам: удаление ребёнка освобождает его слот в репозитории, поэтому объекты из
+ * снимка нельзя разыменовывать после их удаления.
+ *
+ * Поиск по имени (getChild, containChild) обращается к таблицам без синхронизации и не
+ * должен выполняться одновременно с изменением этой директории.
+ *
+ * Ключи таблиц - интернированные имена детей (InternedName): ключ ссылается на ту же
+ * запись пула имён, что и сам объект, и не копирует строку.
  */
 class DirectoryDescriptor : public FileSystemObject, public IDirectory {
 private:
-    Table<std::string, IFileSystemObject*> children;  ///< Таблица дочерних объектов
+    /// Количество дочерних объектов, хранимых внутри дескриптора без выделения памяти в куче
+    static constexpr size_t INLINE_CHILDREN = 8;
+
+    using ChildTable = Table<InternedName, IFileSystemObject*, std::less<>, INLINE_CHILDREN>;
+    using ChildEntry = TablePair<InternedName, IFileSystemObject*>;
+
+    ChildTable children;                                        ///< Таблица дочерних объектов (поиск в режиме Eytzinger)
+    BTreeTable<InternedName, IFileSystemObject*> largeChildren; ///< B+дерево дочерних объектов больших директорий
+    SnapshotCell<std::vector<IFileSystemObject*>> childrenSnapshot;  ///< Снимок детей для параллельных читателей
+    ChildHashIndex nameIndex;                                   ///< Хеш-индекс имён очень больших директорий
+    ACL inheritable;                                            ///< Наследуемые записи ACL
+    mutable std::atomic<std::shared_ptr<const InheritedACL>> inheritanceCache;  ///< Кэш записей директории и предков
+
+    /**
+     * @brief Собрать список детей из текущей таблицы
+     * @return Дочерние объекты в порядке имён
+     */
+    std::vector<IFileSystemObject*> collectChildren() const;
+
+    /**
+     * @brief Перенести дочерние объекты из таблицы в B+дерево
+     */
+    void promoteChildren();
+
+    /**
+     * @brief Перенести дочерние объекты из B+дерева обратно в таблицу
+     */
+    void demoteChildren();
+
+    /**
+     * @brief Проверить, хранятся ли дочерние объекты в B+дереве
+     * @return true если директория большая
+     */
+    bool isLarge() const { return !largeChildren.empty(); }
+
+    /**
+     * @brief Освободить хеш-индекс, если директория стала вдвое меньше порога HASH_INDEX_THRESHOLD
+     */
+    void trimNameIndex() noexcept;
+
+    /**
+     * @brief Перестроить хеш-индекс, если он уже построен или директория достигла порога HASH_INDEX_THRESHOLD
+     *
+     * Вызывается из изменяющих методов, поэтому getChild() и containChild() только читают индекс.
+     * Если памяти не хватило, индекс освобождается и поиск идёт по таблицам.
+     */
+    void refreshNameIndex() noexcept;
 
 public:
+    /// Количество дочерних объектов, после которого таблица заменяется B+деревом
+    static constexpr size_t LARGE_DIRECTORY_THRESHOLD = 4096;
+
+    /// Количество дочерних объектов, начиная с которого поиск по имени идёт через хеш-индекс
+    static constexpr size_t HASH_INDEX_THRESHOLD = 16384;
+
     /**
      * @brief Конструктор директории
      * @param name Имя директории
      * @param parentAddress Адрес родительской директории
      * @param owner Владелец директории
      * @param adr Адрес директории в файловой системе
+     * @param resource Ресурс памяти для таблиц дочерних объектов
      */
-    DirectoryDescriptor(const std::string &name, unsigned int parentAddress, const User &owner, unsigned int adr);
+    DirectoryDescriptor(const std::string &name, unsigned int parentAddress, const User &owner, unsigned int adr,
+                        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Добавить дочерний объект
@@ -34,6 +107,13 @@ public:
      */
     bool addChild(IFileSystemObject* obj) override;
 
+    /**
+     * @brief Добавить несколько дочерних объектов за одну операцию
+     * @param objs Добавляемые объекты (nullptr и объекты с занятыми именами пропускаются)
+     * @return Количество добавленных объектов
+     */
+    int addChildren(std::span<IFileSystemObject* const> objs) override;
+
     /**
      * @brief Удалить дочерний объект по имени
      * @param name Имя удаляемого объекта
@@ -46,7 +126,7 @@ public:
      * @param name Имя искомого объекта
      * @return Умный указатель на объект или nullptr если не найден
      */
-    IFileSystemObject* getChild(const std::string &name) const override;
+    IFileSystemObject* getChild(std::string_view name) const override;
 
     /**
      * @brief Получить количество дочерних объектов
@@ -60,12 +140,69 @@ public:
      */
     std::vector<IFileSystemObject*> listChild() const override;
 
+    /**
+     * @brief Получить согласованный снимок дочерних объектов
+     *
+     * Устаревший снимок пересобирается под мьютексом писателей.
+     *
+     * @return Снимок дочерних объектов в порядке имён
+     */
+    ChildSnapshot snapshotChildren() const override;
+
     /**
      * @brief Проверить наличие дочернего объекта по имени
      * @param name Имя искомого объекта
      * @return true если объект существует, иначе false
      */
-    bool containChild(const std::string &name) const override;
+    bool containChild(std::string_view name) const override;
+
+    /**
+     * @brief Получить объект как директорию
+     * @return Эта директория
+     */
+    IDirectory* asDirectory() noexcept override { return this; }
+
+    /**
+     * @brief Получить объект как директорию
+     * @return Эта директория
+     */
+    const IDirectory* asDirectory() const noexcept override { return this; }
+
+    /**
+     * @brief Получить директорию как объект файловой системы
+     * @return Эта директория
+     */
+    IFileSystemObject* asObject() noexcept override { return this; }
+
+    /**
+     * @brief Получить директорию как объект файловой системы
+     * @return Эта директория
+     */
+    const IFileSystemObject* asObject() const noexcept override { return this; }
+
+    /**
+     * @brief Получить наследуемые записи ACL директории
+     * @return Наследуемые записи
+     */
+    const ACL& getInheritableACL() const override { return inheritable; }
+
+    /**
+     * @brief Заменить наследуемые записи ACL директории
+     * @param acl Новые наследуемые записи
+     */
+    void setInheritableACL(const ACL& acl) override;
+
+    /**
+     * @brief Получить кэш вычисленных наследуемых записей
+     * @return Кэш или nullptr
+     */
+    std::shared_ptr<const InheritedACL> getInheritanceCache() const override;
+
+    /**
+     * @brief Сохранить вычисленные наследуемые записи
+     * @param cache Новый кэш
+     */
+    void setInheritanceCache(std::shared_ptr<const InheritedACL> cache) const override;
 };
 
 #endif
\ No newline at end of file
@@ -8,6 +8,10 @@
 #include <chrono>
 #include <vector>
 
+class InternedName;
+class IDirectory;
+class IFile;
+class ILockable;
 
 /**
  * @brief Интерфейс объекта файловой системы.
@@ -15,6 +19,10 @@
  * Определяет общий интерфейс для всех объектов файловой системы
  * (файлов и директорий), включая управление метаданными,
  * правами доступа и временными метками.
+ *
+ * Вид объекта задаётся тегом getType(), а переход к интерфейсам директории, файла
+ * и блокировки - методами asDirectory()/asFile()/asLockable(). Это один виртуальный
+ * вызов без обхода RTTI, которым обходятся горячие пути вместо dynamic_cast.
  */
 class IFileSystemObject {
 public:
@@ -58,7 +66,7 @@ public:
 
     /**
      * @brief Изменить владельца объекта
-     * @param newOwner Новый владелец
+     * @param newOwner Новый владелец (сохраняется только его идентификатор)
      */
     virtual void setOwner(const User& newOwner) = 0;
 
@@ -84,7 +92,16 @@ public:
      * @brief Получить имя объекта
      * @return Имя объекта
      */
-    virtual std::string getName() const = 0;
+    virtual const std::string& getName() const = 0;
+
+    /**
+     * @brief Получить имя объекта в виде ссылки на запись пула имён
+     *
+     * Ссылки на одно и то же имя равны как указатели, а хеш имени вычислен заранее.
+     *
+     * @return Интернированное имя объекта
+     */
+    virtual const InternedName& getInternedName() const = 0;
 
     /**
      * @brief Получить адрес объекта
@@ -93,10 +110,55 @@ public:
     virtual unsigned int getAddress() const = 0;
 
     /**
-     * @brief Получить владельца объекта
-     * @return Константная ссылка на владельца
+     * @brief Получить идентификатор владельца объекта
+     *
+     * Сам пользователь разрешается через IUserRepository::getUserById.
+     *
+     * @return Идентификатор владельца
+     */
+    virtual unsigned int getOwnerId() const = 0;
+
+    /**
+     * @brief Получить тип объекта
+     * @return Тип объекта (файл или директория)
+     */
+    virtual ObjectType getType() const = 0;
+
+    /**
+     * @brief Получить объект как директорию
+     * @return Директория или nullptr, если объект не директория
+     */
+    virtual IDirectory* asDirectory() noexcept = 0;
+
+    /**
+     * @brief Получить объект как директорию
+     * @return Директория или nullptr, если объект не директория
+     */
+    virtual const IDirectory* asDirectory() const noexcept = 0;
+
+    /**
+     * @brief Получить объект как файл
+     * @return Файл или nullptr, если объект не файл
+     */
+    virtual IFile* asFile() noexcept = 0;
+
+    /**
+     * @brief Получить объект как файл
+     * @return Файл или nullptr, если объект не файл
+     */
+    virtual const IFile* asFile() const noexcept = 0;
+
+    /**
+     * @brief Получить интерфейс блокировки объекта
+     * @return Интерфейс блокировки или nullptr, если объект не блокируется
+     */
+    virtual ILockable* asLockable() noexcept = 0;
+
+    /**
+     * @brief Получить интерфейс блокировки объекта
+     * @return Интерфейс блокировки или nullptr, если объект не блокируется
      */
-    virtual const User& getOwner() const = 0;
+    virtual const ILockable* asLockable() const noexcept = 0;
 
     /**
      * @brief Получить адрес родительской директории
@@ -116,6 +178,18 @@ public:
      */
     virtual void setACL(const std::vector<ACLEntry>& acl) = 0;
 
+    /**
+     * @brief Получить общий неизменяемый список ACL объекта
+     * @return Список ACL (копирование - копирование указателя)
+     */
+    virtual const ACL& getSharedACL() const = 0;
+
+    /**
+     * @brief Заменить список ACL объекта готовым общим списком
+     * @param acl Новый список ACL
+     */
+    virtual void setSharedACL(const ACL& acl) = 0;
+
     /**
      * @brief Установить время создания объекта
      * @param time Новое время создания
@@ -136,6 +210,23 @@ public:
      * @return true если разрешение есть, иначе false
      */
     virtual bool checkPermission(unsigned int userId, const std::vector<unsigned int>& userGroups, PermissionType perm) const = 0;
+
+    /**
+     * @brief Получить все разрешения пользователя одной маской
+     * @param userId Идентификатор пользователя
+     * @param userGroups Группы пользователя
+     * @return Маска разрешений (бит permissionBit(p) - наличие разрешения p)
+     */
+    virtual PermissionMask getPermissionMask(unsigned int userId, const std::vector<unsigned int>& userGroups) const = 0;
+
+    /**
+     * @brief Получить все разрешения пользователя одной маской с учётом унаследованных записей
+     * @param userId Идентификатор пользователя
+     * @param userGroups Группы пользователя
+     * @param inherited Записи, унаследованные от родительских директорий
+     * @return Маска разрешений
+     */
+    virtual PermissionMask getPermissionMask(unsigned int userId, const std::vector<unsigned int>& userGroups, const ACL& inherited) const = 0;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef LAB3_OBJECT_CAST_H
+#define LAB3_OBJECT_CAST_H
+
+#include "Entity/FSObject/interface/i_fs_object.h"
+#include "Entity/Directory/interface/i_directory.h"
+#include "Entity/File/interface/i_file.h"
+#include "Entity/File/interface/i_lockable.h"
+
+/**
+ * @brief Переходы между интерфейсами объектов файловой системы без RTTI.
+ *
+ * Обёртки над asDirectory()/asFile()/asLockable()/asObject(), допускающие nullptr,
+ * - замена dynamic_cast между IFileSystemObject, IDirectory, IFile и ILockable.
+ */
+
+/**
+ * @brief Получить объект как директорию
+ * @param object Объект (может быть nullptr)
+ * @return Директория или nullptr
+ */
+inline IDirectory* asDirectory(IFileSystemObject* object) noexcept {
+    return object ? object->asDirectory() : nullptr;
+}
+
+/**
+ * @brief Получить объект как директорию
+ * @param object Объект (может быть nullptr)
+ * @return Директория или nullptr
+ */
+inline const IDirectory* asDirectory(const IFileSystemObject* object) noexcept {
+    return object ? object->asDirectory() : nullptr;
+}
+
+/**
+ * @brief Получить объект как файл
+ * @param object Объект (может быть nullptr)
+ * @return Файл или nullptr
+ */
+inline IFile* asFile(IFileSystemObject* object) noexcept {
+    return object ? object->asFile() : nullptr;
+}
+
+/**
+ * @brief Получить объект как файл
+ * @param object Объект (может быть nullptr)
+ * @return Файл или nullptr
+ */
+inline const IFile* asFile(const IFileSystemObject* object) noexcept {
+    return object ? object->asFile() : nullptr;
+}
+
+/**
+ * @brief Получить интерфейс блокировки объекта
+ * @param object Объект (может быть nullptr)
+ * @return Интерфейс блокировки или nullptr
+ */
+inline ILockable* asLockable(IFileSystemObject* object) noexcept {
+    return object ? object->asLockable() : nullptr;
+}
+
+/**
+ * @brief Получить интерфейс блокировки объекта
+ * @param object Объект (может быть nullptr)
+ * @return Интерфейс блокировки или nullptr
+ */
+inline const ILockable* asLockable(const IFileSystemObject* object) noexcept {
+    return object ? object->asLockable() : nullptr;
+}
+
+/**
+ * @brief Получить директорию как объект файловой системы
+ * @param directory Директория (может быть nullptr)
+ * @return Объект или nullptr
+ */
+inline IFileSystemObject* asObject(IDirectory* directory) noexcept {
+    return directory ? directory->asObject() : nullptr;
+}
+
+/**
+ * @brief Получить директорию как объект файловой системы
+ * @param directory Директория (может быть nullptr)
+ * @return Объект или nullptr
+ */
+inline const IFileSystemObject* asObject(const IDirectory* directory) noexcept {
+    return directory ? directory->asObject() : nullptr;
+}
+
+/**
+ * @brief Получить файл как объект файловой системы
+ * @param file Файл (может быть nullptr)
+ * @return Объект или nullptr
+ */
+inline IFileSystemObject* asObject(IFile* file) noexcept {
+    return file ? file->asObject() : nullptr;
+}
+
+/**
+ * @brief Получить файл как объект файловой системы
+ * @param file Файл (может быть nullptr)
+ * @return Объект или nullptr
+ */
+inline const IFileSystemObject* asObject(const IFile* file) noexcept {
+    return file ? file->asObject() : nullptr;
+}
+
+#endif
\ No newline at end of file
@@ -1,4 +1,15 @@
 #include "fs_object.h"
+#include <algorithm>
+#include <limits>
+
+uint32_t FileSystemObject::packTime(std::chrono::system_clock::time_point time) {
+    long long seconds = std::chrono::floor<std::chrono::seconds>(time.time_since_epoch()).count();
+    return static_cast<uint32_t>(std::clamp<long long>(seconds, 0, std::numeric_limits<uint32_t>::max()));
+}
+
+std::chrono::system_clock::time_point FileSystemObject::unpackTime(uint32_t seconds) {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
+}
 
 bool FileSystemObject::isValidName(const std::string& filename) {
     if (filename.empty() || filename.size() > 255) return false;
@@ -8,9 +19,7 @@ bool FileSystemObject::isValidName(const std::string& filename) {
 }
 
 void FileSystemObject::setPermissions(unsigned int id, SubjectType s_type, std::vector<PermissionType> p_types, PermissionEffect effect) {
-    for (auto perm : p_types) {
-        acl.setPermission(id, s_type, perm, effect);
-    }
+    acl.setPermissions(id, s_type, p_types, effect);
 }
 
 void FileSystemObject::setPermission(unsigned int id, SubjectType s_type, PermissionType p_types, PermissionEffect effect) {
@@ -20,7 +29,7 @@ void FileSystemObject::setPermission(unsigned int id, SubjectType s_type, Permis
 
 bool FileSystemObject::setName(const std::string& newName) {
     if (!isValidName(newName)) return false;
-    name = newName;
+    name = InternedName(newName);
     updateModificationTime();
     return true;
 }
@@ -28,7 +37,6 @@ bool FileSystemObject::setName(const std::string& newName) {
 void FileSystemObject::setAddress(unsigned int newAddress) { address = newAddress; }
 
 void FileSystemObject::setOwner(const User& newOwner) {
-    owner = newOwner;
     acl.setOwnerId(newOwner.getId());
     updateModificationTime();
 }
@@ -38,22 +46,28 @@ void FileSystemObject::setParentDirectoryAddress(unsigned int newAddress) {
     updateModificationTime();
 }
 
-std::chrono::system_clock::time_point FileSystemObject::getCreateTime() const { return creationTime; }
+std::chrono::system_clock::time_point FileSystemObject::getCreateTime() const { return unpackTime(creationTime); }
 
-std::chrono::system_clock::time_point FileSystemObject::getLastModifyTime() const { return lastModifyTime; }
+std::chrono::system_clock::time_point FileSystemObject::getLastModifyTime() const { return unpackTime(lastModifyTime); }
 
-std::string FileSystemObject::getName() const { return name; }
+const std::string& FileSystemObject::getName() const { return name.str(); }
 
 unsigned int FileSystemObject::getAddress() const { return address; }
 
-const User& FileSystemObject::getOwner() const { return owner; }
-
 bool FileSystemObject::checkPermission(unsigned int userId, const std::vector<unsigned int>& userGroups, PermissionType perm) const {
     return acl.checkPermission(userId, userGroups, perm);
 }
 
+PermissionMask FileSystemObject::getPermissionMask(unsigned int userId, const std::vector<unsigned int>& userGroups) const {
+    return acl.getPermissionMask(userId, userGroups);
+}
+
+PermissionMask FileSystemObject::getPermissionMask(unsigned int userId, const std::vector<unsigned int>& userGroups, const ACL& inherited) const {
+    return acl.getPermissionMask(userId, userGroups, inherited);
+}
+
 void FileSystemObject::updateModificationTime() {
-    lastModifyTime = std::chrono::system_clock::now();
+    lastModifyTime = packTime(std::chrono::system_clock::now());
 }
 
 std::vector<ACLEntry> FileSystemObject::getACL() const {
@@ -65,9 +79,9 @@ void FileSystemObject::setACL(const std::vector<ACLEntry>& entries) {
 }
 
 void FileSystemObject::setCreateTime(std::chrono::system_clock::time_point time) {
-    creationTime = time;
+    creationTime = packTime(time);
 }
 
 void FileSystemObject::setLastModifyTime(std::chrono::system_clock::time_point time) {
-    lastModifyTime = time;
+    lastModifyTime = packTime(time);
 }
@@ -5,25 +5,49 @@
 #include "../../ACL/acl_class.h"
 #include "../../../base.h"
 #include "../../User/user.h"
+#include "name_pool.h"
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <chrono>
 
 /**
  * @brief Базовый класс объектов файловой системы.
  *
  * Содержит общую функциональность для файлов и директорий:
  * управление метаданными, правами доступа и временными метками.
+ *
+ * Имя хранится в общем пуле имён (NamePool), так что ключ объекта в родительской
+ * директории и одинаковые имена разных объектов не дублируют строку.
+ *
+ * Заголовок объекта компактен: владелец хранится только идентификатором (в ACL) и
+ * разрешается через IUserRepository, метки времени упакованы в 32-битные секунды
+ * Unix-времени (та же точность, с которой они сохраняются в файл состояния), а тип
+ * объекта хранится тегом.
  */
 class FileSystemObject : public IFileSystemObject {
 protected:
-    std::string name;                                   ///< Имя объекта
-    unsigned int address;                               ///< Адрес в файловой системе
-    unsigned int parentAddress;                         ///< Адрес родительской директории
-    User owner;                                         ///< Владелец объекта
-    ACL acl;                                            ///< Список контроля доступа
-    std::chrono::system_clock::time_point creationTime; ///< Время создания
-    std::chrono::system_clock::time_point lastModifyTime; ///< Время последнего изменения
+    InternedName name;              ///< Имя объекта (ссылка на запись пула имён)
+    ACL acl;                        ///< Список контроля доступа (хранит и идентификатор владельца)
+    unsigned int address;           ///< Адрес в файловой системе
+    unsigned int parentAddress;     ///< Адрес родительской директории
+    uint32_t creationTime;          ///< Время создания (секунды Unix-времени)
+    uint32_t lastModifyTime;        ///< Время последнего изменения (секунды Unix-времени)
+    ObjectType type;                ///< Тип объекта
+
+    /**
+     * @brief Упаковать метку времени в секунды Unix-времени
+     * @param time Метка времени
+     * @return Секунды, ограниченные диапазоном uint32_t
+     */
+    static uint32_t packTime(std::chrono::system_clock::time_point time);
+
+    /**
+     * @brief Распаковать метку времени
+     * @param seconds Секунды Unix-времени
+     * @return Метка времени
+     */
+    static std::chrono::system_clock::time_point unpackTime(uint32_t seconds);
 
     /**
      * @brief Проверить валидность имени объекта
@@ -39,10 +63,11 @@ public:
      * @param parAddress Адрес родительской директории
      * @param owner Владелец объекта
      * @param adr Адрес объекта в файловой системе
+     * @param type Тип объекта
      */
-    FileSystemObject(const std::string& n, unsigned int parAddress, const User& owner, unsigned int adr) :
-    name(n), parentAddress(parAddress), owner(owner), address(adr), acl(owner.getId()),
-    creationTime(std::chrono::system_clock::now()), lastModifyTime(std::chrono::system_clock::now()) {}
+    FileSystemObject(const std::string& n, unsigned int parAddress, const User& owner, unsigned int adr, ObjectType type) :
+    name(n), acl(owner.getId()), address(adr), parentAddress(parAddress),
+    creationTime(packTime(std::chrono::system_clock::now())), lastModifyTime(creationTime), type(type) {}
 
     /**
      * @brief Установить несколько разрешений для субъекта
@@ -77,7 +102,7 @@ public:
 
     /**
      * @brief Изменить владельца объекта
-     * @param newOwner Новый владелец
+     * @param newOwner Новый владелец (сохраняется только его идентификатор)
      */
     void setOwner(const User& newOwner) override;
 
@@ -103,7 +128,13 @@ public:
      * @brief Получить имя объекта
      * @return Имя объекта
      */
-    std::string getName() const override;
+    const std::string& getName() const override;
+
+    /**
+     * @brief Получить имя объекта в виде ссылки на запись пула имён
+     * @return Интернированное имя объекта
+     */
+    const InternedName& getInternedName() const override { return name; }
 
     /**
      * @brief Получить адрес объекта
@@ -112,10 +143,52 @@ public:
     unsigned int getAddress() const override;
 
     /**
-     * @brief Получить владельца объекта
-     * @return Константная ссылка на владельца
+     * @brief Получить идентификатор владельца объекта
+     * @return Идентификатор владельца
+     */
+    unsigned int getOwnerId() const override { return acl.getOwner(); }
+
+    /**
+     * @brief Получить тип объекта
+     * @return Тип объекта (файл или директория)
+     */
+    ObjectType getType() const override { return type; }
+
+    /**
+     * @brief Получить объект как директорию
+     * @return nullptr (переопределяется в DirectoryDescriptor)
+     */
+    IDirectory* asDirectory() noexcept override { return nullptr; }
+
+    /**
+     * @brief Получить объект как директорию
+     * @return nullptr (переопределяется в DirectoryDescriptor)
+     */
+    const IDirectory* asDirectory() const noexcept override { return nullptr; }
+
+    /**
+     * @brief Получить объект как файл
+     * @return nullptr (переопределяется в FileDescriptor)
      */
-    const User& getOwner() const override;
+    IFile* asFile() noexcept override { return nullptr; }
+
+    /**
+     * @brief Получить объект как файл
+     * @return nullptr (переопределяется в FileDescriptor)
+     */
+    const IFile* asFile() const noexcept override { return nullptr; }
+
+    /**
+     * @brief Получить интерфейс блокировки объекта
+     * @return nullptr (переопределяется в FileDescriptor)
+     */
+    ILockable* asLockable() noexcept override { return nullptr; }
+
+    /**
+     * @brief Получить интерфейс блокировки объекта
+     * @return nullptr (переопределяется в FileDescriptor)
+     */
+    const ILockable* asLockable() const noexcept override { return nullptr; }
 
     /**
      * @brief Проверить разрешение для пользователя
@@ -126,6 +199,23 @@ public:
      */
     bool checkPermission(unsigned int userId, const std::vector<unsigned int>& userGroups, PermissionType perm) const override;
 
+    /**
+     * @brief Получить все разрешения пользователя одной маской
+     * @param userId Идентификатор пользователя
+     * @param userGroups Группы пользователя
+     * @return Маска разрешений
+     */
+    PermissionMask getPermissionMask(unsigned int userId, const std::vector<unsigned int>& userGroups) const override;
+
+    /**
+     * @brief Получить все разрешения пользователя одной маской с учётом унаследованных записей
+     * @param userId Идентификатор пользователя
+     * @param userGroups Группы пользователя
+     * @param inherited Записи, унаследованные от родительских директорий
+     * @return Маска разрешений
+     */
+    PermissionMask getPermissionMask(unsigned int userId, const std::vector<unsigned int>& userGroups, const ACL& inherited) const override;
+
     /**
      * @brief Получить адрес родительской директории
      * @return Адрес родительской директории
@@ -144,6 +234,18 @@ public:
      */
     void setACL(const std::vector<ACLEntry>& acl) override;
 
+    /**
+     * @brief Получить общий неизменяемый список ACL объекта
+     * @return Список ACL
+     */
+    const ACL& getSharedACL() const override { return acl; }
+
+    /**
+     * @brief Заменить список ACL объекта готовым общим списком
+     * @param list Новый список ACL
+     */
+    void setSharedACL(const ACL& list) override { acl = list; }
+
     /**
      * @brief Установить время создания объекта
      * @param time Новое время создания
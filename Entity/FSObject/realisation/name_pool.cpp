@@ -0,0 +1,56 @@
+#include "name_pool.h"
+#include <functional>
+
+NamePool& NamePool::instance() {
+    static NamePool* pool = new NamePool();
+    return *pool;
+}
+
+uint64_t NamePool::hashName(std::string_view name) noexcept {
+    return std::hash<std::string_view>{}(name);
+}
+
+InternedName NamePool::intern(std::string_view name) {
+    if (name.empty()) return InternedName();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(name);
+    if (it != entries.end()) {
+        it->second->refs.fetch_add(1, std::memory_order_relaxed);
+        return InternedName(it->second);
+    }
+    auto* entry = new Entry();
+    entry->hash = hashName(name);
+    entry->text.assign(name);
+    entry->refs.store(1, std::memory_order_relaxed);
+    try {
+        entries.emplace(entry->text, entry);
+    } catch (...) {
+        delete entry;
+        throw;
+    }
+    return InternedName(entry);
+}
+
+void NamePool::release(Entry* entry) noexcept {
+    uint32_t refs = entry->refs.load(std::memory_order_relaxed);
+    while (refs > 1) {
+        if (entry->refs.compare_exchange_weak(refs, refs - 1, std::memory_order_release, std::memory_order_relaxed)) return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entry->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    entries.erase(entry->text);
+    delete entry;
+}
+
+NamePool::Statistics NamePool::statistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Statistics stats;
+    stats.names = entries.size();
+    for (const auto& [text, entry] : entries) stats.bytes += text.size();
+    return stats;
+}
+
+const std::string& InternedName::emptyString() noexcept {
+    static const std::string empty;
+    return empty;
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+#ifndef LAB3_NAME_POOL_H
+#define LAB3_NAME_POOL_H
+
+#include "Table/relocation.h"
+#include "Table/search_index.h"
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class InternedName;
+
+/**
+ * @brief Общий для процесса пул имён объектов файловой системы.
+ *
+ * Каждое различное имя хранится один раз вместе с заранее вычисленным хешем и счётчиком
+ * ссылок. Объекты и ключи таблиц директорий держат InternedName - указатель на запись
+ * пула, поэтому имя объекта и ключ в родительской директории больше не дублируют строку,
+ * а повторяющиеся имена во всём дереве разделяют одну запись.
+ *
+ * Запись снимается с учёта, когда отпускается последняя ссылка. Переход счётчика 1 -> 0
+ * выполняется под мьютексом пула, поэтому intern() не может выдать запись, которая
+ * в этот момент уничтожается.
+ */
+class NamePool {
+public:
+    /**
+     * @brief Сводка по пулу.
+     */
+    struct Statistics {
+        size_t names = 0;   ///< Количество различных имён
+        size_t bytes = 0;   ///< Суммарная длина имён
+    };
+
+private:
+    friend class InternedName;
+
+    /**
+     * @brief Запись пула.
+     */
+    struct Entry {
+        std::atomic<uint32_t> refs{0};  ///< Количество ссылок InternedName
+        uint64_t hash;                  ///< Хеш имени (NamePool::hashName)
+        std::string text;               ///< Имя
+    };
+
+    mutable std::mutex mutex;                                   ///< Защищает таблицу и последнюю ссылку записей
+    std::unordered_map<std::string_view, Entry*> entries;       ///< Записи по имени (ключ ссылается на Entry::text)
+
+    NamePool() = default;
+
+    /**
+     * @brief Отпустить ссылку на запись и удалить запись, если ссылка была последней.
+     * @param entry Запись
+     */
+    void release(Entry* entry) noexcept;
+
+public:
+    NamePool(const NamePool&) = delete;
+    NamePool& operator=(const NamePool&) = delete;
+
+    /**
+     * @brief Получить пул процесса.
+     *
+     * Пул не уничтожается при завершении программы, чтобы имена статических объектов
+     * можно было отпускать в любом порядке.
+     *
+     * @return Пул
+     */
+    static NamePool& instance();
+
+    /**
+     * @brief Вычислить хеш имени.
+     * @param name Имя
+     * @return Хеш (совпадает с InternedName::hash() для того же имени)
+     */
+    static uint64_t hashName(std::string_view name) noexcept;
+
+    /**
+     * @brief Получить ссылку на имя, зарегистрировав его при необходимости.
+     * @param name Имя
+     * @return Ссылка на запись пула (пустое имя не регистрируется)
+     */
+    InternedName intern(std::string_view name);
+
+    /**
+     * @brief Получить сводку по живым именам.
+     * @return Количество и суммарная длина имён
+     */
+    Statistics statistics() const;
+};
+
+/**
+ * @brief Ссылка на имя из NamePool размером в один указатель.
+ *
+ * Две ссылки на одно и то же имя указывают на одну запись, поэтому равенство ссылок
+ * проверяется сравнением указателей. Упорядочение идёт по тексту имени, так что
+ * InternedName можно использовать ключом Table и BTreeTable и искать по std::string_view.
+ */
+class InternedName {
+private:
+    friend class NamePool;
+
+    NamePool::Entry* entry = nullptr;   ///< Запись пула (nullptr - пустое имя)
+
+    /**
+     * @brief Конструктор ссылки на запись, уже учтённую в её счётчике.
+     * @param entry Запись пула
+     */
+    explicit InternedName(NamePool::Entry* entry) noexcept : entry(entry) {}
+
+    /**
+     * @brief Получить пустую строку для пустой ссылки.
+     * @return Пустая строка
+     */
+    static const std::string& emptyString() noexcept;
+
+public:
+    /**
+     * @brief Конструктор пустого имени.
+     */
+    InternedName() noexcept = default;
+
+    /**
+     * @brief Зарегистрировать имя в пуле процесса.
+     * @param name Имя
+     */
+    explicit InternedName(std::string_view name) : InternedName(NamePool::instance().intern(name)) {}
+
+    InternedName(const InternedName& other) noexcept : entry(other.entry) {
+        if (entry) entry->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    InternedName(InternedName&& other) noexcept : entry(other.entry) { other.entry = nullptr; }
+
+    InternedName& operator=(InternedName other) noexcept {
+        std::swap(entry, other.entry);
+        return *this;
+    }
+
+    ~InternedName() {
+        if (entry) NamePool::instance().release(entry);
+    }
+
+    /**
+     * @brief Получить текст имени.
+     * @return Строка, живущая не меньше этой ссылки
+     */
+    const std::string& str() const noexcept { return entry ? entry->text : emptyString(); }
+
+    /**
+     * @brief Получить текст имени как std::string_view.
+     * @return Представление имени
+     */
+    std::string_view view() const noexcept { return str(); }
+
+    /**
+     * @brief Получить заранее вычисленный хеш имени.
+     * @return NamePool::hashName(str())
+     */
+    uint64_t hash() const noexcept { return entry ? entry->hash : NamePool::hashName({}); }
+
+    /**
+     * @brief Проверить, пусто ли имя.
+     * @return true если имя пустое
+     */
+    bool empty() const noexcept { return entry == nullptr; }
+
+    friend bool operator==(const InternedName& lhs, const InternedName& rhs) noexcept { return lhs.entry == rhs.entry; }
+
+    friend std::strong_ordering operator<=>(const InternedName& lhs, const InternedName& rhs) noexcept {
+        if (lhs.entry == rhs.entry) return std::strong_ordering::equal;
+        return lhs.view().compare(rhs.view()) <=> 0;
+    }
+
+    friend bool operator==(const InternedName& lhs, std::string_view rhs) noexcept { return lhs.view() == rhs; }
+
+    friend std::strong_ordering operator<=>(const InternedName& lhs, std::string_view rhs) noexcept {
+        return lhs.view().compare(rhs) <=> 0;
+    }
+};
+
+/**
+ * @brief InternedName хранит только указатель, поэтому перемещается побайтово.
+ */
+template<>
+struct TriviallyRelocatable<InternedName> : std::true_type {};
+
+/**
+ * @brief Префикс интернированного имени - префикс его текста.
+ */
+template<>
+struct TableKeyPrefix<InternedName> {
+    static uint64_t get(std::string_view key) noexcept { return TableKeyPrefix<std::string>::get(key); }
+    static uint64_t get(const InternedName& key) noexcept { return TableKeyPrefix<std::string>::get(key.view()); }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,184 @@
+#ifndef LAB3_CONTENT_VIEW_H
+#define LAB3_CONTENT_VIEW_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Список фрагментов содержимого файла.
+ *
+ * Фрагменты и сам список разделяются через std::shared_ptr: пока на них ссылается
+ * ContentView, владелец не изменяет их на месте, а копирует перед записью.
+ */
+struct ContentChunks {
+    std::pmr::vector<std::shared_ptr<std::pmr::string>> chunks;  ///< Фрагменты по порядку
+    size_t length = 0;                                           ///< Общий размер содержимого
+    mutable std::atomic<uint64_t> blobId{0};                     ///< Идентификатор в ContentStore (0 - не зарегистрирован)
+    bool packed = false;                                         ///< Фрагменты сжаты LZCodec (такой список не попадает в ContentView)
+
+    /**
+     * @brief Конструктор пустого списка.
+     * @param resource Ресурс памяти
+     */
+    explicit ContentChunks(std::pmr::memory_resource* resource) : chunks(resource) {}
+
+    /**
+     * @brief Конструктор копии списка (фрагменты разделяются, а не копируются; копия не зарегистрирована).
+     * @param other Исходный список
+     * @param resource Ресурс памяти
+     */
+    ContentChunks(const ContentChunks& other, std::pmr::memory_resource* resource)
+        : chunks(other.chunks, resource), length(other.length), packed(other.packed) {}
+
+    /**
+     * @brief Деструктор; зарегистрированный список снимается с учёта в ContentStore.
+     */
+    ~ContentChunks();
+};
+
+/**
+ * @brief Неизменяемое представление содержимого файла без копирования данных.
+ *
+ * Удерживает версию содержимого, существовавшую в момент чтения: последующие записи
+ * в файл её не меняют. Получение и копирование представления не выделяют память,
+ * а std::string_view, возвращаемые chunk() и forEachChunk(), действительны, пока
+ * жив хотя бы один экземпляр представления.
+ */
+class ContentView {
+private:
+    std::shared_ptr<const ContentChunks> data;  ///< Удерживаемая версия (nullptr - пустое содержимое)
+
+    friend class FileContent;
+    friend class ContentStore;
+
+public:
+    /**
+     * @brief Конструктор пустого представления.
+     */
+    ContentView() noexcept = default;
+
+    /**
+     * @brief Конструктор представления версии содержимого.
+     * @param chunks Список фрагментов
+     */
+    explicit ContentView(std::shared_ptr<const ContentChunks> chunks) noexcept : data(std::move(chunks)) {}
+
+    /**
+     * @brief Получить размер содержимого.
+     * @return Размер в байтах
+     */
+    size_t size() const noexcept { return data ? data->length : 0; }
+
+    /**
+     * @brief Проверить, пусто ли содержимое.
+     * @return true если содержимое пусто
+     */
+    bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Получить количество фрагментов.
+     * @return Количество фрагментов
+     */
+    size_t chunkCount() const noexcept { return data ? data->chunks.size() : 0; }
+
+    /**
+     * @brief Получить фрагмент.
+     * @param index Номер фрагмента
+     * @return Данные фрагмента
+     */
+    std::string_view chunk(size_t index) const noexcept { return *data->chunks[index]; }
+
+    /**
+     * @brief Проверить, лежит ли содержимое в одном непрерывном буфере.
+     * @return true если фрагментов не больше одного
+     */
+    bool isContiguous() const noexcept { return chunkCount() <= 1; }
+
+    /**
+     * @brief Получить непрерывное содержимое.
+     * @return Содержимое целиком, если isContiguous(), иначе первый фрагмент
+     */
+    std::string_view front() const noexcept { return chunkCount() ? chunk(0) : std::string_view(); }
+
+    /**
+     * @brief Обойти содержимое по фрагментам.
+     * @param visit Функция, вызываемая для каждого фрагмента (std::string_view) по порядку
+     */
+    template<typename Visit>
+    void forEachChunk(Visit&& visit) const {
+        for (size_t i = 0; i < chunkCount(); i++) visit(chunk(i));
+    }
+
+    /**
+     * @brief Собрать содержимое в одну строку.
+     * @return Копия содержимого
+     */
+    std::string str() const {
+        std::string result;
+        result.reserve(size());
+        forEachChunk([&](std::string_view part) { result.append(part); });
+        return result;
+    }
+
+    /**
+     * @brief Сравнить содержимое со строкой без сборки.
+     * @param view Представление
+     * @param text Строка
+     * @return true если содержимое совпадает со строкой
+     */
+    friend bool operator==(const ContentView& view, std::string_view text) noexcept {
+        if (view.size() != text.size()) return false;
+        size_t offset = 0;
+        for (size_t i = 0; i < view.chunkCount(); i++) {
+            std::string_view part = view.chunk(i);
+            if (text.substr(offset, part.size()) != part) return false;
+            offset += part.size();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Сравнить содержимое двух представлений без сборки.
+     * @param a Первое представление
+     * @param b Второе представление
+     * @return true если содержимое совпадает
+     */
+    friend bool operator==(const ContentView& a, const ContentView& b) noexcept {
+        if (a.data == b.data) return true;
+        if (a.size() != b.size()) return false;
+        size_t i = 0, j = 0, offsetA = 0, offsetB = 0;
+        while (i < a.chunkCount() && j < b.chunkCount()) {
+            std::string_view partA = a.chunk(i).substr(offsetA);
+            std::string_view partB = b.chunk(j).substr(offsetB);
+            size_t common = std::min(partA.size(), partB.size());
+            if (partA.substr(0, common) != partB.substr(0, common)) return false;
+            offsetA += common;
+            offsetB += common;
+            if (offsetA == a.chunk(i).size()) { i++; offsetA = 0; }
+            if (offsetB == b.chunk(j).size()) { j++; offsetB = 0; }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Вывести содержимое в поток по фрагментам.
+     * @param out Поток
+     * @param view Представление
+     * @return Поток
+     */
+    friend std::ostream& operator<<(std::ostream& out, const ContentView& view) {
+        view.forEachChunk([&](std::string_view part) { out.write(part.data(), static_cast<std::streamsize>(part.size())); });
+        return out;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,205 @@
+#ifndef LAB3_FILE_LOCK_H
+#define LAB3_FILE_LOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Блокировка файла с разделяемым (чтение) и исключительным (запись) захватом.
+ *
+ * Всё состояние упаковано в одно 32-битное атомарное слово: бит писателя, бит наличия
+ * ожидающих, бит ожидающего писателя и счётчик читателей. Захват и освобождение без
+ * конкуренции - одна атомарная операция. Потоки, которым не удалось захватить блокировку
+ * за несколько попыток, засыпают в общей для процесса таблице ожидания (parking lot):
+ * мьютекс и условная переменная выбираются по адресу блокировки, поэтому сама блокировка
+ * не хранит объектов синхронизации. Освобождающий поток обращается к таблице, только если
+ * установлен бит ожидающих.
+ *
+ * Ожидающий писатель не пропускает новых читателей, так что поток чтений не может
+ * бесконечно откладывать запись. Методы названы как у std::shared_timed_mutex, поэтому
+ * блокировку можно использовать с std::unique_lock и std::shared_lock.
+ */
+class FileLock {
+private:
+    static constexpr uint32_t WRITER = 1;           ///< Блокировка захвачена писателем
+    static constexpr uint32_t PARKED = 2;           ///< Есть уснувшие ожидающие потоки
+    static constexpr uint32_t WRITER_WAITING = 4;   ///< Писатель ждёт: новые читатели не входят
+    static constexpr uint32_t READER = 8;           ///< Единица счётчика читателей
+    static constexpr int SPIN_LIMIT = 64;           ///< Попыток захвата до засыпания
+
+    std::atomic<uint32_t> state{0};                 ///< Упакованное состояние
+
+    /**
+     * @brief Ячейка таблицы ожидания.
+     */
+    struct Bucket {
+        std::mutex mutex;                   ///< Защищает засыпание и пробуждение
+        std::condition_variable condition;  ///< Ожидающие потоки
+    };
+
+    /**
+     * @brief Получить ячейку таблицы ожидания для блокировки.
+     * @param lock Блокировка
+     * @return Ячейка
+     */
+    static Bucket& bucket(const FileLock* lock) noexcept {
+        static Bucket buckets[64];
+        return buckets[(reinterpret_cast<uintptr_t>(lock) / alignof(FileLock)) % 64];
+    }
+
+    /**
+     * @brief Разбудить всех ожидающих этой блокировки.
+     */
+    void unparkAll() noexcept {
+        state.fetch_and(~PARKED);
+        Bucket& b = bucket(this);
+        std::lock_guard<std::mutex> guard(b.mutex);
+        b.condition.notify_all();
+    }
+
+    /**
+     * @brief Захватить блокировку с ожиданием.
+     * @param exclusive Исключительный захват
+     * @param deadline Крайний срок (nullptr - ждать без ограничения)
+     * @return true если блокировка захвачена
+     */
+    template<typename Clock, typename Duration>
+    bool acquire(bool exclusive, const std::chrono::time_point<Clock, Duration>* deadline) {
+        const uint32_t flags = exclusive ? PARKED | WRITER_WAITING : PARKED;
+        for (int attempt = 0;; attempt++) {
+            if (exclusive ? try_lock() : try_lock_shared()) return true;
+            if (deadline && Clock::now() >= *deadline) {
+                if (exclusive && (state.fetch_and(~WRITER_WAITING) & PARKED)) unparkAll();
+                return false;
+            }
+            if (attempt < SPIN_LIMIT) {
+                std::this_thread::yield();
+                continue;
+            }
+            uint32_t current = state.load();
+            if ((current & flags) != flags && !state.compare_exchange_weak(current, current | flags)) continue;
+            Bucket& b = bucket(this);
+            std::unique_lock<std::mutex> guard(b.mutex);
+            auto woken = [this] { return !(state.load() & PARKED); };
+            if (deadline) b.condition.wait_until(guard, *deadline, woken);
+            else b.condition.wait(guard, woken);
+        }
+    }
+
+public:
+    FileLock() = default;
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    /**
+     * @brief Попытаться захватить блокировку исключительно без ожидания.
+     * @return true если блокировка захвачена
+     */
+    bool try_lock() noexcept {
+        uint32_t current = state.load(std::memory_order_relaxed);
+        while (!(current & WRITER) && current < READER) {
+            if (state.compare_exchange_weak(current, (current | WRITER) & ~WRITER_WAITING, std::memory_order_acquire, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Захватить блокировку исключительно, ожидая освобождения.
+     */
+    void lock() {
+        if (!try_lock()) acquire<std::chrono::steady_clock, std::chrono::steady_clock::duration>(true, nullptr);
+    }
+
+    /**
+     * @brief Захватить блокировку исключительно, ожидая не дольше заданного времени.
+     * @param timeout Время ожидания
+     * @return true если блокировка захвачена
+     */
+    template<typename Rep, typename Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return try_lock_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Захватить блокировку исключительно, ожидая не дольше крайнего срока.
+     * @param deadline Крайний срок
+     * @return true если блокировка захвачена
+     */
+    template<typename Clock, typename Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline) {
+        return try_lock() || acquire(true, &deadline);
+    }
+
+    /**
+     * @brief Освободить исключительный захват.
+     */
+    void unlock() noexcept {
+        if (state.fetch_and(~WRITER, std::memory_order_release) & PARKED) unparkAll();
+    }
+
+    /**
+     * @brief Попытаться захватить блокировку для чтения без ожидания.
+     * @return true если блокировка захвачена
+     */
+    bool try_lock_shared() noexcept {
+        uint32_t current = state.load(std::memory_order_relaxed);
+        while (!(current & (WRITER | WRITER_WAITING))) {
+            if (state.compare_exchange_weak(current, current + READER, std::memory_order_acquire, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Захватить блокировку для чтения, ожидая освобождения писателем.
+     */
+    void lock_shared() {
+        if (!try_lock_shared()) acquire<std::chrono::steady_clock, std::chrono::steady_clock::duration>(false, nullptr);
+    }
+
+    /**
+     * @brief Захватить блокировку для чтения, ожидая не дольше заданного времени.
+     * @param timeout Время ожидания
+     * @return true если блокировка захвачена
+     */
+    template<typename Rep, typename Period>
+    bool try_lock_shared_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return try_lock_shared_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Захватить блокировку для чтения, ожидая не дольше крайнего срока.
+     * @param deadline Крайний срок
+     * @return true если блокировка захвачена
+     */
+    template<typename Clock, typename Duration>
+    bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration>& deadline) {
+        return try_lock_shared() || acquire(false, &deadline);
+    }
+
+    /**
+     * @brief Освободить захват для чтения.
+     */
+    void unlock_shared() noexcept {
+        uint32_t remaining = state.fetch_sub(READER, std::memory_order_release) - READER;
+        if (remaining < READER && (remaining & PARKED)) unparkAll();
+    }
+
+    /**
+     * @brief Проверить, захвачена ли блокировка писателем.
+     * @return true если блокировка захвачена исключительно
+     */
+    bool isLocked() const noexcept { return state.load(std::memory_order_relaxed) & WRITER; }
+
+    /**
+     * @brief Получить количество читателей, удерживающих блокировку.
+     * @return Количество читателей
+     */
+    size_t readerCount() const noexcept { return state.load(std::memory_order_relaxed) / READER; }
+};
+
+#endif
\ No newline at end of file
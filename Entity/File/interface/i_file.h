@@ -1,8 +1,13 @@
 #ifndef LAB3_I_FILE_H
 #define LAB3_I_FILE_H
 
+#include "content_view.h"
+#include <chrono>
+#include <cstddef>
 #include <string>
 
+class IFileSystemObject;
+
 /**
  * @brief Интерфейс файла файловой системы.
  *
@@ -13,6 +18,18 @@ class IFile {
 public:
     virtual ~IFile() = default;
 
+    /**
+     * @brief Получить файл как объект файловой системы
+     * @return Объект файловой системы
+     */
+    virtual IFileSystemObject* asObject() noexcept = 0;
+
+    /**
+     * @brief Получить файл как объект файловой системы
+     * @return Объект файловой системы
+     */
+    virtual const IFileSystemObject* asObject() const noexcept = 0;
+
     /**
      * @brief Записать содержимое в файл
      * @param cont Содержимое для записи
@@ -20,12 +37,32 @@ public:
      */
     virtual bool writeContent(std::string_view cont) = 0;
 
+    /**
+     * @brief Дописать данные в конец файла
+     * @param cont Данные для добавления
+     * @return true если запись успешна, иначе false
+     */
+    virtual bool appendContent(std::string_view cont) = 0;
+
+    /**
+     * @brief Заменить содержимое версией другого файла без копирования данных
+     * @param cont Представление содержимого
+     * @return true если запись успешна, иначе false
+     */
+    virtual bool shareContent(const ContentView& cont) = 0;
+
     /**
      * @brief Прочитать содержимое файла
      * @return Содержимое файла
      */
     virtual std::string readContent() const = 0;
 
+    /**
+     * @brief Получить содержимое файла без копирования
+     * @return Неизменяемое представление текущей версии содержимого
+     */
+    virtual ContentView viewContent() const = 0;
+
     /**
      * @brief Обрезать содержимое файла до указанного индекса
      * @param index Индекс до которого обрезать
@@ -56,6 +93,42 @@ public:
      * @return Содержимое файла
      */
     virtual std::string readContentAlways() const = 0;
+
+    /**
+     * @brief Получить содержимое файла без копирования (альтернативная версия)
+     * @return Неизменяемое представление текущей версии содержимого
+     */
+    virtual ContentView viewContentAlways() const = 0;
+
+    /**
+     * @brief Получить время последнего обращения к содержимому
+     * @return Время последнего чтения или изменения файла
+     */
+    virtual std::chrono::system_clock::time_point getLastAccessTime() const = 0;
+
+    /**
+     * @brief Сжать содержимое файла в памяти
+     * @return true если содержимое сжато
+     */
+    virtual bool compressContent() = 0;
+
+    /**
+     * @brief Распаковать сжатое содержимое на месте
+     * @return true если содержимое было сжато
+     */
+    virtual bool decompressContent() = 0;
+
+    /**
+     * @brief Проверить, хранится ли содержимое сжатым
+     * @return true если содержимое сжато
+     */
+    virtual bool isContentCompressed() const = 0;
+
+    /**
+     * @brief Получить объём памяти, занимаемый данными содержимого
+     * @return Размер хранимых (при сжатии - сжатых) данных в байтах
+     */
+    virtual size_t getStoredSize() const = 0;
 };
 
 #endif
\ No newline at end of file
@@ -2,11 +2,14 @@
 #define LAB3_I_LOCKABLE_H
 
 #include "base.h"
+#include "file_lock.h"
 
 /**
  * @brief Интерфейс блокируемого объекта.
  *
  * Определяет методы для управления блокировками и проверки состояния блокировки.
+ * Режим (setMode) - постоянный запрет чтения или записи, а getAccessLock() - блокировка,
+ * которой сериализуется одновременный доступ потоков.
  */
 class ILockable {
 public:
@@ -29,6 +32,12 @@ public:
      * @return true если объект доступен для записи, иначе false
      */
     virtual bool isWritable() const = 0;
+
+    /**
+     * @brief Получить блокировку доступа к объекту
+     * @return Блокировка: разделяемый захват для чтения, исключительный - для записи
+     */
+    virtual FileLock& getAccessLock() const = 0;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "content_store.h"
+#include "file_content.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;   ///< Множитель слова
+    constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;   ///< Множитель состояния
+
+    /**
+     * @brief Потоковое вычисление хеша содержимого по 8-байтовым словам.
+     */
+    class ContentHasher {
+    private:
+        uint64_t state = PRIME_2;   ///< Состояние
+        uint64_t length = 0;        ///< Обработано байт
+
+        /**
+         * @brief Учесть одно слово.
+         * @param word Слово
+         */
+        void mix(uint64_t word) noexcept {
+            state ^= std::rotl(word * PRIME_1, 31) * PRIME_2;
+            state = std::rotl(state, 27) * PRIME_1 + PRIME_2;
+        }
+
+    public:
+        /**
+         * @brief Учесть очередную часть содержимого (все части, кроме последней, кратны 8 байтам).
+         * @param part Часть содержимого
+         */
+        void update(std::string_view part) noexcept {
+            length += part.size();
+            size_t i = 0;
+            for (; i + 8 <= part.size(); i += 8) {
+                uint64_t word;
+                std::memcpy(&word, part.data() + i, 8);
+                mix(word);
+            }
+            if (i < part.size()) {
+                uint64_t word = 0;
+                std::memcpy(&word, part.data() + i, part.size() - i);
+                mix(word);
+            }
+        }
+
+        /**
+         * @brief Завершить вычисление.
+         * @return Хеш (не 0)
+         */
+        uint64_t finish() const noexcept {
+            uint64_t h = state ^ length;
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDULL;
+            h ^= h >> 33;
+            h *= 0xC4CEB9FE1A85EC53ULL;
+            h ^= h >> 33;
+            return h ? h : 1;
+        }
+    };
+}
+
+ContentStore& ContentStore::instance() {
+    // Не уничтожается: блобы в статических объектах снимаются с учёта и после выхода из main.
+    static ContentStore* store = new ContentStore();
+    return *store;
+}
+
+ContentStore::BlobId ContentStore::hashContent(const ContentView& content) noexcept {
+    ContentHasher hasher;
+    content.forEachChunk([&](std::string_view part) { hasher.update(part); });
+    return hasher.finish();
+}
+
+ContentStore::BlobId ContentStore::hashContent(std::string_view content) noexcept {
+    ContentHasher hasher;
+    hasher.update(content);
+    return hasher.finish();
+}
+
+std::string ContentStore::formatId(BlobId id) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << id;
+    return out.str();
+}
+
+ContentStore::BlobId ContentStore::parseId(const std::string& text) noexcept {
+    if (text.empty() || text.size() > 16) return 0;
+    BlobId id = 0;
+    for (char c : text) {
+        int digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return 0;
+        id = (id << 4) | static_cast<BlobId>(digit);
+    }
+    return id;
+}
+
+ContentChunks::~ContentChunks() {
+    if (ContentStore::BlobId id = blobId.load(std::memory_order_acquire)) ContentStore::instance().release(id, this);
+}
+
+template<typename Content>
+ContentView ContentStore::lookup(BlobId hash, const Content& content, BlobId& freeId) const {
+    for (BlobId candidate = hash;; candidate = candidate + 1 ? candidate + 1 : 1) {
+        auto it = blobs.find(candidate);
+        if (it == blobs.end()) {
+            freeId = candidate;
+            return {};
+        }
+        // Пока запись в таблице, блоб жив (его деструктор ждёт mutex), поэтому сравнение
+        // идёт по невладеющему указателю и не может уничтожить блоб под блокировкой.
+        ContentView candidateView(std::shared_ptr<const ContentChunks>(std::shared_ptr<void>(), it->second.chunks));
+        if (!(candidateView == content)) continue;
+        std::shared_ptr<const ContentChunks> owner = it->second.owner.lock();
+        if (!owner) continue;
+        freeId = candidate;
+        return ContentView(std::move(owner));
+    }
+}
+
+std::shared_ptr<ContentChunks> ContentStore::copyChunks(const ContentView& content) {
+    std::pmr::polymorphic_allocator<> alloc(&resource);
+    auto chunks = std::allocate_shared<ContentChunks>(alloc, &resource);
+    chunks->length = content.size();
+    chunks->chunks.reserve(content.chunkCount());
+    content.forEachChunk([&](std::string_view part) {
+        chunks->chunks.push_back(std::allocate_shared<std::pmr::string>(alloc, part));
+    });
+    return chunks;
+}
+
+std::shared_ptr<ContentChunks> ContentStore::copyChunks(std::string_view content) {
+    std::pmr::polymorphic_allocator<> alloc(&resource);
+    auto chunks = std::allocate_shared<ContentChunks>(alloc, &resource);
+    chunks->length = content.size();
+    chunks->chunks.reserve((content.size() + FileContent::CHUNK_SIZE - 1) / FileContent::CHUNK_SIZE);
+    for (size_t offset = 0; offset < content.size(); offset += FileContent::CHUNK_SIZE) {
+        chunks->chunks.push_back(std::allocate_shared<std::pmr::string>(alloc, content.substr(offset, FileContent::CHUNK_SIZE)));
+    }
+    return chunks;
+}
+
+template<typename Content>
+ContentView ContentStore::internCopy(const Content& content, BlobId* id) {
+    BlobId hash = hashContent(content);
+    BlobId freeId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ContentView found = lookup(hash, content, freeId);
+        if (!found.empty()) {
+            if (id) *id = freeId;
+            return found;
+        }
+    }
+    // Копия строится без блокировки, поэтому такой же блоб мог успеть зарегистрировать другой поток.
+    std::shared_ptr<ContentChunks> copy = copyChunks(content);
+    std::lock_guard<std::mutex> lock(mutex);
+    ContentView found = lookup(hash, content, freeId);
+    if (id) *id = freeId;
+    if (!found.empty()) return found;
+    blobs.emplace(freeId, Entry{copy, copy.get()});
+    copy->blobId.store(freeId, std::memory_order_release);
+    return ContentView(std::move(copy));
+}
+
+ContentView ContentStore::intern(const ContentView& content, BlobId* id) {
+    if (content.empty()) {
+        if (id) *id = 0;
+        return {};
+    }
+    if (BlobId known = content.data->blobId.load(std::memory_order_acquire)) {
+        if (id) *id = known;
+        return content;
+    }
+    return internCopy(content, id);
+}
+
+ContentView ContentStore::intern(std::string_view content, BlobId* id) {
+    if (content.empty()) {
+        if (id) *id = 0;
+        return {};
+    }
+    return internCopy(content, id);
+}
+
+void ContentStore::release(BlobId id, const ContentChunks* chunks) noexcept {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = blobs.find(id);
+    if (it != blobs.end() && it->second.chunks == chunks) blobs.erase(it);
+}
+
+ContentView ContentStore::find(BlobId id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = blobs.find(id);
+    if (it == blobs.end()) return {};
+    return ContentView(it->second.owner.lock());
+}
+
+ContentStore::Statistics ContentStore::statistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Statistics result;
+    for (const auto& [id, entry] : blobs) {
+        result.blobs++;
+        result.bytes += entry.chunks->length;
+    }
+    return result;
+}
\ No newline at end of file
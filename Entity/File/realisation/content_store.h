@@ -0,0 +1,174 @@
+#ifndef LAB3_CONTENT_STORE_H
+#define LAB3_CONTENT_STORE_H
+
+#include "Entity/File/interface/content_view.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Общее для процесса хранилище содержимого файлов с адресацией по хешу.
+ *
+ * Блоб - неизменяемая версия содержимого (ContentChunks). Его идентификатор - 64-битный
+ * хеш содержимого (при коллизии берётся следующее свободное значение), так что одинаковое
+ * содержимое разных файлов сводится к одному блобу. Счётчиком ссылок служит std::shared_ptr
+ * в файлах и представлениях: хранилище держит только std::weak_ptr, а освобождаемый блоб
+ * сам снимается с учёта из деструктора, поэтому в таблице нет мёртвых записей и ссылок
+ * в память уже уничтоженных ресурсов.
+ *
+ * Хранилище общее для всех репозиториев, поэтому зарегистрированные блобы размещаются
+ * в его собственном ресурсе памяти: содержимое копируется туда при первой регистрации и
+ * не ссылается на ресурс репозитория, который может быть уничтожен раньше других файлов,
+ * разделяющих блоб. Само хранилище не уничтожается до конца процесса.
+ *
+ * Зарегистрированный блоб помечается идентификатором и больше не изменяется на месте:
+ * FileContent копирует его перед записью.
+ */
+class ContentStore {
+public:
+    using BlobId = uint64_t;    ///< Идентификатор блоба (0 - пустое содержимое)
+
+    /**
+     * @brief Сводка по зарегистрированным блобам.
+     */
+    struct Statistics {
+        size_t blobs = 0;   ///< Количество живых блобов
+        size_t bytes = 0;   ///< Суммарный размер живых блобов
+    };
+
+private:
+    /**
+     * @brief Запись о блобе.
+     */
+    struct Entry {
+        std::weak_ptr<const ContentChunks> owner;   ///< Слабая ссылка для выдачи новых владельцев
+        const ContentChunks* chunks;                ///< Блоб (жив, пока запись в таблице)
+    };
+
+    std::pmr::synchronized_pool_resource resource;  ///< Память зарегистрированных блобов
+    mutable std::mutex mutex;                       ///< Защищает таблицу блобов
+    std::unordered_map<BlobId, Entry> blobs;        ///< Блобы по идентификатору
+
+    friend struct ContentChunks;
+
+    ContentStore() = default;
+
+    /**
+     * @brief Найти зарегистрированный блоб с таким же содержимым. Вызывается под mutex.
+     * @param hash Хеш содержимого
+     * @param content Содержимое
+     * @param freeId Куда записать первый свободный идентификатор, если блоб не найден
+     * @return Представление блоба или пустое представление
+     */
+    template<typename Content>
+    ContentView lookup(BlobId hash, const Content& content, BlobId& freeId) const;
+
+    /**
+     * @brief Скопировать содержимое в ресурс хранилища.
+     * @param content Содержимое
+     * @return Новый незарегистрированный список фрагментов
+     */
+    std::shared_ptr<ContentChunks> copyChunks(const ContentView& content);
+
+    /**
+     * @brief Скопировать строку в ресурс хранилища фрагментами по FileContent::CHUNK_SIZE.
+     * @param content Содержимое
+     * @return Новый незарегистрированный список фрагментов
+     */
+    std::shared_ptr<ContentChunks> copyChunks(std::string_view content);
+
+    /**
+     * @brief Найти блоб с таким же содержимым или зарегистрировать его копию.
+     * @param content Непустое содержимое
+     * @param id Куда записать идентификатор блоба (может быть nullptr)
+     * @return Представление блоба
+     */
+    template<typename Content>
+    ContentView internCopy(const Content& content, BlobId* id);
+
+    /**
+     * @brief Снять блоб с учёта. Вызывается из деструктора ContentChunks.
+     * @param id Идентификатор
+     * @param chunks Уничтожаемый блоб
+     */
+    void release(BlobId id, const ContentChunks* chunks) noexcept;
+
+public:
+    /**
+     * @brief Получить хранилище процесса.
+     * @return Хранилище
+     */
+    static ContentStore& instance();
+
+    /**
+     * @brief Вычислить хеш содержимого.
+     *
+     * Хеш обрабатывает данные 8-байтовыми словами и не зависит от разбиения на фрагменты,
+     * если все фрагменты, кроме последнего, кратны 8 байтам (FileContent::CHUNK_SIZE кратен).
+     *
+     * @param content Содержимое
+     * @return Хеш (не равен 0 для непустого содержимого)
+     */
+    static BlobId hashContent(const ContentView& content) noexcept;
+
+    /**
+     * @brief Вычислить хеш содержимого, заданного строкой.
+     * @param content Содержимое
+     * @return Хеш, совпадающий с hashContent(ContentView) для того же содержимого
+     */
+    static BlobId hashContent(std::string_view content) noexcept;
+
+    /**
+     * @brief Записать идентификатор в текстовом виде.
+     * @param id Идентификатор
+     * @return 16 шестнадцатеричных цифр
+     */
+    static std::string formatId(BlobId id);
+
+    /**
+     * @brief Разобрать текстовый идентификатор.
+     * @param text Текст
+     * @return Идентификатор или 0, если текст некорректен
+     */
+    static BlobId parseId(const std::string& text) noexcept;
+
+    /**
+     * @brief Зарегистрировать содержимое или найти уже зарегистрированный блоб с таким же содержимым.
+     *
+     * Незарегистрированное содержимое копируется в ресурс хранилища; уже зарегистрированный
+     * блоб возвращается как есть.
+     *
+     * @param content Содержимое
+     * @param id Куда записать идентификатор блоба (может быть nullptr)
+     * @return Представление блоба; его содержимое равно content
+     */
+    ContentView intern(const ContentView& content, BlobId* id = nullptr);
+
+    /**
+     * @brief Зарегистрировать содержимое, заданное строкой, без промежуточной копии.
+     * @param content Содержимое
+     * @param id Куда записать идентификатор блоба (может быть nullptr)
+     * @return Представление блоба; его содержимое равно content
+     */
+    ContentView intern(std::string_view content, BlobId* id = nullptr);
+
+    /**
+     * @brief Найти блоб по идентификатору.
+     * @param id Идентификатор
+     * @return Представление блоба или пустое представление, если блоб не найден
+     */
+    ContentView find(BlobId id) const;
+
+    /**
+     * @brief Получить сводку по живым блобам.
+     * @return Количество и суммарный размер блобов
+     */
+    Statistics statistics() const;
+};
+
+#endif
\ No newline at end of file
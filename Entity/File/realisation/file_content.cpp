@@ -0,0 +1,139 @@
+#include "file_content.h"
+#include "content_store.h"
+#include "lz_codec.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+FileContent::FileContent(std::pmr::memory_resource* resource) : resource(resource) {}
+
+ContentChunks& FileContent::mutableData() {
+    unpack();
+    std::pmr::polymorphic_allocator<> alloc(resource);
+    if (!data) data = std::allocate_shared<ContentChunks>(alloc, resource);
+    else if (data.use_count() > 1 || data->blobId.load(std::memory_order_acquire)) data = std::allocate_shared<ContentChunks>(alloc, *data, resource);
+    return *data;
+}
+
+std::pmr::string& FileContent::mutableLastChunk() {
+    std::shared_ptr<std::pmr::string>& chunk = data->chunks.back();
+    if (chunk.use_count() > 1) {
+        auto copy = std::allocate_shared<std::pmr::string>(std::pmr::polymorphic_allocator<>(resource));
+        copy->reserve(data->chunks.size() > 1 ? CHUNK_SIZE : chunk->size());
+        copy->append(*chunk);
+        chunk = std::move(copy);
+    }
+    return *chunk;
+}
+
+void FileContent::pushChunk(size_t reserve) {
+    auto chunk = std::allocate_shared<std::pmr::string>(std::pmr::polymorphic_allocator<>(resource));
+    chunk->reserve(reserve);
+    data->chunks.push_back(std::move(chunk));
+}
+
+void FileContent::assign(std::string_view text) {
+    clear();
+    data = std::const_pointer_cast<ContentChunks>(ContentStore::instance().intern(text).data);
+}
+
+void FileContent::intern() {
+    if (data && !data->packed) data = std::const_pointer_cast<ContentChunks>(ContentStore::instance().intern(view()).data);
+}
+
+void FileContent::share(const ContentView& view) noexcept {
+    unpackedCache.store(nullptr);
+    data = std::const_pointer_cast<ContentChunks>(view.data);
+}
+
+void FileContent::append(std::string_view text) {
+    if (text.empty()) return;
+    ContentChunks& chunks = mutableData();
+    if (chunks.chunks.empty()) pushChunk(std::min(text.size(), CHUNK_SIZE));
+    while (!text.empty()) {
+        if (chunks.chunks.back()->size() == CHUNK_SIZE) pushChunk(CHUNK_SIZE);
+        std::pmr::string& last = mutableLastChunk();
+        size_t take = std::min(CHUNK_SIZE - last.size(), text.size());
+        last.append(text.substr(0, take));
+        text.remove_prefix(take);
+        chunks.length += take;
+    }
+}
+
+bool FileContent::truncate(size_t newLength) {
+    if (newLength > size()) return false;
+    if (newLength == size()) return true;
+    if (newLength == 0) {
+        clear();
+        return true;
+    }
+    ContentChunks& chunks = mutableData();
+    size_t keep = (newLength + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunks.chunks.resize(keep);
+    mutableLastChunk().resize(newLength - (keep - 1) * CHUNK_SIZE);
+    chunks.length = newLength;
+    return true;
+}
+
+void FileContent::clear() noexcept {
+    unpackedCache.store(nullptr);
+    data.reset();
+}
+
+bool FileContent::compress() {
+    unpackedCache.store(nullptr);
+    if (!data || data->packed || data.use_count() > 1 || data->length < MIN_COMPRESS_SIZE) return false;
+    std::pmr::polymorphic_allocator<> alloc(resource);
+    auto packed = std::allocate_shared<ContentChunks>(alloc, resource);
+    packed->packed = true;
+    packed->length = data->length;
+    packed->chunks.reserve(data->chunks.size());
+    std::vector<char> buffer(LZCodec::maxCompressedSize(CHUNK_SIZE));
+    size_t packedSize = 0;
+    for (const auto& chunk : data->chunks) {
+        buffer.resize(std::max(buffer.size(), LZCodec::maxCompressedSize(chunk->size())));
+        size_t written = LZCodec::compress(*chunk, buffer.data());
+        packedSize += written;
+        if (packedSize > data->length - data->length / 8) return false;
+        packed->chunks.push_back(std::allocate_shared<std::pmr::string>(alloc, buffer.data(), written));
+    }
+    data = std::move(packed);
+    return true;
+}
+
+std::shared_ptr<ContentChunks> FileContent::unpacked() const {
+    if (auto cached = unpackedCache.load()) return cached;
+    std::pmr::polymorphic_allocator<> alloc(resource);
+    auto chunks = std::allocate_shared<ContentChunks>(alloc, resource);
+    chunks->length = data->length;
+    chunks->chunks.reserve(data->chunks.size());
+    size_t remaining = data->length;
+    for (const auto& packed : data->chunks) {
+        size_t length = std::min(remaining, CHUNK_SIZE);
+        auto chunk = std::allocate_shared<std::pmr::string>(alloc, length, '\0');
+        if (!LZCodec::decompress(*packed, chunk->data(), length)) throw std::runtime_error("Compressed file content is corrupted");
+        chunks->chunks.push_back(std::move(chunk));
+        remaining -= length;
+    }
+    if (remaining != 0) throw std::runtime_error("Compressed file content is corrupted");
+    // Параллельные читатели могли распаковать ту же версию: остаётся первая опубликованная копия.
+    std::shared_ptr<ContentChunks> expected;
+    if (!unpackedCache.compare_exchange_strong(expected, chunks)) return expected;
+    return chunks;
+}
+
+bool FileContent::unpack() {
+    if (!isCompressed()) return false;
+    data = unpacked();
+    unpackedCache.store(nullptr);
+    return true;
+}
+
+size_t FileContent::storedSize() const noexcept {
+    if (!data) return 0;
+    size_t stored = 0;
+    for (const auto& chunk : data->chunks) stored += chunk->size();
+    if (auto cached = unpackedCache.load()) stored += cached->length;
+    return stored;
+}
\ No newline at end of file
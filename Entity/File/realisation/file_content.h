@@ -0,0 +1,201 @@
+#ifndef LAB3_FILE_CONTENT_H
+#define LAB3_FILE_CONTENT_H
+
+#include "Entity/File/interface/content_view.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Содержимое файла, хранимое фрагментами.
+ *
+ * Небольшое содержимое (до CHUNK_SIZE байт) хранится одним фрагментом. Большее содержимое
+ * разбивается на фрагменты по CHUNK_SIZE байт (последний может быть неполным), поэтому
+ * дописывание в конец не копирует уже записанные данные: заполняется последний фрагмент
+ * и при необходимости добавляются новые.
+ *
+ * Чтение через view() отдаёт текущую версию без копирования, а share() делает эту версию
+ * содержимым другого файла. Если версию удерживает кто-то ещё (представление или другой
+ * файл), запись копирует список фрагментов и изменяемый фрагмент, но не остальные данные.
+ *
+ * Полная перезапись (assign) проходит через ContentStore: одинаковое содержимое разных
+ * файлов хранится одним блобом в памяти хранилища, а не в resource. Дописывание и усечение
+ * в хранилище не заходят, чтобы оставаться пропорциональными объёму изменения.
+ *
+ * Редко используемое содержимое можно сжать (compress): каждый фрагмент сжимается LZCodec
+ * отдельно. view() не меняет хранение: распакованная копия публикуется атомарно и
+ * переиспользуется следующими чтениями, пока содержимое не изменится или не будет
+ * сжато снова. unpack() и любая запись распаковывают содержимое на месте.
+ *
+ * Константные методы можно вызывать параллельно друг с другом; неконстантные требуют
+ * исключительного доступа (FileLock владельца).
+ */
+class FileContent {
+public:
+    static constexpr size_t CHUNK_SIZE = 16 * 1024;  ///< Размер фрагмента и граница хранения одним фрагментом
+    static constexpr size_t MIN_COMPRESS_SIZE = 512; ///< Минимальный размер содержимого для сжатия
+
+private:
+    std::pmr::memory_resource* resource;            ///< Ресурс памяти для фрагментов
+    std::shared_ptr<ContentChunks> data;            ///< Текущая версия (nullptr - пустое содержимое)
+    mutable std::atomic<std::shared_ptr<ContentChunks>> unpackedCache; ///< Распакованная копия сжатой версии
+
+    /**
+     * @brief Получить распакованную копию сжатой версии, распаковав и опубликовав её при первом обращении.
+     * @return Несжатый список фрагментов
+     * @throws std::runtime_error если сжатые данные повреждены
+     */
+    std::shared_ptr<ContentChunks> unpacked() const;
+
+    /**
+     * @brief Получить список фрагментов для изменения, скопировав его, если он разделяется
+     * или зарегистрирован в ContentStore.
+     * @return Список фрагментов
+     */
+    ContentChunks& mutableData();
+
+    /**
+     * @brief Получить последний фрагмент для изменения, скопировав его, если он разделяется.
+     * @return Фрагмент
+     */
+    std::pmr::string& mutableLastChunk();
+
+    /**
+     * @brief Добавить пустой фрагмент в конец.
+     * @param reserve Заранее выделяемая емкость
+     */
+    void pushChunk(size_t reserve);
+
+public:
+    /**
+     * @brief Конструктор пустого содержимого.
+     * @param resource Ресурс памяти для фрагментов
+     */
+    explicit FileContent(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Заменить содержимое.
+     * @param data Новое содержимое
+     */
+    void assign(std::string_view data);
+
+    /**
+     * @brief Заменить содержимое блобом из ContentStore с таким же содержимым, зарегистрировав его при необходимости.
+     */
+    void intern();
+
+    /**
+     * @brief Заменить содержимое версией из представления без копирования данных.
+     *
+     * Фрагменты остаются в ресурсе памяти исходного содержимого.
+     *
+     * @param view Представление содержимого
+     */
+    void share(const ContentView& view) noexcept;
+
+    /**
+     * @brief Дописать данные в конец.
+     * @param data Данные
+     */
+    void append(std::string_view data);
+
+    /**
+     * @brief Обрезать содержимое.
+     * @param newLength Новый размер
+     * @return true если newLength не превышает текущий размер
+     */
+    bool truncate(size_t newLength);
+
+    /**
+     * @brief Очистить содержимое.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Получить размер содержимого.
+     * @return Размер в байтах
+     */
+    size_t size() const noexcept { return data ? data->length : 0; }
+
+    /**
+     * @brief Проверить, пусто ли содержимое.
+     * @return true если содержимое пусто
+     */
+    bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Проверить, разбито ли содержимое на несколько фрагментов.
+     * @return true если фрагментов больше одного
+     */
+    bool isChunked() const noexcept { return chunkCount() > 1; }
+
+    /**
+     * @brief Получить количество фрагментов.
+     * @return Количество фрагментов
+     */
+    size_t chunkCount() const noexcept { return data ? data->chunks.size() : 0; }
+
+    /**
+     * @brief Сжать содержимое на месте.
+     *
+     * Содержимое не сжимается, если оно меньше MIN_COMPRESS_SIZE, уже сжато, разделяется
+     * с другим файлом или представлением (память всё равно не освободится) или сжатие
+     * экономит меньше восьмой части. Распакованная копия уже сжатого содержимого
+     * при этом освобождается.
+     *
+     * @return true если содержимое сжато
+     */
+    bool compress();
+
+    /**
+     * @brief Распаковать содержимое на месте, если оно сжато.
+     * @return true если содержимое было сжато
+     * @throws std::runtime_error если сжатые данные повреждены
+     */
+    bool unpack();
+
+    /**
+     * @brief Проверить, сжато ли содержимое.
+     * @return true если содержимое хранится сжатым
+     */
+    bool isCompressed() const noexcept { return data && data->packed; }
+
+    /**
+     * @brief Получить объём, занимаемый фрагментами.
+     * @return Размер хранимых (при сжатии - сжатых вместе с распакованной копией) данных в байтах
+     */
+    size_t storedSize() const noexcept;
+
+    /**
+     * @brief Получить текущую версию содержимого.
+     *
+     * Несжатое содержимое отдаётся без копирования, сжатое - общей распакованной копией.
+     *
+     * @return Неизменяемое представление
+     */
+    ContentView view() const { return ContentView(isCompressed() ? unpacked() : data); }
+
+    /**
+     * @brief Собрать содержимое в одну строку.
+     * @return Копия содержимого
+     */
+    std::string str() const { return view().str(); }
+
+    /**
+     * @brief Обойти содержимое по фрагментам.
+     * @param visit Функция, вызываемая для каждого фрагмента (std::string_view) по порядку
+     */
+    template<typename Visit>
+    void forEachChunk(Visit&& visit) const { view().forEachChunk(std::forward<Visit>(visit)); }
+
+    /**
+     * @brief Получить ресурс памяти содержимого.
+     * @return Ресурс памяти
+     */
+    std::pmr::memory_resource* getResource() const noexcept { return resource; }
+};
+
+#endif
\ No newline at end of file
@@ -1,23 +1,46 @@
 #include "base.h"
 #include "file_descriptor.h"
+#include <algorithm>
 #include <string_view>
 #include <stdexcept>
 #include <string>
 
 
-FileDescriptor::FileDescriptor(const std::string &name, unsigned int parentAddress, const User &owner, unsigned int adr)
-    : FileSystemObject(name, parentAddress, owner, adr), size(0), mode(Lock::NotLock) {}
+FileDescriptor::FileDescriptor(const std::string &name, unsigned int parentAddress, const User &owner, unsigned int adr,
+                               std::pmr::memory_resource* resource)
+    : FileSystemObject(name, parentAddress, owner, adr, ObjectType::File), content(resource), size(0), mode(Lock::NotLock),
+      lastReadTime(std::chrono::system_clock::now().time_since_epoch().count()) {}
+
+void FileDescriptor::touchContent() const {
+    lastReadTime.store(std::chrono::system_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
 
 bool FileDescriptor::writeContent(std::string_view cont) {
     if (!isWritable()) throw std::runtime_error("File is not writable");
-    this->content = cont;
+    content.assign(cont);
+    updateFileSize();
+    updateModificationTime();
+    return true;
+}
+
+bool FileDescriptor::appendContent(std::string_view cont) {
+    if (!isWritable()) throw std::runtime_error("File is not writable");
+    content.append(cont);
+    updateFileSize();
+    updateModificationTime();
+    return true;
+}
+
+bool FileDescriptor::shareContent(const ContentView& cont) {
+    if (!isWritable()) throw std::runtime_error("File is not writable");
+    content.share(cont);
     updateFileSize();
     updateModificationTime();
     return true;
 }
 
 bool FileDescriptor::writeContentAlways(std::string_view cont) {
-    this->content = cont;
+    content.assign(cont);
     updateFileSize();
     updateModificationTime();
     return true;
@@ -25,17 +48,27 @@ bool FileDescriptor::writeContentAlways(std::string_view cont) {
 
 std::string FileDescriptor::readContent() const {
     if (!isReadable()) throw std::runtime_error("File is not readable");
-    return content;
+    touchContent();
+    return content.str();
+}
+
+ContentView FileDescriptor::viewContent() const {
+    if (!isReadable()) throw std::runtime_error("File is not readable");
+    touchContent();
+    return content.view();
 }
 
 std::string FileDescriptor::readContentAlways() const {
-    return content;
+    return content.str();
+}
+
+ContentView FileDescriptor::viewContentAlways() const {
+    return content.view();
 }
 
 bool FileDescriptor::truncateContent(int index) {
     if (!isWritable()) throw std::runtime_error("File is not writable");
-    if (index < 0 || static_cast<size_t>(index) > content.size()) return false;
-    content.resize(index);
+    if (index < 0 || !content.truncate(static_cast<size_t>(index))) return false;
     updateFileSize();
     updateModificationTime();
     return true;
@@ -52,6 +85,27 @@ int FileDescriptor::getSize() const {
     return static_cast<int>(size);
 }
 
+std::chrono::system_clock::time_point FileDescriptor::getLastAccessTime() const {
+    std::chrono::system_clock::time_point lastRead{std::chrono::system_clock::duration(lastReadTime.load(std::memory_order_relaxed))};
+    return std::max(lastRead, getLastModifyTime());
+}
+
+bool FileDescriptor::compressContent() {
+    return content.compress();
+}
+
+bool FileDescriptor::decompressContent() {
+    return content.unpack();
+}
+
+bool FileDescriptor::isContentCompressed() const {
+    return content.isCompressed();
+}
+
+size_t FileDescriptor::getStoredSize() const {
+    return content.storedSize();
+}
+
 void FileDescriptor::updateFileSize() {
     size = content.size();
 }
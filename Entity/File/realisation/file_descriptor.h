@@ -4,6 +4,10 @@
 #include "Entity/FSObject/realisation/fs_object.h"
 #include "Entity/File/interface/i_file.h"
 #include "Entity/File/interface/i_lockable.h"
+#include "file_content.h"
+#include <atomic>
+#include <chrono>
+#include <memory_resource>
 #include <string>
 
 /**
@@ -14,9 +18,16 @@
  */
 class FileDescriptor : public FileSystemObject, public IFile, public ILockable {
 private:
-    std::string content;    ///< Содержимое файла
+    FileContent content;    ///< Содержимое файла (память выделяется из ресурса репозитория)
     unsigned int size;      ///< Размер файла в байтах
     Lock mode;              ///< Режим блокировки файла
+    mutable std::atomic<std::chrono::system_clock::rep> lastReadTime; ///< Время последнего чтения содержимого
+    mutable FileLock accessLock;    ///< Блокировка доступа потоков к содержимому
+
+    /**
+     * @brief Отметить чтение содержимого: обновить время чтения
+     */
+    void touchContent() const;
 
     /**
      * @brief Обновить размер файла на основе содержимого
@@ -30,8 +41,10 @@ public:
      * @param parentAddress Адрес родительской директории
      * @param owner Владелец файла
      * @param adr Адрес файла в файловой системе
+     * @param resource Ресурс памяти для содержимого файла
      */
-    FileDescriptor(const std::string &name, unsigned int parentAddress, const User &owner, unsigned int adr);
+    FileDescriptor(const std::string &name, unsigned int parentAddress, const User &owner, unsigned int adr,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Записать содержимое в файл с проверкой блокировки
@@ -41,6 +54,25 @@ public:
      */
     bool writeContent(std::string_view cont) override;
 
+    /**
+     * @brief Дописать данные в конец файла с проверкой блокировки
+     * @param cont Данные для добавления
+     * @return true если запись успешна
+     * @throws std::runtime_error если файл не доступен для записи
+     */
+    bool appendContent(std::string_view cont) override;
+
+    /**
+     * @brief Заменить содержимое версией другого файла с проверкой блокировки
+     *
+     * Данные разделяются и копируются только при первой записи в любой из файлов.
+     *
+     * @param cont Представление содержимого
+     * @return true если запись успешна
+     * @throws std::runtime_error если файл не доступен для записи
+     */
+    bool shareContent(const ContentView& cont) override;
+
     /**
      * @brief Прочитать содержимое файла с проверкой блокировки
      * @return Содержимое файла
@@ -48,6 +80,13 @@ public:
      */
     std::string readContent() const override;
 
+    /**
+     * @brief Получить содержимое файла без копирования с проверкой блокировки
+     * @return Неизменяемое представление текущей версии содержимого
+     * @throws std::runtime_error если файл не доступен для чтения
+     */
+    ContentView viewContent() const override;
+
     /**
      * @brief Обрезать содержимое файла до указанного индекса
      * @param index Индекс до которого обрезать
@@ -86,6 +125,12 @@ public:
      */
     bool isWritable() const override { return mode == Lock::NotLock || mode == Lock::ReadLock; }
 
+    /**
+     * @brief Получить блокировку доступа к файлу
+     * @return Блокировка: разделяемый захват для чтения, исключительный - для записи
+     */
+    FileLock& getAccessLock() const override { return accessLock; }
+
     /**
      * @brief Записать содержимое в файл без проверки блокировки
      * @param cont Содержимое для записи
@@ -98,6 +143,82 @@ public:
      * @return Содержимое файла
      */
     std::string readContentAlways() const override;
+
+    /**
+     * @brief Получить содержимое файла без копирования и без проверки блокировки
+     * @return Неизменяемое представление текущей версии содержимого
+     */
+    ContentView viewContentAlways() const override;
+
+    /**
+     * @brief Получить время последнего обращения к содержимому
+     * @return Наибольшее из времени последнего чтения и последнего изменения
+     */
+    std::chrono::system_clock::time_point getLastAccessTime() const override;
+
+    /**
+     * @brief Сжать содержимое файла в памяти
+     * @return true если содержимое сжато
+     */
+    bool compressContent() override;
+
+    /**
+     * @brief Распаковать сжатое содержимое на месте
+     *
+     * Меняет хранение, поэтому вызывается под исключительным захватом accessLock
+     * (см. FileSystemService::viewContentLocked).
+     *
+     * @return true если содержимое было сжато
+     */
+    bool decompressContent() override;
+
+    /**
+     * @brief Проверить, хранится ли содержимое сжатым
+     * @return true если содержимое сжато
+     */
+    bool isContentCompressed() const override;
+
+    /**
+     * @brief Получить объём памяти, занимаемый данными содержимого
+     * @return Размер хранимых (при сжатии - сжатых) данных в байтах
+     */
+    size_t getStoredSize() const override;
+
+    /**
+     * @brief Получить объект как файл
+     * @return Этот файл
+     */
+    IFile* asFile() noexcept override { return this; }
+
+    /**
+     * @brief Получить объект как файл
+     * @return Этот файл
+     */
+    const IFile* asFile() const noexcept override { return this; }
+
+    /**
+     * @brief Получить интерфейс блокировки файла
+     * @return Этот файл
+     */
+    ILockable* asLockable() noexcept override { return this; }
+
+    /**
+     * @brief Получить интерфейс блокировки файла
+     * @return Этот файл
+     */
+    const ILockable* asLockable() const noexcept override { return this; }
+
+    /**
+     * @brief Получить файл как объект файловой системы
+     * @return Этот файл
+     */
+    IFileSystemObject* asObject() noexcept override { return this; }
+
+    /**
+     * @brief Получить файл как объект файловой системы
+     * @return Этот файл
+     */
+    const IFileSystemObject* asObject() const noexcept override { return this; }
 };
 
 #endif
\ No newline at end of file
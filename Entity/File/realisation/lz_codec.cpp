@@ -0,0 +1,106 @@
+#include "lz_codec.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    constexpr unsigned HASH_BITS = 13;  ///< Размер хеш-таблицы - 2^HASH_BITS позиций
+
+    uint32_t load32(const char* p) noexcept {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint32_t hashSequence(uint32_t sequence) noexcept {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    char* writeLength(char* out, size_t length) noexcept {
+        while (length >= 255) {
+            *out++ = static_cast<char>(255);
+            length -= 255;
+        }
+        *out++ = static_cast<char>(length);
+        return out;
+    }
+
+    bool readLength(const unsigned char*& in, const unsigned char* end, size_t& length) noexcept {
+        unsigned char byte;
+        do {
+            if (in == end) return false;
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    char* writeSequence(char* out, std::string_view literals, size_t offset, size_t matchLength) noexcept {
+        size_t matchCode = matchLength ? matchLength - LZCodec::MIN_MATCH : 0;
+        char* token = out++;
+        *token = static_cast<char>((std::min<size_t>(literals.size(), 15) << 4) | std::min<size_t>(matchCode, 15));
+        if (literals.size() >= 15) out = writeLength(out, literals.size() - 15);
+        std::memcpy(out, literals.data(), literals.size());
+        out += literals.size();
+        if (matchLength == 0) return out;
+        *out++ = static_cast<char>(offset & 0xFF);
+        *out++ = static_cast<char>(offset >> 8);
+        if (matchCode >= 15) out = writeLength(out, matchCode - 15);
+        return out;
+    }
+}
+
+size_t LZCodec::compress(std::string_view input, char* output) noexcept {
+    std::array<uint32_t, size_t{1} << HASH_BITS> table{};
+    const char* in = input.data();
+    size_t size = input.size();
+    char* out = output;
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + MIN_MATCH <= size) {
+        uint32_t sequence = load32(in + i);
+        uint32_t& slot = table[hashSequence(sequence)];
+        size_t candidate = slot;
+        slot = static_cast<uint32_t>(i + 1);
+        if (candidate == 0 || i - (candidate - 1) > MAX_OFFSET || load32(in + candidate - 1) != sequence) {
+            i++;
+            continue;
+        }
+        size_t match = candidate - 1;
+        size_t length = MIN_MATCH;
+        while (i + length < size && in[match + length] == in[i + length]) length++;
+        out = writeSequence(out, input.substr(anchor, i - anchor), i - match, length);
+        i += length;
+        anchor = i;
+    }
+    out = writeSequence(out, input.substr(anchor), 0, 0);
+    return static_cast<size_t>(out - output);
+}
+
+bool LZCodec::decompress(std::string_view input, char* output, size_t outputSize) noexcept {
+    const auto* in = reinterpret_cast<const unsigned char*>(input.data());
+    const unsigned char* end = in + input.size();
+    size_t written = 0;
+    while (in < end) {
+        unsigned char token = *in++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(in, end, literals)) return false;
+        if (literals > static_cast<size_t>(end - in) || literals > outputSize - written) return false;
+        std::memcpy(output + written, in, literals);
+        in += literals;
+        written += literals;
+        if (in == end) break;
+        if (end - in < 2) return false;
+        size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        size_t length = token & 0x0F;
+        if (length == 15 && !readLength(in, end, length)) return false;
+        length += MIN_MATCH;
+        if (offset == 0 || offset > written || length > outputSize - written) return false;
+        if (offset >= length) std::memcpy(output + written, output + written - offset, length);
+        else for (size_t k = 0; k < length; k++) output[written + k] = output[written + k - offset];
+        written += length;
+    }
+    return written == outputSize;
+}
\ No newline at end of file
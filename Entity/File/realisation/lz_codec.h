@@ -0,0 +1,46 @@
+#ifndef LAB3_LZ_CODEC_H
+#define LAB3_LZ_CODEC_H
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief Быстрый кодек семейства LZ77 для сжатия содержимого файлов.
+ *
+ * Формат повторяет блок LZ4: последовательность состоит из байта-токена (старшие
+ * 4 бита - длина литералов, младшие - длина совпадения минус MIN_MATCH; значение 15
+ * продолжается байтами по 255), литералов, 2-байтового смещения (little-endian) и
+ * продолжения длины совпадения. Последняя последовательность содержит только литералы.
+ * Совпадения ищутся жадно по хеш-таблице 4-байтовых префиксов, окно - 64 КиБ.
+ */
+class LZCodec {
+public:
+    static constexpr size_t MIN_MATCH = 4;          ///< Минимальная длина совпадения
+    static constexpr size_t MAX_OFFSET = 65535;     ///< Максимальное смещение совпадения
+
+    /**
+     * @brief Получить размер буфера, достаточный для сжатия данных любого вида.
+     * @param size Размер исходных данных
+     * @return Размер буфера
+     */
+    static constexpr size_t maxCompressedSize(size_t size) noexcept { return size + size / 255 + 16; }
+
+    /**
+     * @brief Сжать данные.
+     * @param input Исходные данные
+     * @param output Буфер размером не меньше maxCompressedSize(input.size())
+     * @return Размер сжатых данных
+     */
+    static size_t compress(std::string_view input, char* output) noexcept;
+
+    /**
+     * @brief Распаковать данные.
+     * @param input Сжатые данные
+     * @param output Буфер для результата
+     * @param outputSize Точный размер исходных данных
+     * @return true если данные корректны и распакованы ровно в outputSize байт
+     */
+    static bool decompress(std::string_view input, char* output, size_t outputSize) noexcept;
+};
+
+#endif
\ No newline at end of file
@@ -7,8 +7,7 @@ DTO::FileSystemObjectDTO DirectoryMapper::mapTo(const DirectoryDescriptor& dir)
     dto.address = dir.getAddress();
     dto.name = dir.getName();
     dto.parentAddress = dir.getParentDirectoryAddress();
-    dto.ownerName = dir.getOwner().getName();
-    dto.ownerId = dir.getOwner().getId();
+    dto.ownerId = dir.getOwnerId();
     dto.creationTime = dir.getCreateTime();
     dto.lastModifyTime = dir.getLastModifyTime();
     auto children = dir.listChild();
@@ -20,6 +19,8 @@ DTO::FileSystemObjectDTO DirectoryMapper::mapTo(const DirectoryDescriptor& dir)
     dto.properties["children"] = childrenStr;
     std::vector<ACLEntry> aclEntries = dir.getACL();
     if (!aclEntries.empty()) dto.properties["acl"] = ACLSerializer::serialize(aclEntries);
+    const ACL& inheritable = dir.getInheritableACL();
+    if (!inheritable.empty()) dto.properties["inherit"] = ACLSerializer::serialize(inheritable.getEntries());
     return dto;
 }
 
@@ -31,11 +32,20 @@ std::unique_ptr<DirectoryDescriptor> DirectoryMapper::mapFrom(const DTO::FileSys
         tempOwner,
         dto.address
     );
+    fill(dto, *dir);
+    return dir;
+}
+
+void DirectoryMapper::fill(const DTO::FileSystemObjectDTO& dto, DirectoryDescriptor& dir) const {
     if (dto.properties.count("acl")) {
         std::vector<ACLEntry> aclEntries = ACLSerializer::deserialize(dto.properties.at("acl"));
-        dir->setACL(aclEntries);
+        dir.setACL(aclEntries);
     }
-    dir->setCreateTime(dto.creationTime);
-    dir->setLastModifyTime(dto.lastModifyTime);
-    return dir;
+    if (dto.properties.count("inherit")) {
+        ACL inheritable(0);
+        inheritable.setEntries(ACLSerializer::deserialize(dto.properties.at("inherit")));
+        dir.setInheritableACL(inheritable);
+    }
+    dir.setCreateTime(dto.creationTime);
+    dir.setLastModifyTime(dto.lastModifyTime);
 }
\ No newline at end of file
@@ -43,6 +43,16 @@ public:
      * @return Уникальный указатель на созданный объект DirectoryDescriptor
      */
     [[nodiscard]] std::unique_ptr<DirectoryDescriptor> mapFrom(const DTO::FileSystemObjectDTO& dto) const override;
+
+    /**
+     * @brief Заполнить уже созданный объект данными DTO (кроме имени, родителя, владельца и адреса)
+     *
+     * Позволяет восстановить объект, выделенный не маппером, а, например, пулом репозитория.
+     *
+     * @param dto DTO файловой системы
+     * @param dir Заполняемый объект
+     */
+    void fill(const DTO::FileSystemObjectDTO& dto, DirectoryDescriptor& dir) const;
 };
 
 #endif
\ No newline at end of file
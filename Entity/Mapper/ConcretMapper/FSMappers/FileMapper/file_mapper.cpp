@@ -1,5 +1,6 @@
 #include "file_mapper.h"
 #include "Entity/Mapper/ConcretMapper/FSMappers/ACLSerializer/acl_serializer.h"
+#include "Entity/File/realisation/content_store.h"
 
 DTO::FileSystemObjectDTO FileMapper::mapTo(const FileDescriptor& file) const {
     DTO::FileSystemObjectDTO dto;
@@ -7,11 +8,12 @@ DTO::FileSystemObjectDTO FileMapper::mapTo(const FileDescriptor& file) const {
     dto.address = file.getAddress();
     dto.name = file.getName();
     dto.parentAddress = file.getParentDirectoryAddress();
-    dto.ownerName = file.getOwner().getName();
-    dto.ownerId = file.getOwner().getId();
+    dto.ownerId = file.getOwnerId();
     dto.creationTime = file.getCreateTime();
     dto.lastModifyTime = file.getLastModifyTime();
-    dto.properties["content"] = file.readContent();
+    ContentStore::BlobId blob = 0;
+    ContentStore::instance().intern(file.viewContentAlways(), &blob);
+    if (blob) dto.properties["blob"] = ContentStore::formatId(blob);
     dto.properties["size"] = std::to_string(file.getSize());
     Lock mode = file.isReadable() && file.isWritable() ? Lock::NotLock :
                file.isReadable() ? Lock::WriteLock :
@@ -30,13 +32,21 @@ std::unique_ptr<FileDescriptor> FileMapper::mapFrom(const DTO::FileSystemObjectD
         tempOwner,
         dto.address
     );
-    if (dto.properties.count("content")) file->writeContent(dto.properties.at("content"));
-    if (dto.properties.count("mode")) file->setMode(static_cast<Lock>(std::stoi(dto.properties.at("mode"))));
+    fill(dto, *file);
+    return file;
+}
+
+void FileMapper::fill(const DTO::FileSystemObjectDTO& dto, FileDescriptor& file) const {
+    if (dto.properties.count("blob")) {
+        file.shareContent(ContentStore::instance().find(ContentStore::parseId(dto.properties.at("blob"))));
+    } else if (dto.properties.count("content")) {
+        file.writeContent(dto.properties.at("content"));
+    }
+    if (dto.properties.count("mode")) file.setMode(static_cast<Lock>(std::stoi(dto.properties.at("mode"))));
     if (dto.properties.count("acl")) {
         std::vector<ACLEntry> aclEntries = ACLSerializer::deserialize(dto.properties.at("acl"));
-        file->setACL(aclEntries);
+        file.setACL(aclEntries);
     }
-    file->setCreateTime(dto.creationTime);
-    file->setLastModifyTime(dto.lastModifyTime);
-    return file;
+    file.setCreateTime(dto.creationTime);
+    file.setLastModifyTime(dto.lastModifyTime);
 }
\ No newline at end of file
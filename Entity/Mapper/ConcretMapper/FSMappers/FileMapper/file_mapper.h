@@ -12,6 +12,8 @@
  *
  * Преобразует объекты в DTO и обратно, включая
  * содержимое файлов, информацию о блокировках и списки контроля доступа.
+ * Содержимое передаётся ссылкой на блоб ContentStore (свойство "blob");
+ * свойство "content" с самим содержимым поддерживается при чтении.
  */
 class FileMapper final : public ConcreteFSObjectMapper<FileDescriptor> {
 public:
@@ -44,6 +46,16 @@ public:
      * @return Уникальный указатель на созданный объект FileDescriptor
      */
     [[nodiscard]] std::unique_ptr<FileDescriptor> mapFrom(const DTO::FileSystemObjectDTO& dto) const override;
+
+    /**
+     * @brief Заполнить уже созданный объект данными DTO (кроме имени, родителя, владельца и адреса)
+     *
+     * Позволяет восстановить объект, выделенный не маппером, а, например, пулом репозитория.
+     *
+     * @param dto DTO файловой системы
+     * @param file Заполняемый объект
+     */
+    void fill(const DTO::FileSystemObjectDTO& dto, FileDescriptor& file) const;
 };
 
 #endif
\ No newline at end of file
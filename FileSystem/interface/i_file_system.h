@@ -75,9 +75,10 @@ public:
      * @brief Записать содержимое в файл
      * @param path Путь к файлу
      * @param content Содержимое для записи
+     * @param append Дописать содержимое в конец файла вместо замены
      * @return Результат операции с сообщением об ошибке или успехе
      */
-    virtual FileSystemResult writeFile(const std::string& path, const std::string& content) = 0;
+    virtual FileSystemResult writeFile(const std::string& path, const std::string& content, bool append = false) = 0;
 
     /**
      * @brief Удалить файл
@@ -142,9 +143,10 @@ public:
      * @param path Путь к объекту
      * @param perms Карта новых прав доступа
      * @param forAll Применить для всех пользователей
+     * @param scope Область действия: объект, поддерево или наследуемые записи директории
      * @return Результат операции с сообщением об ошибке или успехе
      */
-    virtual FileSystemResult changePermissions(const std::string& path, const std::map<PermissionType, PermissionEffect>& perms, bool forAll) = 0;
+    virtual FileSystemResult changePermissions(const std::string& path, const std::map<PermissionType, PermissionEffect>& perms, bool forAll, PermissionScope scope) = 0;
 
     /**
      * @brief Изменить владельца объекта
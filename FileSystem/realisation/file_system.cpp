@@ -1,4 +1,5 @@
 #include "file_system.h"
+#include "Entity/FSObject/interface/object_cast.h"
 #include "../../Threads/Statistics/fs_stat.h"
 
 #include <iostream>
@@ -51,7 +52,7 @@ std::string FileSystem::getCurrentPath() const {
     auto currentDir = sessionService.getCurrentDirectory();
     if (currentDir) {
         auto& fsRepository = loader_->getFsRepository();
-        return fsRepository.getPath(dynamic_cast<IFileSystemObject*>(currentDir));
+        return fsRepository.getPath(asObject(currentDir));
     }
     return "/";
 }
@@ -69,18 +70,16 @@ FileSystemResult FileSystem::readFile(const std::string& path) {
     if (!isLoggedIn()) return FileSystemResult{false, {}, "Not logged in"};
     User* user = getCurrentUser();
     auto& fsService = loader_->getFsService();
-    std::string content = fsService.readFile(*user, path);
-    if (!content.empty() || fsService.exists(path)) {
-        return FileSystemResult{true, {content}};
-    }
+    std::optional<ContentView> content = fsService.readFile(*user, path);
+    if (content) return FileSystemResult{true, {}, "", std::move(content)};
     return FileSystemResult{false, {}, "Failed to read file"};
 }
 
-FileSystemResult FileSystem::writeFile(const std::string& path, const std::string& content) {
+FileSystemResult FileSystem::writeFile(const std::string& path, const std::string& content, bool append) {
     if (!isLoggedIn()) return FileSystemResult{false, {}, "Not logged in"};
     User* user = getCurrentUser();
     auto& fsService = loader_->getFsService();
-    if (fsService.writeFile(*user, path, content, false)) {
+    if (fsService.writeFile(*user, path, content, append)) {
         return FileSystemResult{true, {"File written: " + path}};
     }
     return FileSystemResult{false, {}, "Failed to write file"};
@@ -166,12 +165,19 @@ FileSystemResult FileSystem::changeDirectory(const std::string& path) {
     return FileSystemResult{false, {}, "Failed to change directory"};
 }
 
-FileSystemResult FileSystem::changePermissions(const std::string& path, const std::map<PermissionType, PermissionEffect>& perms, bool forAll) {
+FileSystemResult FileSystem::changePermissions(const std::string& path, const std::map<PermissionType, PermissionEffect>& perms, bool forAll, PermissionScope scope) {
     if (!isLoggedIn()) return FileSystemResult{false, {}, "Not logged in"};
     auto& fsService = loader_->getFsService();
+    auto apply = [&](unsigned int id, SubjectType s_type) {
+        switch (scope) {
+            case PermissionScope::Subtree: return fsService.changePermissionsRecursive(id, s_type, path, perms);
+            case PermissionScope::Inheritable: return fsService.changeInheritablePermissions(id, s_type, path, perms);
+            default: return fsService.changePermissions(id, s_type, path, perms);
+        }
+    };
 
     if (forAll) {
-        if (fsService.changePermissions(0, SubjectType::Group, path, perms)) {
+        if (apply(0, SubjectType::Group)) {
             std::stringstream ss;
             ss << "Permissions changed for: " << path;
             return FileSystemResult{true, {ss.str()}};
@@ -180,7 +186,7 @@ FileSystemResult FileSystem::changePermissions(const std::string& path, const st
     }
 
     User* user = getCurrentUser();
-    if (fsService.changePermissions(user->getId(), SubjectType::User, path, perms)) {
+    if (apply(user->getId(), SubjectType::User)) {
         std::stringstream ss;
         ss << "Permissions changed for: " << path;
         return FileSystemResult{true, {ss.str()}};
@@ -269,7 +275,8 @@ FileSystemResult FileSystem::getFileInfo(const std::string& path) {
     messages.push_back("File info for: " + path);
     messages.push_back("Name: " + obj->getName());
     messages.push_back("Address: " + std::to_string(obj->getAddress()));
-    messages.push_back("Owner: " + obj->getOwner().getName());
+    User* owner = loader_->getUserRepository().getUserById(obj->getOwnerId());
+    messages.push_back("Owner: " + (owner ? owner->getName() : "uid " + std::to_string(obj->getOwnerId())));
     auto createTime = obj->getCreateTime();
     auto modifyTime = obj->getLastModifyTime();
     std::time_t createTimeT = std::chrono::system_clock::to_time_t(createTime);
@@ -281,12 +288,15 @@ FileSystemResult FileSystem::getFileInfo(const std::string& path) {
     ssModify << std::put_time(&modifyTm, "%Y-%m-%d %H:%M:%S");
     messages.push_back("Created: " + ssCreate.str());
     messages.push_back("Modified: " + ssModify.str());
-    if (auto file = dynamic_cast<IFile*>(obj)) {
-        messages.push_back("Type: File");
-        messages.push_back("Size: " + std::to_string(file->getSize()) + " bytes");
-    } else if (auto dir = dynamic_cast<IDirectory*>(obj)) {
-        messages.push_back("Type: Directory");
-        messages.push_back("Items: " + std::to_string(dir->getChildCount()));
+    switch (obj->getType()) {
+        case ObjectType::File:
+            messages.push_back("Type: File");
+            messages.push_back("Size: " + std::to_string(obj->asFile()->getSize()) + " bytes");
+            break;
+        case ObjectType::Directory:
+            messages.push_back("Type: Directory");
+            messages.push_back("Items: " + std::to_string(obj->asDirectory()->getChildCount()));
+            break;
     }
     auto& securityService = loader_->getSecurityService();
     auto perms = securityService.getEffectivePermissions(*user, *obj);
@@ -334,9 +344,9 @@ FileSystemResult FileSystem::getStatistics(int threadCount, bool ignorePermissio
         userGroups = currentUser->getGroups();
     }
     try {
-        auto metrics = MetricFactory::createDefaultSet();
+        auto metrics = MetricFactory::createDefaultSet(&loader_->getUserRepository());
         auto& repository = getRepository();
-        auto* rootDirectory = dynamic_cast<IDirectory*>(repository.getRootDirectory());
+        auto* rootDirectory = repository.getRootDirectory();
         if (!rootDirectory) return FileSystemResult{false, {}, "Root directory not found"};
         FileSystemScanner scanner(
             threadCount > 0 ? threadCount : 1, repository, loader_->getFsObjectMapper(),
@@ -391,10 +401,10 @@ CommandResult FileSystem::createRandomElements(int count) {
     for (int i = size; i < count + size; i++) {
         std::uniform_int_distribution<> dirDist(0, directoryAddresses.size() - 1);
         unsigned int parentAddress = directoryAddresses[dirDist(gen)];
-        IDirectory* parentDir = dynamic_cast<IDirectory*>(loader_->getFsRepository().getObjectByAddress(parentAddress));
+        IDirectory* parentDir = asDirectory(loader_->getFsRepository().getObjectByAddress(parentAddress));
         if (!parentDir) continue;
         std::string name = std::to_string(i);
-        std::string parentPath = loader_->getFsRepository().getPath(dynamic_cast<IFileSystemObject*>(parentDir));
+        std::string parentPath = loader_->getFsRepository().getPath(asObject(parentDir));
         int type = typeDist(gen);
         if (type < 8) {
             std::uniform_int_distribution<> contentDist(1, 100);
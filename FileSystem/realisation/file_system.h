@@ -85,9 +85,10 @@ public:
      * @brief Записать содержимое в файл
      * @param path Путь к файлу
      * @param content Содержимое для записи
+     * @param append Дописать содержимое в конец файла вместо замены
      * @return Результат операции с сообщением об ошибке или успехе
      */
-    FileSystemResult writeFile(const std::string& path, const std::string& content) override;
+    FileSystemResult writeFile(const std::string& path, const std::string& content, bool append = false) override;
 
     /**
      * @brief Удалить файл
@@ -152,9 +153,10 @@ public:
      * @param path Путь к объекту
      * @param perms Карта новых прав доступа
      * @param forAll Применить для всех пользователей
+     * @param scope Область действия: объект, поддерево или наследуемые записи директории
      * @return Результат операции с сообщением об ошибке или успехе
      */
-    FileSystemResult changePermissions(const std::string& path, const std::map<PermissionType, PermissionEffect>& perms, bool forAll) override;
+    FileSystemResult changePermissions(const std::string& path, const std::map<PermissionType, PermissionEffect>& perms, bool forAll, PermissionScope scope) override;
 
     /**
      * @brief Изменить владельца объекта
@@ -22,6 +22,7 @@
 #include "../../Service/FSService/realisation/fs_service.h"
 #include "../../Service/UserManagementService/realisation/user_management_service.h"
 #include "Service/SessionService/realisation/session_service.h"
+#include "Service/CompressionService/realisation/compression_service.h"
 
 /**
  * @brief Интерфейс загрузчика зависимостей.
@@ -128,6 +129,12 @@ public:
      * @return Ссылка на сервис сессий
      */
     virtual ISessionService& getSessionService() = 0;
+
+    /**
+     * @brief Получить сервис сжатия содержимого файлов
+     * @return Ссылка на сервис сжатия
+     */
+    virtual ICompressionService& getCompressionService() = 0;
 };
 
 #endif
\ No newline at end of file
@@ -80,7 +80,7 @@ IStateService& FSLoader::getCommandStateService() {
 }
 
 ISecurityService& FSLoader::getSecurityService() {
-    if (!securityService_) securityService_ = std::make_unique<SecurityService>(getUserRepository(),getGroupRepository());
+    if (!securityService_) securityService_ = std::make_unique<SecurityService>(getUserRepository(),getGroupRepository(),&getFsRepository());
     return *securityService_;
 }
 
@@ -97,4 +97,9 @@ IUserManagementService& FSLoader::getUserManagementService() {
 ISessionService& FSLoader::getSessionService() {
     if (!sessionService_) sessionService_ = std::make_unique<SessionService>(getSecurityService(),getFsRepository());
     return *sessionService_;
+}
+
+ICompressionService& FSLoader::getCompressionService() {
+    if (!compressionService_) compressionService_ = std::make_unique<CompressionService>(getFsRepository());
+    return *compressionService_;
 }
\ No newline at end of file
@@ -37,6 +37,8 @@ private:
 
     std::unique_ptr<IView> view_;                                                                    ///< Представление
 
+    std::unique_ptr<ICompressionService> compressionService_;                                        ///< Сервис сжатия (уничтожается первым, до репозитория)
+
 public:
     /**
      * @brief Получить представление (View)
@@ -133,6 +135,12 @@ public:
      * @return Ссылка на сервис сессий
      */
     ISessionService& getSessionService() override;
+
+    /**
+     * @brief Получить сервис сжатия содержимого файлов
+     * @return Ссылка на сервис сжатия
+     */
+    ICompressionService& getCompressionService() override;
 };
 
 #endif
\ No newline at end of file
@@ -4,10 +4,47 @@
 #include "../../../Entity/FSObject/interface/i_fs_object.h"
 #include "../../../Entity/Directory/interface/i_directory.h"
 #include "../../../Entity/File/interface/i_file.h"
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <string>
 
+/**
+ * @brief Удалитель объектов файловой системы.
+ *
+ * Объекты, созданные репозиторием, живут в его пулах и возвращаются в пул своего
+ * типа; объекты из обычного new (например, созданные мапперами) удаляются через delete.
+ */
+struct ObjectDeleter {
+    void (*destroy)(void* pool, IFileSystemObject* object) = nullptr;   ///< Возврат в пул (nullptr - delete)
+    void* pool = nullptr;                                               ///< Пул объекта
+
+    ObjectDeleter() noexcept = default;
+
+    /**
+     * @brief Конструктор удалителя для объекта из пула.
+     * @param destroy Функция возврата объекта в пул
+     * @param pool Пул объекта
+     */
+    ObjectDeleter(void (*destroy)(void*, IFileSystemObject*), void* pool) noexcept : destroy(destroy), pool(pool) {}
+
+    /**
+     * @brief Преобразование из std::default_delete, чтобы std::unique_ptr объектов из new
+     * можно было передавать туда, где ожидается ObjectPtr.
+     */
+    template<typename T>
+    ObjectDeleter(std::default_delete<T>) noexcept {}
+
+    void operator()(IFileSystemObject* object) const noexcept {
+        if (destroy) destroy(pool, object);
+        else delete object;
+    }
+};
+
+/// Владеющий указатель на объект файловой системы (из пула репозитория или из new)
+using ObjectPtr = std::unique_ptr<IFileSystemObject, ObjectDeleter>;
+
 /**
  * @brief Интерфейс репозитория файловой системы.
  *
@@ -69,7 +106,42 @@ public:
      * @param object Уникальный указатель на объект для сохранения
      * @return true если сохранение успешно, иначе false
      */
-    virtual bool saveObject(std::unique_ptr<IFileSystemObject> object) = 0;
+    virtual bool saveObject(ObjectPtr object) = 0;
+
+    /**
+     * @brief Заранее выделить место под объекты с адресами меньше заданного
+     *
+     * После резервирования saveObject() для таких адресов не выделяет память.
+     *
+     * @param addressLimit Граница адресов
+     */
+    virtual void reserve(size_t addressLimit) = 0;
+
+    /**
+     * @brief Создать файл в пуле репозитория
+     *
+     * Объект ещё не сохранён: после настройки его нужно передать в saveObject.
+     *
+     * @param name Имя файла
+     * @param parentAddress Адрес родительской директории
+     * @param owner Владелец
+     * @param address Адрес файла
+     * @return Владеющий указатель на файл
+     */
+    virtual ObjectPtr allocateFile(const std::string& name, unsigned int parentAddress, const User& owner, unsigned int address) = 0;
+
+    /**
+     * @brief Создать директорию в пуле репозитория
+     *
+     * Объект ещё не сохранён: после настройки его нужно передать в saveObject.
+     *
+     * @param name Имя директории
+     * @param parentAddress Адрес родительской директории
+     * @param owner Владелец
+     * @param address Адрес директории
+     * @return Владеющий указатель на директорию
+     */
+    virtual ObjectPtr allocateDirectory(const std::string& name, unsigned int parentAddress, const User& owner, unsigned int address) = 0;
 
     /**
      * @brief Удалить объект из репозитория по адресу
@@ -78,6 +150,15 @@ public:
      */
     virtual bool deleteObject(unsigned int address) = 0;
 
+    /**
+     * @brief Переименовать и/или переместить объект
+     * @param address Адрес объекта
+     * @param newParentAddress Адрес новой родительской директории
+     * @param newName Новое имя
+     * @return true если объект перемещён, иначе false
+     */
+    virtual bool moveObject(unsigned int address, unsigned int newParentAddress, const std::string& newName) = 0;
+
     /**
      * @brief Проверить существование объекта по адресу
      * @param address Адрес объекта
@@ -113,10 +194,57 @@ public:
      */
     virtual std::string getPath(IFileSystemObject* object) const = 0;
 
+    /**
+     * @brief Получить поколение путей
+     *
+     * Увеличивается, когда путь уже существующей директории может измениться или стать
+     * недействительным: при перемещении и переименовании, удалении директории и очистке.
+     * Позволяет кэшировать результат getPath() для директорий.
+     *
+     * @return Поколение путей
+     */
+    virtual uint64_t getPathGeneration() const = 0;
+
     /**
      * @brief Очистить репозиторий
      */
     virtual void clear() = 0;
+
+    /**
+     * @brief Получить ресурс памяти для содержимого создаваемых объектов
+     *
+     * Ресурс используется для таблиц детей и содержимого файлов, но не для самих
+     * объектов; clear() возвращает память ресурсу поэлементно.
+     *
+     * @return Ресурс памяти репозитория
+     */
+    virtual std::pmr::memory_resource* getMemoryResource() const = 0;
+
+    /**
+     * @brief Получить наследуемые записи, действующие на дочерние объекты директории
+     *
+     * Записи директории объединяются с записями всех её предков. Результат кэшируется
+     * в директориях по цепочке и действителен до следующего invalidateInheritance().
+     *
+     * @param directory Директория
+     * @return Наследуемые записи директории и её предков
+     */
+    virtual ACL resolveInheritance(const IDirectory& directory) const = 0;
+
+    /**
+     * @brief Получить записи, унаследованные объектом от родительских директорий
+     * @param object Объект файловой системы
+     * @return Наследуемые записи родительской директории и её предков
+     */
+    virtual ACL getInheritedACL(const IFileSystemObject& object) const = 0;
+
+    /**
+     * @brief Сбросить кэши наследуемых записей после изменения наследуемого ACL
+     *
+     * Кэши не обходятся: увеличивается поколение наследования, и устаревшие кэши
+     * пересчитываются при следующей проверке прав.
+     */
+    virtual void invalidateInheritance() = 0;
 };
 
 #endif
\ No newline at end of file
@@ -1,16 +1,19 @@
 #include "fs_repository.h"
+#include "Entity/FSObject/interface/object_cast.h"
 #include "Entity/File/realisation/file_descriptor.h"
 #include "Entity/Directory/realisation/directory_descriptor.h"
-#include <sstream>
 #include <iostream>
 #include <memory>
 #include "Repository/FSRep/realisation/Path/path.h"
 
-FileSystemRepository::FileSystemRepository() : nextAddress(1), rootDirectory(nullptr) {
+FileSystemRepository::FileSystemRepository(std::pmr::memory_resource* resource)
+    : nextAddress(1), rootDirectory(nullptr), memoryResource(resource), noInheritance(0) {
     User adminUser(1, "Administrator");
-    auto rootDir = std::make_unique<DirectoryDescriptor>("/", 0, adminUser, 0);
-    rootDirectory = dynamic_cast<IDirectory*>(rootDir.get());
-    objectsByAddress[0] = std::move(rootDir);
+    auto rootDir = std::make_unique<DirectoryDescriptor>("/", 0, adminUser, 0, memoryResource);
+    rootDirectory = asDirectory(rootDir.get());
+    slots.resize(1);
+    slots[0].object = std::move(rootDir);
+    objectCount = 1;
     initializeDefaultData();
 }
 
@@ -23,14 +26,14 @@ void FileSystemRepository::findObjectsInDirectory(const std::string& pattern, ID
     auto children = directory->listChild();
     for (auto* child : children) {
         if (child && Path::matchesPattern(child->getName(), pattern)) results.push_back(child);
-        auto* childDir = dynamic_cast<IDirectory*>(child);
+        auto* childDir = asDirectory(child);
         if (childDir) findObjectsInDirectory(pattern, childDir, results);
     }
 }
 
 void FileSystemRepository::setRootDirectory(IDirectory* rootDir) {
     if (rootDir) {
-        auto* fsObject = dynamic_cast<IFileSystemObject*>(rootDir);
+        auto* fsObject = asObject(rootDir);
         if (fsObject && fsObject->getAddress() == 0) rootDirectory = rootDir;
     }
 }
@@ -41,91 +44,209 @@ IDirectory* FileSystemRepository::getRootDirectory() const {
 
 std::vector<IFileSystemObject*> FileSystemRepository::getAllObjects() const {
     std::vector<IFileSystemObject*> result;
-    result.reserve(objectsByAddress.size());
-    for (const auto& pair : objectsByAddress) {
-        if (pair.second) result.push_back(pair.second.get());
+    result.reserve(objectCount);
+    for (const Slot& slot : slots) {
+        if (slot.object) result.push_back(slot.object.get());
     }
     return result;
 }
 
 IFileSystemObject* FileSystemRepository::getObjectByAddress(unsigned int address) const {
-    auto it = objectsByAddress.find(address);
-    if (it != objectsByAddress.end() && it->second) return it->second.get();
-    return nullptr;
+    if (address >= slots.size()) return nullptr;
+    return slots[address].object.get();
 }
 
-IFileSystemObject* FileSystemRepository::getObjectByPath(const std::string& path) const {
-    if (!rootDirectory) return nullptr;
-    std::string normalizedPath = Path::normalizePath(path);
-    if (normalizedPath == "/") return dynamic_cast<IFileSystemObject*>(rootDirectory);
-    std::string withoutSlash = normalizedPath.substr(1);
+FileSystemRepository::Handle FileSystemRepository::getHandle(unsigned int address) const {
+    if (!getObjectByAddress(address)) return {};
+    return {address, slots[address].generation};
+}
+
+IFileSystemObject* FileSystemRepository::getObjectByHandle(Handle handle) const {
+    if (handle.address >= slots.size() || slots[handle.address].generation != handle.generation) return nullptr;
+    return slots[handle.address].object.get();
+}
+
+namespace {
+    /**
+     * @brief Форма записи пути
+     */
+    enum class PathForm {
+        Canonical,  ///< Абсолютный, не корень, без пустых сегментов и "."/".." (ключ кэша путей)
+        Plain,      ///< Без "." и "..", но с пустыми сегментами, относительный или корень
+        Dotted      ///< С сегментами "." или "..", требует нормализации
+    };
+
+    /**
+     * @brief Определить форму записи пути за один проход
+     * @param path Путь
+     * @return Форма пути
+     */
+    PathForm classifyPath(std::string_view path) {
+        bool canonical = path.size() > 1 && path.front() == '/';
+        size_t start = 0;
+        for (size_t i = 0; i <= path.size(); i++) {
+            if (i < path.size() && path[i] != '/') continue;
+            size_t length = i - start;
+            if (length == 0 && i != 0) canonical = false;
+            else if (length > 0 && length <= 2 && path[start] == '.' && path[i - 1] == '.') return PathForm::Dotted;
+            start = i + 1;
+        }
+        return canonical ? PathForm::Canonical : PathForm::Plain;
+    }
+}
+
+IFileSystemObject* FileSystemRepository::walkPath(std::string_view path) const {
+    auto* root = asObject(rootDirectory);
+    IFileSystemObject* current = root;
     IDirectory* currentDir = rootDirectory;
-    std::istringstream iss(withoutSlash);
-    std::string segment;
-    std::vector<std::string> segments;
-    while (std::getline(iss, segment, '/')) {
-        segments.push_back(segment);
-    }
-    for (size_t i = 0; i < segments.size(); i++) {
-        const std::string& seg = segments[i];
-        if (seg.empty() || seg == ".") continue;
-        if (seg == "..") {
-            auto* currentObj = dynamic_cast<IFileSystemObject*>(currentDir);
-            if (!currentObj) break;
-            auto* parent = getDirectoryByPath(Path::getParentPath(normalizedPath));
-            if (!parent) currentDir = rootDirectory;
-            else currentDir = parent;
+    size_t pos = 0;
+    while (pos < path.size()) {
+        size_t end = path.find('/', pos);
+        if (end == std::string_view::npos) end = path.size();
+        std::string_view segment = path.substr(pos, end - pos);
+        pos = end + 1;
+        if (segment.empty() || segment == ".") continue;
+        if (segment == "..") {
+            current = root;
+            currentDir = rootDirectory;
             continue;
         }
-        IFileSystemObject* child = currentDir->getChild(seg);
-        if (!child) return nullptr;
-        if (i == segments.size() - 1) return child;
-        auto* childDir = dynamic_cast<IDirectory*>(child);
-        if (!childDir) return nullptr;
-        currentDir = childDir;
+        if (!currentDir) return nullptr;
+        current = currentDir->getChild(segment);
+        if (!current) return nullptr;
+        currentDir = asDirectory(current);
     }
-    return dynamic_cast<IFileSystemObject*>(currentDir);
+    return current;
+}
+
+IFileSystemObject* FileSystemRepository::lookupPath(std::string_view path) const {
+    auto cached = pathCache.find(path, [this](const Handle& handle) {
+        return getObjectByHandle(handle) != nullptr;
+    });
+    if (cached) return slots[cached->address].object.get();
+    IFileSystemObject* object = walkPath(path);
+    // Кэшируются только объекты из таблицы: у них есть поколение для проверки.
+    if (object && getObjectByAddress(object->getAddress()) == object) pathCache.insert(path, getHandle(object->getAddress()));
+    return object;
+}
+
+IFileSystemObject* FileSystemRepository::getObjectByPath(const std::string& path) const {
+    if (!rootDirectory) return nullptr;
+    switch (classifyPath(path)) {
+        case PathForm::Canonical: return lookupPath(path);
+        case PathForm::Plain: return walkPath(path);
+        case PathForm::Dotted: break;
+    }
+    std::string normalized = Path::normalizePath(path);
+    return normalized.size() > 1 ? lookupPath(normalized) : walkPath(normalized);
 }
 
 IDirectory* FileSystemRepository::getDirectoryByPath(const std::string& path) const {
     auto* obj = getObjectByPath(path);
     if (!obj) return nullptr;
-    return dynamic_cast<IDirectory*>(obj);
+    return asDirectory(obj);
 }
 
 IFile* FileSystemRepository::getFileByPath(const std::string& path) const {
     auto* obj = getObjectByPath(path);
     if (!obj) return nullptr;
-    return dynamic_cast<IFile*>(obj);
+    return asFile(obj);
 }
 
-bool FileSystemRepository::saveObject(std::unique_ptr<IFileSystemObject> object) {
+bool FileSystemRepository::saveObject(ObjectPtr object) {
     if (!object) return false;
     unsigned int address = object->getAddress();
-    objectsByAddress[address] = std::move(object);
+    auto* directory = asDirectory(object.get());
+    if (address >= slots.size()) slots.resize(static_cast<size_t>(address) + 1);
+    Slot& slot = slots[address];
+    // Новая директория без наследуемых записей не меняет права уже существующих объектов.
+    if (slot.object || (directory && !directory->getInheritableACL().empty())) invalidateInheritance();
+    if (slot.object) slot.generation++;
+    else objectCount++;
+    slot.object = std::move(object);
     if (address >= nextAddress) nextAddress = address + 1;
     return true;
 }
 
+void FileSystemRepository::reserve(size_t addressLimit) {
+    slots.reserve(addressLimit);
+}
+
+ObjectPtr FileSystemRepository::allocateFile(const std::string& name, unsigned int parentAddress, const User& owner, unsigned int address) {
+    FileDescriptor* file = filePool.create(name, parentAddress, owner, address, memoryResource);
+    return ObjectPtr(file, ObjectDeleter(&destroyPooled<FileDescriptor>, &filePool));
+}
+
+ObjectPtr FileSystemRepository::allocateDirectory(const std::string& name, unsigned int parentAddress, const User& owner, unsigned int address) {
+    DirectoryDescriptor* dir = directoryPool.create(name, parentAddress, owner, address, memoryResource);
+    return ObjectPtr(dir, ObjectDeleter(&destroyPooled<DirectoryDescriptor>, &directoryPool));
+}
+
 bool FileSystemRepository::deleteObject(unsigned int address) {
     if (address == 0) return false;
-    auto it = objectsByAddress.find(address);
-    if (it == objectsByAddress.end()) return false;
-    auto* obj = it->second.get();
-    if (obj) {
-        unsigned int parentAddress = obj->getParentDirectoryAddress();
-        auto parentIt = objectsByAddress.find(parentAddress);
-        if (parentIt != objectsByAddress.end()) {
-            auto* parentDir = dynamic_cast<IDirectory*>(parentIt->second.get());
-            if (parentDir) parentDir->removeChild(obj->getName());
-        }
+    auto* obj = getObjectByAddress(address);
+    if (!obj) return false;
+    auto* parentDir = asDirectory(getObjectByAddress(obj->getParentDirectoryAddress()));
+    if (parentDir) parentDir->removeChild(obj->getName());
+    releaseSlot(address);
+    return true;
+}
+
+bool FileSystemRepository::moveObject(unsigned int address, unsigned int newParentAddress, const std::string& newName) {
+    if (address == 0) return false;
+    auto* object = getObjectByAddress(address);
+    auto* newParent = asDirectory(getObjectByAddress(newParentAddress));
+    if (!object || !newParent) return false;
+    for (auto* ancestor = asObject(newParent); ancestor->getAddress() != 0;) {
+        if (ancestor->getAddress() == address) return false;
+        ancestor = getObjectByAddress(ancestor->getParentDirectoryAddress());
+        if (!ancestor) break;
+    }
+    std::string oldName = object->getName();
+    unsigned int oldParentAddress = object->getParentDirectoryAddress();
+    if (oldParentAddress == newParentAddress && oldName == newName) return true;
+    if (newParent->containChild(newName)) return false;
+
+    std::string oldPath = getPath(object);
+    auto* oldParent = asDirectory(getObjectByAddress(oldParentAddress));
+    // Ключ директории ссылается на имя объекта, поэтому имя меняется только вне директорий.
+    if (oldParent) oldParent->removeChild(oldName);
+    if (!object->setName(newName)) {
+        if (oldParent) oldParent->addChild(object);
+        return false;
     }
-    objectsByAddress.erase(it);
+    object->setParentDirectoryAddress(newParentAddress);
+    if (!newParent->addChild(object)) {
+        object->setName(oldName);
+        object->setParentDirectoryAddress(oldParentAddress);
+        if (oldParent) oldParent->addChild(object);
+        return false;
+    }
+    pathCache.invalidate(oldPath);
+    pathGeneration.fetch_add(1, std::memory_order_release);
+    invalidateInheritance();
     return true;
 }
 
+void FileSystemRepository::releaseSlot(unsigned int address) {
+    Slot& slot = slots[address];
+    std::vector<IFileSystemObject*> children;
+    if (auto* directory = asDirectory(slot.object.get())) {
+        children = directory->listChild();
+        pathGeneration.fetch_add(1, std::memory_order_release);
+    }
+    slot.object.reset();
+    slot.generation++;
+    objectCount--;
+    freeAddresses.push_back(address);
+    for (auto* child : children) {
+        unsigned int childAddress = child->getAddress();
+        if (childAddress != 0 && childAddress < slots.size() && slots[childAddress].object.get() == child) releaseSlot(childAddress);
+    }
+}
+
 bool FileSystemRepository::objectExists(unsigned int address) const {
-    return objectsByAddress.find(address) != objectsByAddress.end();
+    return getObjectByAddress(address) != nullptr;
 }
 
 bool FileSystemRepository::pathExists(const std::string& path) const {
@@ -144,6 +265,12 @@ std::vector<IFileSystemObject*> FileSystemRepository::findObjects(
 }
 
 unsigned int FileSystemRepository::getAddress() {
+    while (!freeAddresses.empty()) {
+        unsigned int address = freeAddresses.back();
+        freeAddresses.pop_back();
+        // Адрес мог быть занят явным saveObject() после удаления.
+        if (!slots[address].object) return address;
+    }
     return nextAddress++;
 }
 
@@ -161,7 +288,7 @@ void FileSystemRepository::buildPathRecursive(IFileSystemObject* object, std::ve
 
 std::string FileSystemRepository::getPath(IFileSystemObject* object) const {
     if (!object) return "";
-    if (object == dynamic_cast<IFileSystemObject*>(rootDirectory)) return "/";
+    if (object == asObject(rootDirectory)) return "/";
     std::vector<std::string> parts;
     buildPathRecursive(object, parts);
     std::string path = "/";
@@ -172,13 +299,61 @@ std::string FileSystemRepository::getPath(IFileSystemObject* object) const {
     return path;
 }
 
-    void FileSystemRepository::clear() {
-    auto rootIt = objectsByAddress.find(0);
-    if (rootIt != objectsByAddress.end()) {
-        auto rootDir = std::move(rootIt->second);
-        objectsByAddress.clear();
-        objectsByAddress[0] = std::move(rootDir);
-        rootDirectory = dynamic_cast<IDirectory*>(objectsByAddress[0].get());
+void FileSystemRepository::clear() {
+    if (rootDirectory) {
+        for (auto* child : rootDirectory->listChild()) rootDirectory->removeChild(child->getName());
+    }
+    // Слоты остаются в таблице: адреса снова выдаются с 1, а поколения продолжают расти.
+    for (size_t address = 1; address < slots.size(); address++) {
+        Slot& slot = slots[address];
+        if (!slot.object) continue;
+        slot.object.reset();
+        slot.generation++;
     }
+    objectCount = 1;
+    freeAddresses.clear();
+    pathCache.clear();
+    pathGeneration.fetch_add(1, std::memory_order_release);
+    filePool.release();
+    directoryPool.release();
     nextAddress = 1;
+    invalidateInheritance();
+}
+
+ACL FileSystemRepository::resolveInheritance(const IDirectory& directory) const {
+    uint64_t generation = inheritanceGeneration.load(std::memory_order_acquire);
+    std::shared_ptr<const IDirectory::InheritedACL> inherited;
+    std::vector<const IDirectory*> chain;
+    const IDirectory* current = &directory;
+    while (current) {
+        auto cache = current->getInheritanceCache();
+        if (cache && cache->generation == generation) {
+            inherited = std::move(cache);
+            break;
+        }
+        chain.push_back(current);
+        auto* object = asObject(current);
+        if (!object || object->getAddress() == 0 || object->getParentDirectoryAddress() == object->getAddress()) break;
+        current = asDirectory(getObjectByAddress(object->getParentDirectoryAddress()));
+    }
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        const ACL& own = (*it)->getInheritableACL();
+        if (!inherited || !own.empty()) {
+            ACL merged = inherited ? inherited->acl.mergedWith(own) : noInheritance.mergedWith(own);
+            inherited = std::make_shared<const IDirectory::InheritedACL>(IDirectory::InheritedACL{generation, std::move(merged)});
+        }
+        (*it)->setInheritanceCache(inherited);
+    }
+    return inherited ? inherited->acl : noInheritance;
+}
+
+ACL FileSystemRepository::getInheritedACL(const IFileSystemObject& object) const {
+    if (object.getAddress() == 0) return noInheritance;
+    auto* parent = asDirectory(getObjectByAddress(object.getParentDirectoryAddress()));
+    if (!parent) return noInheritance;
+    return resolveInheritance(*parent);
+}
+
+void FileSystemRepository::invalidateInheritance() {
+    inheritanceGeneration.fetch_add(1, std::memory_order_acq_rel);
 }
\ No newline at end of file
@@ -4,27 +4,116 @@
 #include "../interface/i_fs_repository.h"
 #include "../../../Entity/Directory/realisation/directory_descriptor.h"
 #include "../../../Entity/File/realisation/file_descriptor.h"
-#include <map>
+#include "Table/object_pool.h"
+#include "path_cache.h"
+#include <atomic>
+#include <cstdint>
+#include <string_view>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <vector>
 
 /**
  * @brief Репозиторий файловой системы.
  *
  * Реализует интерфейс IFileSystemRepository для управления объектами
  * файловой системы с использованием адресов и путей.
+ *
+ * Файлы и директории, созданные через allocateFile/allocateDirectory, размещаются
+ * в пулах репозитория (слабы по типам со списками свободных слотов). clear()
+ * возвращает слабы целиком.
+ *
+ * Ресурс памяти репозитория получают только таблицы детей и содержимое файлов объектов,
+ * созданных через allocateFile/allocateDirectory. Сами дескрипторы, имена, тела ACL и
+ * объекты, восстановленные мапперами при загрузке, выделяются обычным образом, а clear()
+ * уничтожает объекты по одному и возвращает их память ресурсу. Поэтому ресурс не дает
+ * сбросить состояние за O(1): для долгоживущего репозитория подходит пул
+ * (std::pmr::unsynchronized_pool_resource), а монотонная арена - только для экземпляра,
+ * который не очищается и не перезагружается.
+ *
+ * Объекты хранятся в плотной таблице слотов, индексированной адресом: адреса выдаются
+ * подряд, поэтому поиск по адресу - обращение к элементу вектора. Адреса удалённых
+ * объектов попадают в список свободных и выдаются getAddress() повторно; поколение
+ * слота растёт при каждом удалении или замене объекта, так что Handle со старым
+ * поколением после повторного использования адреса не разрешается.
+ *
+ * Разрешённые нормализованные пути запоминаются в кэше путей как Handle. Удаление,
+ * замена объекта и clear() делают записи недействительными через поколение слота;
+ * moveObject() (им выполняются mv файлов и директорий) удаляет записи старого пути
+ * и всех путей под ним.
  */
 class FileSystemRepository : public IFileSystemRepository {
+public:
+    /**
+     * @brief Ссылка на объект с поколением слота.
+     */
+    struct Handle {
+        unsigned int address = 0;       ///< Адрес объекта
+        uint32_t generation = 0;        ///< Поколение слота на момент получения ссылки
+    };
+
 private:
-    std::map<unsigned int, std::unique_ptr<IFileSystemObject>> objectsByAddress;  ///< Карта объектов по адресам
+    /**
+     * @brief Слот таблицы объектов.
+     */
+    struct Slot {
+        ObjectPtr object;               ///< Объект (пусто, если адрес свободен)
+        uint32_t generation = 0;        ///< Поколение слота
+    };
+
+    ObjectPool<FileDescriptor> filePool;                                          ///< Пул файлов (объявлен раньше таблицы, чтобы пережить её)
+    ObjectPool<DirectoryDescriptor> directoryPool;                                ///< Пул директорий
+    std::vector<Slot> slots;                                                      ///< Таблица объектов по адресам
+    std::vector<unsigned int> freeAddresses;                                      ///< Адреса удалённых объектов для повторной выдачи
+    size_t objectCount = 0;                                                       ///< Количество объектов в таблице
     IDirectory* rootDirectory;                                                    ///< Указатель на корневую директорию
-    unsigned int nextAddress;                                                     ///< Следующий доступный адрес
+    unsigned int nextAddress;                                                     ///< Следующий ещё не выданный адрес
+    std::pmr::memory_resource* memoryResource;                                    ///< Ресурс памяти для таблиц и содержимого объектов
+    std::atomic<uint64_t> inheritanceGeneration{1};                               ///< Поколение наследуемых записей
+    std::atomic<uint64_t> pathGeneration{0};                                      ///< Поколение путей директорий
+    ACL noInheritance;                                                            ///< Пустой список наследуемых записей
+    mutable PathCache<Handle> pathCache;                                          ///< Кэш разрешённых путей
 
     /**
      * @brief Инициализировать репозиторий данными по умолчанию
      */
     void initializeDefaultData();
 
+    /**
+     * @brief Освободить слот объекта и слоты его потомков
+     *
+     * Потомки удалённой директории недостижимы по путям; их адреса освобождаются,
+     * чтобы при повторной выдаче адреса они не оказались детьми нового объекта.
+     *
+     * @param address Адрес занятого слота
+     */
+    void releaseSlot(unsigned int address);
+
+    /**
+     * @brief Вернуть объект в пул его типа (функция удалителя ObjectPtr)
+     * @param pool Пул объекта
+     * @param object Объект
+     */
+    template<typename T>
+    static void destroyPooled(void* pool, IFileSystemObject* object) {
+        static_cast<ObjectPool<T>*>(pool)->destroy(static_cast<T*>(object));
+    }
+
+    /**
+     * @brief Пройти по сегментам пути от корня без копирования имён
+     * @param path Путь; сегменты "." пропускаются, ".." возвращает к корню
+     * @return Указатель на объект или nullptr если путь не найден
+     */
+    IFileSystemObject* walkPath(std::string_view path) const;
+
+    /**
+     * @brief Разрешить нормализованный путь (не корень) через кэш путей
+     * @param path Путь
+     * @return Указатель на объект или nullptr если путь не найден
+     */
+    IFileSystemObject* lookupPath(std::string_view path) const;
+
     /**
      * @brief Рекурсивный поиск объектов в директории по шаблону
      * @param pattern Шаблон для поиска
@@ -43,8 +132,9 @@ private:
 public:
     /**
      * @brief Конструктор репозитория
+     * @param resource Ресурс памяти для таблиц директорий и содержимого файлов, созданных репозиторием; должен жить дольше репозитория
      */
-    explicit FileSystemRepository();
+    explicit FileSystemRepository(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Деструктор репозитория
@@ -102,15 +192,89 @@ public:
      * @param object Уникальный указатель на объект для сохранения
      * @return true если сохранение успешно, иначе false
      */
-    bool saveObject(std::unique_ptr<IFileSystemObject> object) override;
+    bool saveObject(ObjectPtr object) override;
+
+    /**
+     * @brief Заранее выделить место под объекты с адресами меньше заданного
+     * @param addressLimit Граница адресов (ёмкость таблицы слотов)
+     */
+    void reserve(size_t addressLimit) override;
+
+    /**
+     * @brief Создать файл в пуле файлов
+     * @param name Имя файла
+     * @param parentAddress Адрес родительской директории
+     * @param owner Владелец
+     * @param address Адрес файла
+     * @return Владеющий указатель на файл
+     */
+    ObjectPtr allocateFile(const std::string& name, unsigned int parentAddress, const User& owner, unsigned int address) override;
+
+    /**
+     * @brief Создать директорию в пуле директорий
+     * @param name Имя директории
+     * @param parentAddress Адрес родительской директории
+     * @param owner Владелец
+     * @param address Адрес директории
+     * @return Владеющий указатель на директорию
+     */
+    ObjectPtr allocateDirectory(const std::string& name, unsigned int parentAddress, const User& owner, unsigned int address) override;
+
+    /**
+     * @brief Получить пул файлов
+     * @return Пул файлов
+     */
+    const ObjectPool<FileDescriptor>& getFilePool() const { return filePool; }
+
+    /**
+     * @brief Получить пул директорий
+     * @return Пул директорий
+     */
+    const ObjectPool<DirectoryDescriptor>& getDirectoryPool() const { return directoryPool; }
+
+    /**
+     * @brief Получить ссылку на объект с текущим поколением слота
+     * @param address Адрес объекта
+     * @return Ссылка (с нулевым адресом и поколением, если объекта нет)
+     */
+    Handle getHandle(unsigned int address) const;
+
+    /**
+     * @brief Получить объект по ссылке
+     * @param handle Ссылка, полученная из getHandle()
+     * @return Указатель на объект или nullptr если объект удалён или адрес занят другим объектом
+     */
+    IFileSystemObject* getObjectByHandle(Handle handle) const;
 
     /**
      * @brief Удалить объект из репозитория по адресу
+     *
+     * Вместе с директорией удаляются все её потомки.
+     *
      * @param address Адрес удаляемого объекта
      * @return true если удаление успешно, иначе false
      */
     bool deleteObject(unsigned int address) override;
 
+    /**
+     * @brief Переименовать и/или переместить объект
+     *
+     * Директорию нельзя переместить внутрь её самой. Записи кэша путей для старого
+     * пути объекта и путей его потомков удаляются.
+     *
+     * @param address Адрес объекта (не корня)
+     * @param newParentAddress Адрес новой родительской директории
+     * @param newName Новое имя (не занятое в новой директории)
+     * @return true если объект перемещён, иначе false
+     */
+    bool moveObject(unsigned int address, unsigned int newParentAddress, const std::string& newName) override;
+
+    /**
+     * @brief Получить счётчики кэша путей
+     * @return Попадания, промахи и размер кэша
+     */
+    PathCache<Handle>::Stats getPathCacheStats() const { return pathCache.getStats(); }
+
     /**
      * @brief Проверить существование объекта по адресу
      * @param address Адрес объекта
@@ -135,7 +299,10 @@ public:
 
     /**
      * @brief Получить новый уникальный адрес
-     * @return Новый адрес
+     *
+     * Сначала выдаются адреса удалённых объектов, затем новые по порядку.
+     *
+     * @return Свободный адрес
      */
     unsigned int getAddress() override;
 
@@ -146,10 +313,49 @@ public:
      */
     std::string getPath(IFileSystemObject* object) const override;
 
+    /**
+     * @brief Получить поколение путей
+     * @return Поколение путей
+     */
+    uint64_t getPathGeneration() const override { return pathGeneration.load(std::memory_order_acquire); }
+
     /**
      * @brief Очистить репозиторий
+     *
+     * Корневая директория сохраняется (без дочерних объектов), остальные объекты
+     * удаляются, а слабы пулов освобождаются целиком.
      */
     void clear() override;
+
+    /**
+     * @brief Получить ресурс памяти для содержимого создаваемых объектов
+     * @return Ресурс памяти репозитория
+     */
+    std::pmr::memory_resource* getMemoryResource() const override { return memoryResource; }
+
+    /**
+     * @brief Получить наследуемые записи, действующие на дочерние объекты директории
+     *
+     * Поднимается по родителям до первой директории с актуальным кэшем (или до корня)
+     * и спускается обратно, сохраняя результат в каждой директории цепочки. Директории
+     * без собственных наследуемых записей разделяют кэш родителя.
+     *
+     * @param directory Директория
+     * @return Наследуемые записи директории и её предков
+     */
+    ACL resolveInheritance(const IDirectory& directory) const override;
+
+    /**
+     * @brief Получить записи, унаследованные объектом от родительских директорий
+     * @param object Объект файловой системы
+     * @return Наследуемые записи
+     */
+    ACL getInheritedACL(const IFileSystemObject& object) const override;
+
+    /**
+     * @brief Сбросить кэши наследуемых записей (увеличить поколение)
+     */
+    void invalidateInheritance() override;
 };
 
 #endif
\ No newline at end of file
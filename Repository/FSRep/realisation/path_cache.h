@@ -0,0 +1,201 @@
+#ifndef LAB3_PATH_CACHE_H
+#define LAB3_PATH_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Ограниченный кэш разрешения путей (dentry-кэш).
+ *
+ * Сопоставляет нормализованному абсолютному пути значение (ссылку на объект).
+ * Актуальность значения проверяет вызывающий: устаревшая запись удаляется при
+ * обращении и считается промахом.
+ *
+ * Записи хранятся в двух поколениях: новые попадают в текущее, а когда оно
+ * заполняется, текущее становится прежним, а прежнее отбрасывается целиком.
+ * Попадание в прежнее поколение переносит запись в текущее, так что часто
+ * используемые пути не вытесняются. Кэш содержит не больше 2 * capacity записей.
+ *
+ * Перемещение или переименование (invalidate) в небольшом кэше удаляет только записи под
+ * изменённым путём. В кэше больше SCAN_LIMIT записей перебор стоил бы слишком дорого,
+ * поэтому увеличивается поколение кэша: все записи прежних поколений считаются промахами
+ * и удаляются при обращении или смене поколений хранения.
+ *
+ * Все операции синхронизированы.
+ *
+ * @tparam Value Тип значения
+ */
+template<typename Value>
+class PathCache {
+public:
+    /**
+     * @brief Счётчики кэша.
+     */
+    struct Stats {
+        uint64_t hits = 0;      ///< Попадания
+        uint64_t misses = 0;    ///< Промахи (включая устаревшие записи)
+        size_t size = 0;        ///< Количество записей
+    };
+
+    /// Ёмкость одного поколения по умолчанию
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    /// Наибольший размер кэша, при котором invalidate удаляет записи выборочно
+    static constexpr size_t SCAN_LIMIT = 256;
+
+private:
+    /**
+     * @brief Хеш строки, допускающий поиск по std::string_view.
+     */
+    struct PathHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view path) const noexcept { return std::hash<std::string_view>{}(path); }
+    };
+
+    /**
+     * @brief Запись кэша.
+     */
+    struct Entry {
+        Value value;            ///< Значение
+        uint64_t generation;    ///< Поколение кэша на момент записи
+    };
+
+    using Map = std::unordered_map<std::string, Entry, PathHash, std::equal_to<>>;
+
+    mutable std::mutex mutex;   ///< Защищает поколения и счётчики
+    Map recent;                 ///< Текущее поколение
+    Map older;                  ///< Прежнее поколение
+    size_t capacity;            ///< Ёмкость одного поколения
+    uint64_t generation = 0;    ///< Поколение кэша (записи других поколений устарели)
+    uint64_t hits = 0;          ///< Попадания
+    uint64_t misses = 0;        ///< Промахи
+
+    /**
+     * @brief Добавить запись в текущее поколение, сменив поколения при заполнении.
+     * @param path Путь
+     * @param value Значение
+     */
+    void store(std::string_view path, const Value& value) {
+        if (recent.size() >= capacity) {
+            older = std::move(recent);
+            recent = Map();
+        }
+        auto it = recent.find(path);
+        if (it != recent.end()) it->second = Entry{value, generation};
+        else recent.emplace(std::string(path), Entry{value, generation});
+    }
+
+    /**
+     * @brief Удалить из поколения путь и все пути под ним.
+     * @param map Поколение
+     * @param path Путь
+     */
+    static void erasePrefix(Map& map, std::string_view path) {
+        for (auto it = map.begin(); it != map.end();) {
+            std::string_view key = it->first;
+            bool under = key.starts_with(path) && (key.size() == path.size() || key[path.size()] == '/');
+            if (under) it = map.erase(it);
+            else ++it;
+        }
+    }
+
+public:
+    /**
+     * @brief Конструктор кэша.
+     * @param capacity Ёмкость одного поколения
+     */
+    explicit PathCache(size_t capacity = DEFAULT_CAPACITY) : capacity(capacity ? capacity : 1) {}
+
+    PathCache(const PathCache&) = delete;
+    PathCache& operator=(const PathCache&) = delete;
+
+    /**
+     * @brief Найти актуальное значение пути.
+     * @param path Путь
+     * @param isCurrent Проверка актуальности значения
+     * @return Значение или std::nullopt при промахе
+     */
+    template<typename IsCurrent>
+    std::optional<Value> find(std::string_view path, IsCurrent&& isCurrent) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = recent.find(path);
+        if (it != recent.end()) {
+            if (it->second.generation == generation && isCurrent(it->second.value)) {
+                hits++;
+                return it->second.value;
+            }
+            recent.erase(it);
+        }
+        auto old = older.find(path);
+        if (old != older.end()) {
+            Entry entry = old->second;
+            older.erase(old);
+            Value& value = entry.value;
+            if (entry.generation == generation && isCurrent(value)) {
+                hits++;
+                store(path, value);
+                return value;
+            }
+        }
+        misses++;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Запомнить значение пути.
+     * @param path Путь
+     * @param value Значение
+     */
+    void insert(std::string_view path, const Value& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        store(path, value);
+    }
+
+    /**
+     * @brief Удалить путь и все пути под ним (переименование или перемещение).
+     *
+     * Работает за O(SCAN_LIMIT): в большом кэше устаревшими становятся все записи.
+     *
+     * @param path Путь
+     */
+    void invalidate(std::string_view path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (path == "/") {
+            recent.clear();
+            older.clear();
+            return;
+        }
+        if (recent.size() + older.size() > SCAN_LIMIT) {
+            generation++;
+            return;
+        }
+        erasePrefix(recent, path);
+        erasePrefix(older, path);
+    }
+
+    /**
+     * @brief Удалить все записи. Счётчики сохраняются.
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        recent.clear();
+        older.clear();
+    }
+
+    /**
+     * @brief Получить счётчики кэша.
+     * @return Попадания, промахи и размер
+     */
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return {hits, misses, recent.size() + older.size()};
+    }
+};
+
+#endif
\ No newline at end of file
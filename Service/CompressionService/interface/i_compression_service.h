@@ -0,0 +1,77 @@
+#ifndef LAB3_I_COMPRESSION_SERVICE_H
+#define LAB3_I_COMPRESSION_SERVICE_H
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+/**
+ * @brief Сводка по памяти, занимаемой содержимым файлов.
+ */
+struct MemoryReport {
+    size_t files = 0;               ///< Количество файлов
+    size_t compressedFiles = 0;     ///< Количество файлов со сжатым содержимым
+    size_t contentBytes = 0;        ///< Размер содержимого без сжатия
+    size_t storedBytes = 0;         ///< Фактически занимаемый объём
+};
+
+/**
+ * @brief Интерфейс сервиса сжатия редко используемого содержимого файлов.
+ *
+ * Определяет операции фонового сжатия содержимого файлов, к которым давно не обращались,
+ * и получения отчёта о занимаемой памяти.
+ */
+class ICompressionService {
+public:
+    virtual ~ICompressionService() = default;
+
+    /**
+     * @brief Захватить файловую систему на время выполнения команды
+     * @return Блокировка; пока она удерживается, фоновое сжатие не выполняется
+     */
+    [[nodiscard]] virtual std::unique_lock<std::mutex> hold() = 0;
+
+    /**
+     * @brief Сжать содержимое файлов, к которым не обращались дольше заданного времени
+     * @param now Текущее время
+     * @param idle Время без обращений, после которого файл сжимается
+     * @return Количество сжатых файлов
+     */
+    virtual size_t compressIdle(std::chrono::system_clock::time_point now, std::chrono::seconds idle) = 0;
+
+    /**
+     * @brief Получить отчёт о памяти, занимаемой содержимым файлов
+     * @return Отчёт
+     */
+    virtual MemoryReport getMemoryReport() const = 0;
+
+    /**
+     * @brief Запустить фоновое сжатие
+     */
+    virtual void start() = 0;
+
+    /**
+     * @brief Остановить фоновое сжатие
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @brief Проверить, запущено ли фоновое сжатие
+     * @return true если фоновое сжатие запущено
+     */
+    virtual bool isRunning() const = 0;
+
+    /**
+     * @brief Установить время без обращений, после которого файл сжимается
+     * @param idle Время без обращений
+     */
+    virtual void setIdleInterval(std::chrono::seconds idle) = 0;
+
+    /**
+     * @brief Получить время без обращений, после которого файл сжимается
+     * @return Время без обращений
+     */
+    virtual std::chrono::seconds getIdleInterval() const = 0;
+};
+
+#endif
\ No newline at end of file
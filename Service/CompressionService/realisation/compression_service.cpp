@@ -0,0 +1,89 @@
+#include "compression_service.h"
+#include "Entity/FSObject/interface/object_cast.h"
+#include "Entity/File/interface/i_file.h"
+#include "Entity/File/interface/i_lockable.h"
+
+CompressionService::CompressionService(IFileSystemRepository& fsRepo, std::chrono::seconds idle, std::chrono::seconds period)
+    : fsRepository(fsRepo), idleInterval(idle), period(period), stopping(false) {}
+
+CompressionService::~CompressionService() {
+    stop();
+}
+
+std::unique_lock<std::mutex> CompressionService::hold() {
+    return std::unique_lock<std::mutex>(activity);
+}
+
+size_t CompressionService::compressIdle(std::chrono::system_clock::time_point now, std::chrono::seconds idle) {
+    size_t compressed = 0;
+    for (IFileSystemObject* obj : fsRepository.getAllObjects()) {
+        auto* file = asFile(obj);
+        // Уже сжатые файлы тоже обходятся: compressContent освобождает их распакованную копию.
+        if (!file || now - file->getLastAccessTime() < idle) continue;
+        std::unique_lock<FileLock> guard;
+        if (auto* lockable = asLockable(obj)) {
+            guard = std::unique_lock<FileLock>(lockable->getAccessLock(), std::try_to_lock);
+            if (!guard.owns_lock()) continue;
+        }
+        if (file->compressContent()) compressed++;
+    }
+    return compressed;
+}
+
+MemoryReport CompressionService::getMemoryReport() const {
+    MemoryReport report;
+    for (IFileSystemObject* obj : fsRepository.getAllObjects()) {
+        auto* file = asFile(obj);
+        if (!file) continue;
+        report.files++;
+        if (file->isContentCompressed()) report.compressedFiles++;
+        report.contentBytes += static_cast<size_t>(file->getSize());
+        report.storedBytes += file->getStoredSize();
+    }
+    return report;
+}
+
+void CompressionService::run() {
+    std::unique_lock<std::mutex> lock(control);
+    while (!wake.wait_for(lock, period, [this] { return stopping; })) {
+        std::chrono::seconds idle = idleInterval;
+        lock.unlock();
+        {
+            std::unique_lock<std::mutex> guard(activity, std::try_to_lock);
+            if (guard.owns_lock()) compressIdle(std::chrono::system_clock::now(), idle);
+        }
+        lock.lock();
+    }
+}
+
+void CompressionService::start() {
+    std::lock_guard<std::mutex> lock(control);
+    if (worker.joinable()) return;
+    stopping = false;
+    worker = std::thread(&CompressionService::run, this);
+}
+
+void CompressionService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(control);
+        if (!worker.joinable()) return;
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+bool CompressionService::isRunning() const {
+    std::lock_guard<std::mutex> lock(control);
+    return worker.joinable();
+}
+
+void CompressionService::setIdleInterval(std::chrono::seconds idle) {
+    std::lock_guard<std::mutex> lock(control);
+    idleInterval = idle;
+}
+
+std::chrono::seconds CompressionService::getIdleInterval() const {
+    std::lock_guard<std::mutex> lock(control);
+    return idleInterval;
+}
\ No newline at end of file
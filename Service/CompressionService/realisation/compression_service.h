@@ -0,0 +1,103 @@
+#ifndef LAB3_COMPRESSION_SERVICE_H
+#define LAB3_COMPRESSION_SERVICE_H
+
+#include "../interface/i_compression_service.h"
+#include "Repository/FSRep/interface/i_fs_repository.h"
+#include <condition_variable>
+#include <thread>
+
+/**
+ * @brief Реализация сервиса сжатия редко используемого содержимого файлов.
+ *
+ * Фоновый поток раз в период просыпается и сжимает содержимое файлов, к которым
+ * не обращались дольше заданного времени. Проход выполняется, только если удаётся
+ * захватить hold() без ожидания: контроллер удерживает его на время каждой команды,
+ * поэтому сжатие не пересекается ни с командами, ни с удалением объектов. Кроме того,
+ * каждый файл сжимается под исключительным захватом его блокировки доступа; занятые
+ * файлы пропускаются до следующего прохода.
+ */
+class CompressionService : public ICompressionService {
+private:
+    IFileSystemRepository& fsRepository;    ///< Ссылка на репозиторий файловой системы
+    std::chrono::seconds idleInterval;      ///< Время без обращений до сжатия
+    std::chrono::seconds period;            ///< Период проходов фонового потока
+    std::mutex activity;                    ///< Захватывается командами и проходом сжатия
+    mutable std::mutex control;             ///< Защищает настройки и состояние потока
+    std::condition_variable wake;           ///< Пробуждение потока при остановке
+    std::thread worker;                     ///< Фоновый поток
+    bool stopping;                          ///< Запрошена остановка потока
+
+    /**
+     * @brief Цикл фонового потока
+     */
+    void run();
+
+public:
+    /**
+     * @brief Конструктор сервиса сжатия
+     * @param fsRepo Репозиторий файловой системы
+     * @param idle Время без обращений, после которого файл сжимается
+     * @param period Период проходов фонового потока
+     */
+    explicit CompressionService(IFileSystemRepository& fsRepo,
+                                std::chrono::seconds idle = std::chrono::minutes(5),
+                                std::chrono::seconds period = std::chrono::seconds(30));
+
+    CompressionService(const CompressionService&) = delete;
+    CompressionService& operator=(const CompressionService&) = delete;
+
+    /**
+     * @brief Деструктор; останавливает фоновый поток
+     */
+    ~CompressionService() override;
+
+    /**
+     * @brief Захватить файловую систему на время выполнения команды
+     * @return Блокировка; пока она удерживается, фоновое сжатие не выполняется
+     */
+    [[nodiscard]] std::unique_lock<std::mutex> hold() override;
+
+    /**
+     * @brief Сжать содержимое файлов, к которым не обращались дольше заданного времени
+     * @param now Текущее время
+     * @param idle Время без обращений, после которого файл сжимается
+     * @return Количество сжатых файлов
+     */
+    size_t compressIdle(std::chrono::system_clock::time_point now, std::chrono::seconds idle) override;
+
+    /**
+     * @brief Получить отчёт о памяти, занимаемой содержимым файлов
+     * @return Отчёт
+     */
+    MemoryReport getMemoryReport() const override;
+
+    /**
+     * @brief Запустить фоновое сжатие
+     */
+    void start() override;
+
+    /**
+     * @brief Остановить фоновое сжатие
+     */
+    void stop() override;
+
+    /**
+     * @brief Проверить, запущено ли фоновое сжатие
+     * @return true если фоновое сжатие запущено
+     */
+    bool isRunning() const override;
+
+    /**
+     * @brief Установить время без обращений, после которого файл сжимается
+     * @param idle Время без обращений
+     */
+    void setIdleInterval(std::chrono::seconds idle) override;
+
+    /**
+     * @brief Получить время без обращений, после которого файл сжимается
+     * @return Время без обращений
+     */
+    std::chrono::seconds getIdleInterval() const override;
+};
+
+#endif
\ No newline at end of file
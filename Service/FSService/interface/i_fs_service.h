@@ -69,9 +69,9 @@ public:
      * @brief Прочитать содержимое файла
      * @param user Пользователь, выполняющий операцию
      * @param path Путь к файлу
-     * @return Содержимое файла или пустая строка в случае ошибки
+     * @return Представление содержимого файла (без копирования) или std::nullopt в случае ошибки
      */
-    virtual std::string readFile(const User& user, const std::string& path) = 0;
+    virtual std::optional<ContentView> readFile(const User& user, const std::string& path) = 0;
 
     /**
      * @brief Записать содержимое в файл
@@ -171,6 +171,35 @@ public:
      */
     virtual bool changePermissions(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) = 0;
 
+    /**
+     * @brief Изменить разрешения для объекта и всего его поддерева
+     *
+     * Объекты, на которые у пользователя нет права ChangePermissions, пропускаются.
+     *
+     * @param id Идентификатор субъекта
+     * @param s_type Тип субъекта
+     * @param path Путь к корню поддерева
+     * @param permissions Карта разрешений для изменения
+     * @return true если изменены права самого объекта path, иначе false
+     */
+    virtual bool changePermissionsRecursive(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) = 0;
+
+    /**
+     * @brief Изменить наследуемые разрешения директории
+     *
+     * Наследуемые записи действуют на все объекты поддерева директории и проверяются
+     * при каждой проверке прав, поэтому изменение не затрагивает сами объекты поддерева.
+     * Поддерево может содержать объекты других пользователей, поэтому менять наследуемые
+     * записи может только администратор.
+     *
+     * @param id Идентификатор субъекта
+     * @param s_type Тип субъекта
+     * @param path Путь к директории
+     * @param permissions Карта разрешений для изменения
+     * @return true если изменение успешно, иначе false
+     */
+    virtual bool changeInheritablePermissions(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) = 0;
+
     /**
      * @brief Изменить владельца объекта
      * @param user Пользователь, выполняющий операцию
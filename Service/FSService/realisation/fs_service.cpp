@@ -1,18 +1,36 @@
 #include "fs_service.h"
+#include "Entity/FSObject/interface/object_cast.h"
 #include "Entity/File/realisation/file_descriptor.h"
 #include "Entity/Directory/realisation/directory_descriptor.h"
 #include "Repository/FSRep/realisation/Path/path.h"
+#include <mutex>
 #include <queue>
+#include <shared_mutex>
+#include <unordered_map>
 
 FileSystemService::FileSystemService(IFileSystemRepository& fsRepo, ISecurityService& secService, ISessionService& sessionServ)
     : fsRepository(fsRepo), securityService(secService), sessionService(sessionServ) {}
 
 std::string FileSystemService::resolveUserPath(const std::string& path) const {
-    IFileSystemObject* currentObj = dynamic_cast<IFileSystemObject*>(sessionService.getCurrentDirectory());
+    IFileSystemObject* currentObj = asObject(sessionService.getCurrentDirectory());
     if (!currentObj) return "";
-    std::string currentPath = fsRepository.getPath(currentObj);
-    if (currentPath.empty()) return "";
-    return Path::resolvePath(currentPath, path);
+    // Абсолютный путь не зависит от текущей директории: путь к ней не строится.
+    if (!path.empty() && path[0] == '/') return Path::normalizePath(path);
+    std::string current = currentPath(currentObj);
+    if (current.empty()) return "";
+    return Path::resolvePath(current, path);
+}
+
+std::string FileSystemService::currentPath(IFileSystemObject* current) const {
+    const IDirectory* directory = asDirectory(current);
+    uint64_t generation = fsRepository.getPathGeneration();
+    std::lock_guard<std::mutex> lock(cwdMutex);
+    if (directory != cwdDirectory || generation != cwdGeneration || cwdPath.empty()) {
+        cwdPath = fsRepository.getPath(current);
+        cwdDirectory = directory;
+        cwdGeneration = generation;
+    }
+    return cwdPath;
 }
 
 IFileSystemObject* FileSystemService::getObject(const std::string& path) const {
@@ -26,6 +44,18 @@ bool FileSystemService::validateOperationPath(const std::string& path) const {
     return Path::isValidPath(resolvedPath);
 }
 
+ContentView FileSystemService::viewContentLocked(IFile& file) {
+    const ILockable* lockable = asLockable(file.asObject());
+    if (!lockable) return file.viewContent();
+    {
+        std::shared_lock<FileLock> guard(lockable->getAccessLock());
+        if (!file.isContentCompressed()) return file.viewContent();
+    }
+    std::unique_lock<FileLock> guard(lockable->getAccessLock());
+    file.decompressContent();
+    return file.viewContent();
+}
+
 IDirectory* FileSystemService::changeDirectory(const User& user, const std::string& path, IDirectory* currentDir) {
     IDirectory* savedCurrent = sessionService.getCurrentDirectory();
     sessionService.setCurrentDirectory(currentDir);
@@ -33,7 +63,7 @@ IDirectory* FileSystemService::changeDirectory(const User& user, const std::stri
     IDirectory* directory = fsRepository.getDirectoryByPath(resolvedPath);
     sessionService.setCurrentDirectory(savedCurrent);
     if (!directory) return nullptr;
-    IFileSystemObject* fsObject = dynamic_cast<IFileSystemObject*>(directory);
+    IFileSystemObject* fsObject = asObject(directory);
     if (!fsObject) return nullptr;
     if (!securityService.canExecute(user, *fsObject)) return nullptr;
     sessionService.setCurrentDirectory(directory);
@@ -49,16 +79,18 @@ std::vector<FileInfo> FileSystemService::listDirectory(const User& user, const s
         targetDir = fsRepository.getDirectoryByPath(resolvedPath);
     }
     if (!targetDir) return result;
-    IFileSystemObject* fsObject = dynamic_cast<IFileSystemObject*>(targetDir);
+    IFileSystemObject* fsObject = asObject(targetDir);
     if (!fsObject || !securityService.canRead(user, *fsObject)) return result;
     std::vector<IFileSystemObject*> children = targetDir->listChild();
     for (IFileSystemObject* child : children) {
         if (!child) continue;
         FileInfo info;
         info.name = child->getName();
-        if (dynamic_cast<IFile*>(child)) info.type = "file";
-        else if (dynamic_cast<IDirectory*>(child)) info.type = "dir";
-        else info.type = "unknown";
+        switch (child->getType()) {
+            case ObjectType::File: info.type = "file"; break;
+            case ObjectType::Directory: info.type = "dir"; break;
+            default: info.type = "unknown"; break;
+        }
         result.push_back(info);
     }
     return result;
@@ -68,19 +100,19 @@ std::vector<std::string> FileSystemService::findFiles(const User& user, const st
     std::vector<std::string> result;
     std::string resolvedStartPath;
     if (startPath.empty()) {
-        IFileSystemObject* currentObj = dynamic_cast<IFileSystemObject*>(sessionService.getCurrentDirectory());
+        IFileSystemObject* currentObj = asObject(sessionService.getCurrentDirectory());
         if (!currentObj) return result;
         resolvedStartPath = fsRepository.getPath(currentObj);
     } else resolvedStartPath = resolveUserPath(startPath);
     if (resolvedStartPath.empty()) return result;
     IDirectory* startDir = fsRepository.getDirectoryByPath(resolvedStartPath);
     if (!startDir) return result;
-    IFileSystemObject* startFsObject = dynamic_cast<IFileSystemObject*>(startDir);
+    IFileSystemObject* startFsObject = asObject(startDir);
     if (!startFsObject || !securityService.canRead(user, *startFsObject)) return result;
     std::vector<IFileSystemObject*> objects = fsRepository.findObjects(pattern, resolvedStartPath);
     for (IFileSystemObject* obj : objects) {
         if (!obj) continue;
-        IFile* file = dynamic_cast<IFile*>(obj);
+        IFile* file = asFile(obj);
         if (file && securityService.canRead(user, *obj)) {
             std::string objPath = fsRepository.getPath(obj);
             if (!objPath.empty()) result.push_back(objPath);
@@ -96,51 +128,50 @@ IFile* FileSystemService::createFile(const User& user, const std::string& path,
     std::string parentPath = Path::getParentPath(resolvedPath);
     IDirectory* parentDir = fsRepository.getDirectoryByPath(parentPath);
     if (!parentDir) return nullptr;
-    IFileSystemObject* parentObject = dynamic_cast<IFileSystemObject*>(parentDir);
+    IFileSystemObject* parentObject = asObject(parentDir);
     if (!parentObject || !securityService.canWrite(user, *parentObject)) return nullptr;
     unsigned int address = fsRepository.getAddress();
     std::string fileName = Path::getFileName(resolvedPath);
-    IFileSystemObject* parentFsObj = dynamic_cast<IFileSystemObject*>(parentDir);
+    IFileSystemObject* parentFsObj = asObject(parentDir);
     if (!parentFsObj) return nullptr;
-    auto file = std::make_unique<FileDescriptor>(fileName, parentFsObj->getAddress(), user, address);
-    if (!content.empty() && !file->writeContent(content)) return nullptr;
+    ObjectPtr file = fsRepository.allocateFile(fileName, parentFsObj->getAddress(), user, address);
+    if (!content.empty() && !asFile(file.get())->writeContent(content)) return nullptr;
     if (!parentDir->addChild(file.get())) return nullptr;
     if (!fsRepository.saveObject(std::move(file))) {
         parentDir->removeChild(fileName);
         return nullptr;
     }
-    return dynamic_cast<IFile*>(fsRepository.getObjectByAddress(address));
+    return asFile(fsRepository.getObjectByAddress(address));
 }
 
-std::string FileSystemService::readFile(const User& user, const std::string& path) {
+std::optional<ContentView> FileSystemService::readFile(const User& user, const std::string& path) {
     IFileSystemObject* obj = getObject(path);
-    if (!obj) return "";
-    IFile* file = dynamic_cast<IFile*>(obj);
-    if (!file) return "";
-    if (!securityService.canRead(user, *obj)) return "";
-    return std::string(file->readContent());
+    if (!obj) return std::nullopt;
+    IFile* file = asFile(obj);
+    if (!file) return std::nullopt;
+    if (!securityService.canRead(user, *obj)) return std::nullopt;
+    return viewContentLocked(*file);
 }
 
 bool FileSystemService::writeFile(const User& user, const std::string& path, const std::string& content, bool append) {
     IFileSystemObject* obj = getObject(path);
     if (!obj) return false;
-    IFile* file = dynamic_cast<IFile*>(obj);
+    IFile* file = asFile(obj);
     if (!file) return false;
     if (!securityService.canWrite(user, *obj)) return false;
-    if (append) {
-        std::string currentContent = file->readContent();
-        return file->writeContent(currentContent + content);
-    }
+    std::unique_lock<FileLock> guard;
+    if (ILockable* lockable = asLockable(obj)) guard = std::unique_lock<FileLock>(lockable->getAccessLock());
+    if (append) return file->appendContent(content);
     return file->writeContent(content);
 }
 
 bool FileSystemService::deleteFile(const User& user, const std::string& path) {
     IFileSystemObject* obj = getObject(path);
     if (!obj) return false;
-    IFile* file = dynamic_cast<IFile*>(obj);
+    IFile* file = asFile(obj);
     if (!file) return false;
     if (!securityService.canModify(user, *obj)) return false;
-    IDirectory* parentDir = dynamic_cast<IDirectory*>(fsRepository.getObjectByAddress(obj->getParentDirectoryAddress()));
+    IDirectory* parentDir = asDirectory(fsRepository.getObjectByAddress(obj->getParentDirectoryAddress()));
     if (!parentDir) return false;
     if (!parentDir->removeChild(obj->getName())) return false;
     return fsRepository.deleteObject(obj->getAddress());
@@ -151,15 +182,27 @@ bool FileSystemService::copyFile(const User& user, const std::string& source, co
     if (sourcePath.empty()) return false;
     IFile* sourceFile = fsRepository.getFileByPath(sourcePath);
     if (!sourceFile) return false;
-    IFileSystemObject* sourceFsObj = dynamic_cast<IFileSystemObject*>(sourceFile);
+    IFileSystemObject* sourceFsObj = asObject(sourceFile);
     if (!sourceFsObj || !securityService.canRead(user, *sourceFsObj)) return false;
-    std::string content = sourceFile->readContent();
-    return createFile(user, destination, content) != nullptr;
+    ContentView content = viewContentLocked(*sourceFile);
+    IFile* copy = createFile(user, destination);
+    return copy && copy->shareContent(content);
+}
+
+bool FileSystemService::relocate(const User& user, IFileSystemObject& object, const std::string& destination) {
+    if (!securityService.canRead(user, object) || !securityService.canModify(user, object)) return false;
+    if (!validateOperationPath(destination)) return false;
+    std::string resolvedPath = resolveUserPath(destination);
+    if (resolvedPath.empty() || fsRepository.pathExists(resolvedPath)) return false;
+    IFileSystemObject* parentObject = asObject(fsRepository.getDirectoryByPath(Path::getParentPath(resolvedPath)));
+    if (!parentObject || !securityService.canWrite(user, *parentObject)) return false;
+    return fsRepository.moveObject(object.getAddress(), parentObject->getAddress(), Path::getFileName(resolvedPath));
 }
 
 bool FileSystemService::moveFile(const User& user, const std::string& source, const std::string& destination) {
-    if (!copyFile(user, source, destination)) return false;
-    return deleteFile(user, source);
+    IFileSystemObject* obj = getObject(source);
+    if (!obj || !asFile(obj)) return false;
+    return relocate(user, *obj, destination);
 }
 
 IDirectory* FileSystemService::createDirectory(const User& user, const std::string& path) {
@@ -169,29 +212,29 @@ IDirectory* FileSystemService::createDirectory(const User& user, const std::stri
     std::string parentPath = Path::getParentPath(resolvedPath);
     IDirectory* parentDir = fsRepository.getDirectoryByPath(parentPath);
     if (!parentDir) return nullptr;
-    IFileSystemObject* parentObject = dynamic_cast<IFileSystemObject*>(parentDir);
+    IFileSystemObject* parentObject = asObject(parentDir);
     if (!parentObject || !securityService.canWrite(user, *parentObject)) return nullptr;
     unsigned int address = fsRepository.getAddress();
     std::string dirName = Path::getFileName(resolvedPath);
-    IFileSystemObject* parentFsObj = dynamic_cast<IFileSystemObject*>(parentDir);
+    IFileSystemObject* parentFsObj = asObject(parentDir);
     if (!parentFsObj) return nullptr;
-    auto dir = std::make_unique<DirectoryDescriptor>(dirName, parentFsObj->getAddress(), user, address);
+    ObjectPtr dir = fsRepository.allocateDirectory(dirName, parentFsObj->getAddress(), user, address);
     if (!parentDir->addChild(dir.get())) return nullptr;
     if (!fsRepository.saveObject(std::move(dir))) {
         parentDir->removeChild(dirName);
         return nullptr;
     }
-    return dynamic_cast<IDirectory*>(fsRepository.getObjectByAddress(address));
+    return asDirectory(fsRepository.getObjectByAddress(address));
 }
 
 bool FileSystemService::deleteDirectory(const User& user, const std::string& path, bool recursive) {
     IFileSystemObject* obj = getObject(path);
     if (!obj) return false;
-    IDirectory* dir = dynamic_cast<IDirectory*>(obj);
+    IDirectory* dir = asDirectory(obj);
     if (!dir) return false;
     if (!securityService.canModify(user, *obj)) return false;
     if (!recursive && dir->getChildCount() > 0) return false;
-    IDirectory* parentDir = dynamic_cast<IDirectory*>(fsRepository.getObjectByAddress(obj->getParentDirectoryAddress()));
+    IDirectory* parentDir = asDirectory(fsRepository.getObjectByAddress(obj->getParentDirectoryAddress()));
     if (!parentDir) return false;
     if (!parentDir->removeChild(obj->getName())) return false;
     return fsRepository.deleteObject(obj->getAddress());
@@ -204,42 +247,52 @@ bool FileSystemService::copyDirectory(const User& user, const std::string& sourc
     if (sourcePath.empty()) return false;
     IDirectory* sourceDir = fsRepository.getDirectoryByPath(sourcePath);
     if (!sourceDir) return false;
-    IFileSystemObject* sourceFsObj = dynamic_cast<IFileSystemObject*>(sourceDir);
+    IFileSystemObject* sourceFsObj = asObject(sourceDir);
     if (!sourceFsObj || !securityService.canRead(user, *sourceFsObj)) return false;
     std::queue<std::pair<IDirectory*, IDirectory*>> dirsToCopy;
     dirsToCopy.push({sourceDir, destDir});
     while (!dirsToCopy.empty()) {
         auto [srcDir, dstDir] = dirsToCopy.front();
         dirsToCopy.pop();
-        std::vector<IFileSystemObject*> children = srcDir->listChild();
-        for (IFileSystemObject* child : children) {
+        IFileSystemObject* dstFsObj = asObject(dstDir);
+        if (!dstFsObj || !securityService.canWrite(user, *dstFsObj)) continue;
+        std::vector<ObjectPtr> copies;
+        std::vector<IDirectory*> sources;
+        for (IFileSystemObject* child : srcDir->listChild()) {
             if (!child) continue;
             if (!securityService.canRead(user, *child)) continue;
-            IFile* file = dynamic_cast<IFile*>(child);
+            IFile* file = asFile(child);
             if (file) {
-                std::string content = file->readContent();
-                IFileSystemObject* dstFsObj = dynamic_cast<IFileSystemObject*>(dstDir);
-                if (!dstFsObj) continue;
-                std::string dstPath = fsRepository.getPath(dstFsObj) + "/" + child->getName();
-                createFile(user, dstPath, content);
+                ObjectPtr copy = fsRepository.allocateFile(child->getName(), dstFsObj->getAddress(), user, fsRepository.getAddress());
+                if (!asFile(copy.get())->shareContent(viewContentLocked(*file))) continue;
+                copies.push_back(std::move(copy));
+                sources.push_back(nullptr);
             } else {
-                IDirectory* subDir = dynamic_cast<IDirectory*>(child);
+                IDirectory* subDir = asDirectory(child);
                 if (subDir) {
-                    IFileSystemObject* dstFsObj = dynamic_cast<IFileSystemObject*>(dstDir);
-                    if (!dstFsObj) continue;
-                    std::string dstPath = fsRepository.getPath(dstFsObj) + "/" + child->getName();
-                    IDirectory* newSubDir = createDirectory(user, dstPath);
-                    if (newSubDir) dirsToCopy.push({subDir, newSubDir});
+                    ObjectPtr copy = fsRepository.allocateDirectory(child->getName(), dstFsObj->getAddress(), user, fsRepository.getAddress());
+                    copies.push_back(std::move(copy));
+                    sources.push_back(subDir);
                 }
             }
         }
+        std::vector<IFileSystemObject*> batch;
+        batch.reserve(copies.size());
+        for (size_t i = 0; i < copies.size(); i++) {
+            IFileSystemObject* object = copies[i].get();
+            if (!fsRepository.saveObject(std::move(copies[i]))) continue;
+            batch.push_back(object);
+            if (sources[i]) dirsToCopy.push({sources[i], asDirectory(object)});
+        }
+        dstDir->addChildren(batch);
     }
     return true;
 }
 
 bool FileSystemService::moveDirectory(const User& user, const std::string& source, const std::string& destination) {
-    if (!copyDirectory(user, source, destination)) return false;
-    return deleteDirectory(user, source, true);
+    IFileSystemObject* obj = getObject(source);
+    if (!obj || !asDirectory(obj)) return false;
+    return relocate(user, *obj, destination);
 }
 
 bool FileSystemService::changePermissions(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) {
@@ -256,6 +309,53 @@ bool FileSystemService::changePermissions(unsigned int id, SubjectType s_type, c
     return true;
 }
 
+bool FileSystemService::changePermissionsRecursive(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) {
+    IFileSystemObject* root = getObject(path);
+    if (!root) return false;
+    const User* currentUser = sessionService.getCurrentUser();
+    if (!currentUser) return false;
+    if (!securityService.canChangePermissions(*currentUser, *root)) return false;
+    // Исходный список держится в словаре, чтобы его адрес не достался новому содержимому.
+    std::unordered_map<const void*, std::pair<ACL, ACL>> rewritten;
+    std::vector<IFileSystemObject*> pending = {root};
+    while (!pending.empty()) {
+        IFileSystemObject* obj = pending.back();
+        pending.pop_back();
+        if (auto* dir = asDirectory(obj)) {
+            auto children = dir->snapshotChildren();
+            pending.insert(pending.end(), children->begin(), children->end());
+        }
+        if (obj != root && !securityService.canChangePermissions(*currentUser, *obj)) continue;
+        const ACL& current = obj->getSharedACL();
+        auto it = rewritten.find(current.identity());
+        if (it == rewritten.end()) {
+            ACL updated = current;
+            for (const auto& [perm, effect] : permissions) updated.setPermission(id, s_type, perm, effect);
+            it = rewritten.emplace(current.identity(), std::make_pair(current, std::move(updated))).first;
+        }
+        obj->setSharedACL(it->second.second);
+        obj->updateModificationTime();
+    }
+    return true;
+}
+
+bool FileSystemService::changeInheritablePermissions(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) {
+    IFileSystemObject* obj = getObject(path);
+    auto* dir = asDirectory(obj);
+    if (!dir) return false;
+    const User* currentUser = sessionService.getCurrentUser();
+    if (!currentUser) return false;
+    // Наследуемые записи действуют и на чужие объекты поддерева, поэтому права на саму директорию недостаточно.
+    if (!securityService.isAdministrator(*currentUser)) return false;
+    ACL updated = dir->getInheritableACL();
+    for (const auto& [perm, effect] : permissions) updated.setPermission(id, s_type, perm, effect);
+    if (updated == dir->getInheritableACL()) return true;
+    dir->setInheritableACL(updated);
+    fsRepository.invalidateInheritance();
+    obj->updateModificationTime();
+    return true;
+}
+
 bool FileSystemService::changeOwner(const User& user, const std::string& path, const std::string& newOwnerUsername) {
     IFileSystemObject* obj = getObject(path);
     if (!obj) return false;
@@ -266,7 +366,7 @@ bool FileSystemService::changeOwner(const User& user, const std::string& path, c
 bool FileSystemService::lockFile(const User& user, const std::string& path, Lock lockType) {
     IFileSystemObject* obj = getObject(path);
     if (!obj) return false;
-    ILockable* lockable = dynamic_cast<ILockable*>(obj);
+    ILockable* lockable = asLockable(obj);
     if (!lockable) return false;
     if (!securityService.canModify(user, *obj)) return false;
     lockable->setMode(lockType);
@@ -286,12 +386,12 @@ bool FileSystemService::isFile(const std::string& path) {
     std::string resolvedPath = resolveUserPath(path);
     if (resolvedPath.empty()) return false;
     IFileSystemObject* obj = fsRepository.getObjectByPath(resolvedPath);
-    return obj && dynamic_cast<IFile*>(obj) != nullptr;
+    return obj && asFile(obj) != nullptr;
 }
 
 bool FileSystemService::isDirectory(const std::string& path) {
     std::string resolvedPath = resolveUserPath(path);
     if (resolvedPath.empty()) return false;
     IFileSystemObject* obj = fsRepository.getObjectByPath(resolvedPath);
-    return obj && dynamic_cast<IDirectory*>(obj) != nullptr;
+    return obj && asDirectory(obj) != nullptr;
 }
\ No newline at end of file
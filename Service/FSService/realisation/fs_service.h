@@ -5,7 +5,10 @@
 #include "Service/SecurityService/interface/i_security_service.h"
 #include "Service/SessionService/interface/i_session_service.h"
 #include "Repository/FSRep/interface/i_fs_repository.h"
+#include <cstdint>
 #include <map>
+#include <mutex>
+#include <string>
 
 /**
  * @brief Сервис для управления файловой системой.
@@ -20,6 +23,22 @@ private:
     ISecurityService& securityService;   ///< Ссылка на сервис безопасности
     ISessionService& sessionService;     ///< Ссылка на сервис сессий
 
+    mutable std::mutex cwdMutex;                    ///< Защищает кэш пути текущей директории
+    mutable const IDirectory* cwdDirectory = nullptr; ///< Директория, путь которой закэширован
+    mutable uint64_t cwdGeneration = 0;             ///< Поколение путей репозитория на момент кэширования
+    mutable std::string cwdPath;                    ///< Путь текущей директории
+
+    /**
+     * @brief Получить путь текущей директории сессии
+     *
+     * Путь кэшируется до смены текущей директории (cd) или поколения путей репозитория
+     * (перемещение, переименование, удаление директорий, загрузка).
+     *
+     * @param current Текущая директория
+     * @return Путь или пустая строка, если директории нет в репозитории
+     */
+    std::string currentPath(IFileSystemObject* current) const;
+
     /**
      * @brief Разрешить путь относительно текущей директории пользователя
      * @param path Относительный или абсолютный путь
@@ -41,6 +60,31 @@ private:
      */
     bool validateOperationPath(const std::string& path) const;
 
+    /**
+     * @brief Прочитать содержимое файла под блокировкой доступа
+     *
+     * Читатели захватывают блокировку совместно. Прочитанное сжатое содержимое снова
+     * считается используемым и распаковывается на месте (decompressContent) под
+     * исключительным захватом.
+     *
+     * @param file Файл
+     * @return Представление содержимого файла
+     */
+    static ContentView viewContentLocked(IFile& file);
+
+    /**
+     * @brief Перенести объект по новому пути без копирования
+     *
+     * Объект сохраняет адрес, владельца, права и содержимое; поддерево директории
+     * переносится вместе с ней.
+     *
+     * @param user Пользователь, выполняющий операцию
+     * @param object Переносимый объект
+     * @param destination Новый путь (не должен существовать)
+     * @return true если перенос успешен, иначе false
+     */
+    bool relocate(const User& user, IFileSystemObject& object, const std::string& destination);
+
 public:
     /**
      * @brief Конструктор сервиса файловой системы
@@ -101,9 +145,9 @@ public:
      * @brief Прочитать содержимое файла
      * @param user Пользователь, выполняющий операцию
      * @param path Путь к файлу
-     * @return Содержимое файла или пустая строка в случае ошибки
+     * @return Представление содержимого файла (без копирования) или std::nullopt в случае ошибки
      */
-    std::string readFile(const User& user, const std::string& path) override;
+    std::optional<ContentView> readFile(const User& user, const std::string& path) override;
 
     /**
      * @brief Записать содержимое в файл
@@ -186,6 +230,36 @@ public:
      */
     bool changePermissions(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) override;
 
+    /**
+     * @brief Изменить разрешения для объекта и всего его поддерева
+     *
+     * Новый список ACL вычисляется один раз для каждого различного исходного списка,
+     * остальным объектам с тем же списком достаётся готовый общий экземпляр.
+     *
+     * @param id Идентификатор субъекта
+     * @param s_type Тип субъекта
+     * @param path Путь к корню поддерева
+     * @param permissions Карта разрешений для изменения
+     * @return true если изменены права самого объекта path, иначе false
+     */
+    bool changePermissionsRecursive(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) override;
+
+    /**
+     * @brief Изменить наследуемые разрешения директории
+     *
+     * Меняется один список директории, кэши наследования сбрасываются сменой поколения
+     * в репозитории - стоимость не зависит от размера поддерева. Доступно только
+     * администраторам: записи применяются и к объектам, права на которые текущий
+     * пользователь менять не может.
+     *
+     * @param id Идентификатор субъекта
+     * @param s_type Тип субъекта
+     * @param path Путь к директории
+     * @param permissions Карта разрешений для изменения
+     * @return true если изменение успешно, иначе false
+     */
+    bool changeInheritablePermissions(unsigned int id, SubjectType s_type, const std::string& path, const std::map<PermissionType, PermissionEffect>& permissions) override;
+
     /**
      * @brief Изменить владельца объекта
      * @param user Пользователь, выполняющий операцию
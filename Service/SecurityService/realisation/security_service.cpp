@@ -1,8 +1,8 @@
 #include "security_service.h"
 #include <algorithm>
 
-SecurityService::SecurityService(IUserRepository& userRepo, IGroupRepository& groupRepo)
-    : userRepository(userRepo), groupRepository(groupRepo) {}
+SecurityService::SecurityService(IUserRepository& userRepo, IGroupRepository& groupRepo, IFileSystemRepository* fsRepo)
+    : userRepository(userRepo), groupRepository(groupRepo), fsRepository(fsRepo) {}
 
 std::vector<unsigned int> SecurityService::getUserGroupIds(const User& user) const {
     std::vector<unsigned int> groupIds = user.getGroups();
@@ -16,27 +16,27 @@ std::vector<unsigned int> SecurityService::getUserGroupIds(const User& user) con
     return allGroupIds;
 }
 
-bool SecurityService::checkExplicitPermission(const User& user, const IFileSystemObject& object, PermissionType permission) const {
+PermissionMask SecurityService::getPermissionMask(const User& user, const IFileSystemObject& object) const {
     std::vector<unsigned int> groupIds = getUserGroupIds(user);
-    return object.checkPermission(user.getId(), groupIds, permission);
+    if (!fsRepository) return object.getPermissionMask(user.getId(), groupIds);
+    return object.getPermissionMask(user.getId(), groupIds, fsRepository->getInheritedACL(object));
+}
+
+bool SecurityService::checkExplicitPermission(const User& user, const IFileSystemObject& object, PermissionType permission) const {
+    return (getPermissionMask(user, object) & permissionBit(permission)) != 0;
 }
 
 bool SecurityService::checkPermission(const User& user, const IFileSystemObject& object, PermissionType permission) {
-    if (isOwner(user, object)) {
-        std::vector<unsigned int> groupIds = getUserGroupIds(user);
-        return object.checkPermission(user.getId(), groupIds, permission);
-    }
     return checkExplicitPermission(user, object, permission);
 }
 
 std::map<PermissionType, bool> SecurityService::getEffectivePermissions(const User& user, const IFileSystemObject& object) {
     std::map<PermissionType, bool> result;
-    result[PermissionType::Read] = canRead(user, object);
-    result[PermissionType::Write] = canWrite(user, object);
-    result[PermissionType::Execute] = canExecute(user, object);
-    result[PermissionType::Modify] = canModify(user, object);
-    result[PermissionType::ModifyMetadata] = canModifyMetadata(user, object);
-    result[PermissionType::ChangePermissions] = canChangePermissions(user, object);
+    PermissionMask mask = getPermissionMask(user, object);
+    for (PermissionType perm : {PermissionType::Read, PermissionType::Write, PermissionType::Execute,
+                                PermissionType::Modify, PermissionType::ModifyMetadata, PermissionType::ChangePermissions}) {
+        result[perm] = (mask & permissionBit(perm)) != 0;
+    }
     return result;
 }
 
@@ -75,5 +75,5 @@ bool SecurityService::isAdministrator(const User& user) {
 }
 
 bool SecurityService::isOwner(const User& user, const IFileSystemObject& object) {
-    return object.getOwner().getId() == user.getId();
+    return object.getOwnerId() == user.getId();
 }
\ No newline at end of file
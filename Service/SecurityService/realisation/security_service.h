@@ -4,6 +4,7 @@
 #include "../interface/i_security_service.h"
 #include "../../../Repository/UserRep/interface/i_user_repository.h"
 #include "../../../Repository/GroupRep/interface/i_group_repository.h"
+#include "../../../Repository/FSRep/interface/i_fs_repository.h"
 #include <vector>
 
 /**
@@ -12,11 +13,14 @@
  * Класс предоставляет функционал для проверки прав доступа пользователей,
  * управления аутентификацией и проверки привилегий в файловой системе.
  * Интегрируется с репозиториями пользователей и групп для определения прав.
+ * Если задан репозиторий файловой системы, к правам объекта добавляются
+ * наследуемые записи его родительских директорий.
  */
 class SecurityService : public ISecurityService {
 private:
     IUserRepository& userRepository;                        ///< Ссылка на репозиторий пользователей
     IGroupRepository& groupRepository;                      ///< Ссылка на репозиторий групп
+    IFileSystemRepository* fsRepository;                    ///< Репозиторий файловой системы для наследуемых записей (может быть nullptr)
     const std::string ADMIN_GROUP_NAME = "Administrators";  ///< Имя группы администраторов
 
     /**
@@ -26,6 +30,14 @@ private:
      */
     std::vector<unsigned int> getUserGroupIds(const User& user) const;
 
+    /**
+     * @brief Вычислить маску разрешений пользователя с учётом наследуемых записей
+     * @param user Пользователь
+     * @param object Объект файловой системы
+     * @return Маска разрешений
+     */
+    PermissionMask getPermissionMask(const User& user, const IFileSystemObject& object) const;
+
     /**
      * @brief Проверить явное разрешение без учета прав владельца
      * @param user Пользователь для проверки
@@ -40,8 +52,9 @@ public:
      * @brief Конструктор сервиса безопасности
      * @param userRepo Репозиторий пользователей
      * @param groupRepo Репозиторий групп
+     * @param fsRepo Репозиторий файловой системы (nullptr - без наследуемых записей)
      */
-    SecurityService(IUserRepository& userRepo, IGroupRepository& groupRepo);
+    SecurityService(IUserRepository& userRepo, IGroupRepository& groupRepo, IFileSystemRepository* fsRepo = nullptr);
 
     /**
      * @brief Проверить наличие конкретного разрешения у пользователя для объекта
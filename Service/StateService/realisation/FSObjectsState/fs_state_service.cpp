@@ -1,23 +1,55 @@
 #include "fs_state_service.h"
+#include "Entity/FSObject/interface/object_cast.h"
+#include "Entity/File/realisation/content_store.h"
+#include "Entity/File/realisation/file_content.h"
+#include "Entity/File/realisation/file_descriptor.h"
+#include "Entity/Directory/realisation/directory_descriptor.h"
+#include "Entity/Mapper/ConcretMapper/FSMappers/FileMapper/file_mapper.h"
+#include "Entity/Mapper/ConcretMapper/FSMappers/DirectoryMapper/directory_mapper.h"
 #include <yaml-cpp/yaml.h>
 #include <fstream>
 #include <iostream>
 #include <vector>
 #include <map>
 #include <memory>
+#include <limits>
 #include <sstream>
+#include <unordered_map>
 
 FSStateService::FSStateService(IFileSystemRepository& fsRepo, IUserRepository& userRepo, PolymorphicFSObjectMapper& mapper)
     : fsRepo_(fsRepo), userRepo_(userRepo), mapper_(mapper) {}
 
+ObjectPtr FSStateService::restoreObject(const DTO::FileSystemObjectDTO& dto) {
+    if (dto.address == 0) return ObjectPtr(mapper_.mapFrom(dto));
+    User owner(dto.ownerId, dto.ownerName);
+    if (dto.type == "FILE") {
+        ObjectPtr obj = fsRepo_.allocateFile(dto.name, dto.parentAddress, owner, dto.address);
+        FileMapper().fill(dto, static_cast<FileDescriptor&>(*obj));
+        return obj;
+    }
+    if (dto.type == "DIR") {
+        ObjectPtr obj = fsRepo_.allocateDirectory(dto.name, dto.parentAddress, owner, dto.address);
+        DirectoryMapper().fill(dto, static_cast<DirectoryDescriptor&>(*obj));
+        return obj;
+    }
+    return ObjectPtr(mapper_.mapFrom(dto));
+}
+
 void FSStateService::save(const std::string& path) {
     std::vector<IFileSystemObject*> allObjects = fsRepo_.getAllObjects();
+    std::map<ContentStore::BlobId, ContentView> blobs;
     std::ofstream out(path);
     YAML::Emitter emitter(out);
     emitter << YAML::BeginMap << YAML::Key << "filesystem" << YAML::Value << YAML::BeginSeq;
     for (IFileSystemObject* obj : allObjects) {
         if (!obj) continue;
+        if (auto* file = asFile(obj)) {
+            ContentStore::BlobId id = 0;
+            ContentView blob = ContentStore::instance().intern(file->viewContentAlways(), &id);
+            if (id) blobs.emplace(id, std::move(blob));
+        }
         DTO::FileSystemObjectDTO dto = mapper_.mapTo(*obj);
+        if (User* owner = userRepo_.getUserById(dto.ownerId)) dto.ownerName = owner->getName();
         emitter << YAML::BeginMap
                 << YAML::Key << "type" << YAML::Value << dto.type
                 << YAML::Key << "address" << YAML::Value << dto.address
@@ -35,14 +67,29 @@ void FSStateService::save(const std::string& path) {
         }
         emitter << YAML::EndMap << YAML::EndMap;
     }
+    emitter << YAML::EndSeq;
 
+    emitter << YAML::Key << "blobs" << YAML::Value << YAML::BeginSeq;
+    for (const auto& [id, content] : blobs) {
+        emitter << YAML::BeginMap
+                << YAML::Key << "id" << YAML::Value << ContentStore::formatId(id)
+                << YAML::Key << "content" << YAML::Value << content.str()
+                << YAML::EndMap;
+    }
     emitter << YAML::EndSeq << YAML::EndMap;
 }
 
 void FSStateService::load(const std::string& path) {
     YAML::Node config = YAML::LoadFile(path);
     YAML::Node fsNodes = config["filesystem"];
-    std::map<unsigned int, std::unique_ptr<IFileSystemObject>> objects;
+    std::map<std::string, std::pair<std::string, ContentView>> blobs;
+    for (const auto& node : config["blobs"]) {
+        FileContent content;
+        content.append(node["content"].as<std::string>());
+        ContentStore::BlobId id = 0;
+        ContentView blob = ContentStore::instance().intern(content.view(), &id);
+        blobs[node["id"].as<std::string>()] = {ContentStore::formatId(id), std::move(blob)};
+    }
     std::map<unsigned int, DTO::FileSystemObjectDTO> dtosMap;
     for (const auto& node : fsNodes) {
         DTO::FileSystemObjectDTO dto;
@@ -61,54 +108,79 @@ void FSStateService::load(const std::string& path) {
             std::string value = property.second.as<std::string>();
             dto.properties[key] = value;
         }
-
-        std::unique_ptr<IFileSystemObject> obj = mapper_.mapFrom(dto);
-        if (obj) {
-            objects[dto.address] = std::move(obj);
-            dtosMap[dto.address] = std::move(dto);
+        auto blobIt = dto.properties.find("blob");
+        if (blobIt != dto.properties.end()) {
+            auto loaded = blobs.find(blobIt->second);
+            if (loaded != blobs.end()) blobIt->second = loaded->second.first;
+            else dto.properties.erase(blobIt);
         }
+        unsigned int address = dto.address;
+        dtosMap[address] = std::move(dto);
+    }
+
+    // Адреса из файла заменяются плотными (корень сохраняет адрес 0): таблица слотов
+    // репозитория индексируется адресом, и большой или испорченный адрес не должен
+    // раздувать её.
+    std::unordered_map<unsigned int, unsigned int> addresses;
+    addresses.reserve(dtosMap.size());
+    unsigned int nextAddress = dtosMap.count(0) ? 1 : 0;
+    for (const auto& [address, dto] : dtosMap) addresses[address] = address == 0 ? 0 : nextAddress++;
+    auto remap = [&addresses](unsigned int address) {
+        auto it = addresses.find(address);
+        return it != addresses.end() ? it->second : std::numeric_limits<unsigned int>::max();
+    };
+
+    std::map<unsigned int, ObjectPtr> objects;
+    for (auto& [address, dto] : dtosMap) {
+        dto.address = remap(address);
+        dto.parentAddress = remap(dto.parentAddress);
+        ObjectPtr obj = restoreObject(dto);
+        if (obj) objects[dto.address] = std::move(obj);
     }
 
     for (const auto& [address, dto] : dtosMap) {
         if (dto.type == "DIR") {
-            auto it = objects.find(address);
+            auto it = objects.find(dto.address);
             if (it != objects.end()) {
-                IDirectory* dir = dynamic_cast<IDirectory*>(it->second.get());
+                IDirectory* dir = asDirectory(it->second.get());
                 if (dir && dto.properties.count("children")) {
                     std::string childrenStr = dto.properties.at("children");
                     std::istringstream iss(childrenStr);
                     std::string token;
+                    std::vector<IFileSystemObject*> children;
 
                     while (std::getline(iss, token, ',')) {
                         if (!token.empty()) {
                             try {
-                                unsigned int childAddr = std::stoul(token);
+                                unsigned int childAddr = remap(std::stoul(token));
                                 auto childIt = objects.find(childAddr);
                                 if (childIt != objects.end()) {
-                                    dir->addChild(childIt->second.get());
+                                    children.push_back(childIt->second.get());
                                 }
                             } catch (...) {}
                         }
                     }
+                    dir->addChildren(children);
                 }
             }
         }
     }
 
-    for (auto& [address, obj] : objects) {
-        auto dtoIt = dtosMap.find(address);
-        if (dtoIt != dtosMap.end()) {
-            const auto& dto = dtoIt->second;
+    for (const auto& [address, dto] : dtosMap) {
+        auto it = objects.find(dto.address);
+        if (it != objects.end()) {
             User* user = userRepo_.getUserByName(dto.ownerName);
             if (user) {
-                obj->setOwner(*user);
+                it->second->setOwner(*user);
             }
         }
     }
+    // Всё, что может выбросить исключение, выполняется до изменения репозитория.
+    fsRepo_.reserve(objects.empty() ? 1 : objects.rbegin()->first + 1);
     fsRepo_.clear();
     auto rootIt = objects.find(0);
     if (rootIt != objects.end()) {
-        IDirectory* rootDir = dynamic_cast<IDirectory*>(rootIt->second.get());
+        IDirectory* rootDir = asDirectory(rootIt->second.get());
         if (rootDir) fsRepo_.setRootDirectory(rootDir);
     }
 
@@ -12,6 +12,8 @@
  *
  * Реализует интерфейс IStateService для работы с объектами файловой системы.
  * Сохраняет и загружает данные о файлах и директориях с использованием маппера.
+ * Содержимое файлов записывается в отдельный список "blobs": каждый уникальный
+ * блоб ContentStore сохраняется один раз, а файлы ссылаются на него по идентификатору.
  */
 class FSStateService final : public IStateService {
 private:
@@ -19,6 +21,18 @@ private:
     IUserRepository& userRepo_;          ///< Репозиторий пользователей
     PolymorphicFSObjectMapper& mapper_;  ///< Маппер объектов файловой системы
 
+    /**
+     * @brief Восстановить объект из DTO
+     *
+     * Файлы и директории создаются в пулах репозитория (allocateFile/allocateDirectory)
+     * и заполняются маппером. Корень, как и в конструкторе репозитория, создаётся вне пула:
+     * clear() его не удаляет. Объекты неизвестного типа строит полиморфный маппер.
+     *
+     * @param dto DTO объекта с уже переназначенными адресами
+     * @return Владеющий указатель на объект (пустой, если тип не поддерживается)
+     */
+    ObjectPtr restoreObject(const DTO::FileSystemObjectDTO& dto);
+
 public:
     /**
      * @brief Конструктор сервиса состояния файловой системы
@@ -30,6 +44,11 @@ public:
 
     /**
      * @brief Загрузить состояние файловой системы из файла
+     *
+     * Объекты получают плотные адреса в порядке адресов из файла. Репозиторий очищается
+     * только после разбора файла и резервирования таблицы слотов, поэтому при ошибке
+     * разбора он остаётся прежним.
+     *
      * @param path Путь к файлу с данными
      */
     void load(const std::string& path) override;
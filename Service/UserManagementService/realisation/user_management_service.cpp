@@ -1,4 +1,5 @@
 #include "user_management_service.h"
+#include "Entity/FSObject/interface/object_cast.h"
 #include "../../../Entity/Directory/realisation/directory_descriptor.h"
 #include "iostream"
 UserManagementService::UserManagementService(IUserRepository& userRepo, IGroupRepository& groupRepo, ISecurityService& secService)
@@ -28,7 +29,7 @@ bool UserManagementService::createUser(const std::string& username, IDirectory*
     addUserToGroup(username, "All");
     if (isAdmin) addUserToGroup(username, "Administrators");
     if (root) {
-        IFileSystemObject* rootFsObj = dynamic_cast<IFileSystemObject*>(root);
+        IFileSystemObject* rootFsObj = asObject(root);
         if (rootFsObj) {
             std::vector<PermissionType> perm = {PermissionType::Read, PermissionType::Write, PermissionType::Execute};
             rootFsObj->setPermissions(userPtr->getId(), SubjectType::User, perm, PermissionEffect::Allow);
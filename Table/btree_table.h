@@ -0,0 +1,817 @@
+#ifndef LAB3_BTREE_TABLE_H
+#define LAB3_BTREE_TABLE_H
+
+#include "table.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Ассоциативный контейнер на основе B+дерева.
+ *
+ * Предоставляет тот же интерфейс поиска и упорядоченной итерации, что и Table,
+ * но хранит элементы в листьях ограниченного размера (каждый лист - небольшая Table),
+ * связанных в список. Вставка и удаление стоят O(log n) вместо O(n) сдвига.
+ *
+ * Поиск гетерогенный: find, contains, lower_bound и т.п. принимают любое значение,
+ * сравнимое с Key через operator< (например, std::string_view для строковых ключей).
+ *
+ * Узлы, листовые таблицы и массивы внутренних узлов выделяются из одного
+ * std::pmr::memory_resource; правила передачи ресурса те же, что у Table.
+ *
+ * @tparam Key Тип ключа, должен поддерживать операторы сравнения
+ * @tparam T Тип значения
+ * @tparam LeafCapacity Максимальное количество элементов в листе
+ * @tparam InnerCapacity Максимальное количество потомков внутреннего узла
+ */
+template<typename Key, typename T, size_t LeafCapacity = 64, size_t InnerCapacity = 64>
+class BTreeTable {
+    static_assert(LeafCapacity >= 4, "LeafCapacity must be at least 4");
+    static_assert(InnerCapacity >= 4, "InnerCapacity must be at least 4");
+
+private:
+    struct Inner;
+
+    /**
+     * @brief Базовый узел дерева.
+     */
+    struct Node {
+        bool leaf;              ///< Признак листа
+        Inner* parent;          ///< Родительский узел
+
+        explicit Node(bool isLeaf) noexcept : leaf(isLeaf), parent(nullptr) {}
+    };
+
+    /**
+     * @brief Лист дерева, хранящий отсортированные пары ключ-значение.
+     */
+    struct Leaf : Node {
+        Table<Key, T> items;    ///< Элементы листа
+        Leaf* prev;             ///< Предыдущий лист
+        Leaf* next;             ///< Следующий лист
+
+        explicit Leaf(std::pmr::memory_resource* resource) : Node(true), items(resource), prev(nullptr), next(nullptr) {
+            items.reserve(LeafCapacity + 1);
+        }
+    };
+
+    /**
+     * @brief Внутренний узел дерева.
+     *
+     * keys[i] - минимальный ключ поддерева children[i + 1].
+     */
+    struct Inner : Node {
+        std::pmr::vector<Key> keys;          ///< Разделяющие ключи
+        std::pmr::vector<Node*> children;    ///< Потомки узла
+
+        explicit Inner(std::pmr::memory_resource* resource) : Node(false), keys(resource), children(resource) {
+            keys.reserve(InnerCapacity);
+            children.reserve(InnerCapacity + 1);
+        }
+    };
+
+    static constexpr size_t MIN_LEAF = LeafCapacity / 2;    ///< Минимальное заполнение листа
+    static constexpr size_t MIN_INNER = InnerCapacity / 2;  ///< Минимальное количество потомков
+
+    Node* root_;        ///< Корень дерева
+    Leaf* first_;       ///< Самый левый лист
+    Leaf* last_;        ///< Самый правый лист
+    size_t size_;       ///< Количество элементов
+    std::pmr::memory_resource* resource_;  ///< Источник памяти для узлов
+
+    /**
+     * @brief Создать узел в ресурсе памяти дерева.
+     * @return Новый пустой узел
+     */
+    template<typename N>
+    N* new_node() {
+        return std::pmr::polymorphic_allocator<N>(resource_).template new_object<N>(resource_);
+    }
+
+    /**
+     * @brief Уничтожить узел и вернуть его память ресурсу.
+     * @param node Узел
+     */
+    template<typename N>
+    void delete_node(N* node) noexcept {
+        std::pmr::polymorphic_allocator<N>(resource_).delete_object(node);
+    }
+
+    template<bool IsConst>
+    class Iterator {
+        friend class BTreeTable;
+        friend class Iterator<!IsConst>;
+        using TreePtr = std::conditional_t<IsConst, const BTreeTable*, BTreeTable*>;
+        using PairType = std::conditional_t<IsConst, const TablePair<Key, T>, TablePair<Key, T>>;
+
+        TreePtr tree;   ///< Дерево, по которому идет итерация
+        Leaf* leaf;     ///< Текущий лист (nullptr для end())
+        size_t index;   ///< Позиция в листе
+
+        Iterator(TreePtr t, Leaf* l, size_t i) noexcept : tree(t), leaf(l), index(i) {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = PairType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        /**
+         * @brief Конструктор по умолчанию.
+         */
+        Iterator() noexcept : tree(nullptr), leaf(nullptr), index(0) {}
+
+        /**
+         * @brief Преобразование неконстантного итератора в константный.
+         */
+        template<bool WasConst = IsConst, typename = std::enable_if_t<WasConst>>
+        Iterator(const Iterator<false>& other) noexcept : tree(other.tree), leaf(other.leaf), index(other.index) {}
+
+        /**
+         * @brief Оператор разыменования.
+         * @return Ссылка на текущий элемент
+         */
+        reference operator*() const noexcept { return leaf->items.begin()[index]; }
+
+        /**
+         * @brief Оператор доступа к членам.
+         * @return Указатель на текущий элемент
+         */
+        pointer operator->() const noexcept { return &leaf->items.begin()[index]; }
+
+        /**
+         * @brief Получить ключ текущего элемента.
+         * @return Константная ссылка на ключ
+         */
+        const Key& key() const noexcept { return leaf->items.begin()[index].key; }
+
+        /**
+         * @brief Префиксный инкремент.
+         * @return Ссылка на этот итератор
+         */
+        Iterator& operator++() noexcept {
+            if (++index >= leaf->items.size()) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Постфиксный инкремент.
+         * @return Копия итератора до инкремента
+         */
+        Iterator operator++(int) noexcept { auto tmp = *this; ++*this; return tmp; }
+
+        /**
+         * @brief Префиксный декремент.
+         * @return Ссылка на этот итератор
+         */
+        Iterator& operator--() noexcept {
+            if (!leaf) {
+                leaf = tree->last_;
+                index = leaf->items.size() - 1;
+            } else if (index == 0) {
+                leaf = leaf->prev;
+                index = leaf->items.size() - 1;
+            } else --index;
+            return *this;
+        }
+
+        /**
+         * @brief Постфиксный декремент.
+         * @return Копия итератора до декремента
+         */
+        Iterator operator--(int) noexcept { auto tmp = *this; --*this; return tmp; }
+
+        /**
+         * @brief Оператор равенства.
+         * @param other Другой итератор
+         * @return true если итераторы указывают на один элемент
+         */
+        bool operator==(const Iterator& other) const noexcept { return leaf == other.leaf && index == other.index; }
+
+        /**
+         * @brief Оператор неравенства.
+         * @param other Другой итератор
+         * @return true если итераторы указывают на разные элементы
+         */
+        bool operator!=(const Iterator& other) const noexcept { return !(*this == other); }
+    };
+
+    /**
+     * @brief Спуститься к листу, который должен содержать ключ.
+     * @param key Ключ для поиска
+     * @return Лист или nullptr для пустого дерева
+     */
+    template<typename K = Key>
+    Leaf* find_leaf(const K& key) const noexcept {
+        Node* node = root_;
+        if (!node) return nullptr;
+        while (!node->leaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            size_t idx = std::upper_bound(inner->keys.begin(), inner->keys.end(), key) - inner->keys.begin();
+            node = inner->children[idx];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    /**
+     * @brief Получить позицию потомка в родительском узле.
+     * @param parent Родительский узел
+     * @param child Потомок
+     * @return Индекс потомка
+     */
+    static size_t child_index(const Inner* parent, const Node* child) noexcept {
+        return std::find(parent->children.begin(), parent->children.end(), child) - parent->children.begin();
+    }
+
+    /**
+     * @brief Перенести элементы листа начиная с позиции в конец другого листа.
+     * @param from Лист-источник
+     * @param pos Позиция первого переносимого элемента
+     * @param to Лист-приемник
+     */
+    static void move_items(Leaf* from, size_t pos, Leaf* to) {
+        auto it = from->items.begin() + pos;
+        for (auto end = from->items.end(); it != end; ++it) {
+            to->items.insert(TablePair<Key, T>(std::move(*it)));
+        }
+        from->items.erase(from->items.begin() + pos, from->items.end());
+    }
+
+    /**
+     * @brief Вставить новый узел справа от существующего в родительский узел.
+     * @param left Существующий узел
+     * @param key Минимальный ключ нового узла
+     * @param right Новый узел
+     */
+    void insert_into_parent(Node* left, const Key& key, Node* right) {
+        Inner* parent = left->parent;
+        if (!parent) {
+            parent = new_node<Inner>();
+            parent->keys.push_back(key);
+            parent->children.push_back(left);
+            parent->children.push_back(right);
+            left->parent = parent;
+            right->parent = parent;
+            root_ = parent;
+            return;
+        }
+        size_t idx = child_index(parent, left);
+        parent->keys.insert(parent->keys.begin() + idx, key);
+        parent->children.insert(parent->children.begin() + idx + 1, right);
+        right->parent = parent;
+        if (parent->children.size() <= InnerCapacity) return;
+
+        size_t mid = parent->keys.size() / 2;
+        Inner* sibling = new_node<Inner>();
+        Key upKey = std::move(parent->keys[mid]);
+        sibling->keys.assign(std::make_move_iterator(parent->keys.begin() + mid + 1), std::make_move_iterator(parent->keys.end()));
+        sibling->children.assign(parent->children.begin() + mid + 1, parent->children.end());
+        parent->keys.resize(mid);
+        parent->children.resize(mid + 1);
+        for (Node* child : sibling->children) child->parent = sibling;
+        insert_into_parent(parent, upKey, sibling);
+    }
+
+    /**
+     * @brief Разделить переполненный лист пополам.
+     * @param leaf Переполненный лист
+     */
+    void split_leaf(Leaf* leaf) {
+        Leaf* sibling = new_node<Leaf>();
+        move_items(leaf, leaf->items.size() / 2, sibling);
+        sibling->next = leaf->next;
+        sibling->prev = leaf;
+        if (leaf->next) leaf->next->prev = sibling;
+        else last_ = sibling;
+        leaf->next = sibling;
+        insert_into_parent(leaf, sibling->items.begin()->key, sibling);
+    }
+
+    /**
+     * @brief Удалить потомка из внутреннего узла вместе с разделяющим ключом.
+     * @param parent Внутренний узел
+     * @param idx Индекс удаляемого потомка (больше нуля)
+     */
+    static void remove_child(Inner* parent, size_t idx) noexcept {
+        parent->keys.erase(parent->keys.begin() + idx - 1);
+        parent->children.erase(parent->children.begin() + idx);
+    }
+
+    /**
+     * @brief Отсоединить лист от списка листьев и удалить его.
+     * @param leaf Удаляемый лист
+     */
+    void unlink_leaf(Leaf* leaf) noexcept {
+        if (leaf->prev) leaf->prev->next = leaf->next;
+        else first_ = leaf->next;
+        if (leaf->next) leaf->next->prev = leaf->prev;
+        else last_ = leaf->prev;
+        delete_node(leaf);
+    }
+
+    /**
+     * @brief Восстановить заполнение листа после удаления.
+     * @param leaf Лист, из которого удален элемент
+     */
+    void rebalance_leaf(Leaf* leaf) {
+        Inner* parent = leaf->parent;
+        if (!parent) {
+            if (leaf->items.empty()) {
+                delete_node(leaf);
+                root_ = nullptr;
+                first_ = last_ = nullptr;
+            }
+            return;
+        }
+        if (leaf->items.size() >= MIN_LEAF) return;
+        size_t idx = child_index(parent, leaf);
+        Leaf* left = idx > 0 ? static_cast<Leaf*>(parent->children[idx - 1]) : nullptr;
+        Leaf* right = idx + 1 < parent->children.size() ? static_cast<Leaf*>(parent->children[idx + 1]) : nullptr;
+        if (left && left->items.size() > MIN_LEAF) {
+            move_items(left, left->items.size() - 1, leaf);
+            parent->keys[idx - 1] = leaf->items.begin()->key;
+            return;
+        }
+        if (right && right->items.size() > MIN_LEAF) {
+            leaf->items.insert(TablePair<Key, T>(std::move(*right->items.begin())));
+            right->items.erase(right->items.begin());
+            parent->keys[idx] = right->items.begin()->key;
+            return;
+        }
+        if (left) {
+            move_items(leaf, 0, left);
+            remove_child(parent, idx);
+            unlink_leaf(leaf);
+        } else if (right) {
+            move_items(right, 0, leaf);
+            remove_child(parent, idx + 1);
+            unlink_leaf(right);
+        }
+        rebalance_inner(parent);
+    }
+
+    /**
+     * @brief Восстановить заполнение внутреннего узла после удаления потомка.
+     * @param node Внутренний узел
+     */
+    void rebalance_inner(Inner* node) {
+        Inner* parent = node->parent;
+        if (!parent) {
+            if (node->children.size() == 1) {
+                root_ = node->children.front();
+                root_->parent = nullptr;
+                delete_node(node);
+            }
+            return;
+        }
+        if (node->children.size() >= MIN_INNER) return;
+        size_t idx = child_index(parent, node);
+        Inner* left = idx > 0 ? static_cast<Inner*>(parent->children[idx - 1]) : nullptr;
+        Inner* right = idx + 1 < parent->children.size() ? static_cast<Inner*>(parent->children[idx + 1]) : nullptr;
+        if (left && left->children.size() > MIN_INNER) {
+            node->keys.insert(node->keys.begin(), std::move(parent->keys[idx - 1]));
+            node->children.insert(node->children.begin(), left->children.back());
+            node->children.front()->parent = node;
+            parent->keys[idx - 1] = std::move(left->keys.back());
+            left->keys.pop_back();
+            left->children.pop_back();
+            return;
+        }
+        if (right && right->children.size() > MIN_INNER) {
+            node->keys.push_back(std::move(parent->keys[idx]));
+            node->children.push_back(right->children.front());
+            node->children.back()->parent = node;
+            parent->keys[idx] = std::move(right->keys.front());
+            right->keys.erase(right->keys.begin());
+            right->children.erase(right->children.begin());
+            return;
+        }
+        Inner* target = left ? left : node;
+        Inner* source = left ? node : right;
+        size_t sourceIdx = left ? idx : idx + 1;
+        target->keys.push_back(std::move(parent->keys[sourceIdx - 1]));
+        target->keys.insert(target->keys.end(), std::make_move_iterator(source->keys.begin()), std::make_move_iterator(source->keys.end()));
+        for (Node* child : source->children) {
+            child->parent = target;
+            target->children.push_back(child);
+        }
+        remove_child(parent, sourceIdx);
+        delete_node(source);
+        rebalance_inner(parent);
+    }
+
+    /**
+     * @brief Рекурсивно освободить поддерево.
+     * @param node Корень поддерева
+     */
+    void destroy(Node* node) noexcept {
+        if (!node) return;
+        if (node->leaf) {
+            delete_node(static_cast<Leaf*>(node));
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (Node* child : inner->children) destroy(child);
+        delete_node(inner);
+    }
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = TablePair<Key, T>;
+    using reference = TablePair<Key, T>&;
+    using const_reference = const TablePair<Key, T>&;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    BTreeTable() noexcept : BTreeTable(std::pmr::get_default_resource()) {}
+
+    /**
+     * @brief Конструктор с указанием ресурса памяти.
+     * @param resource Ресурс, из которого выделяются узлы
+     */
+    explicit BTreeTable(std::pmr::memory_resource* resource) noexcept
+        : root_(nullptr), first_(nullptr), last_(nullptr), size_(0), resource_(resource) {}
+
+    /**
+     * @brief Конструктор из списка инициализации.
+     * @param init Список пар ключ-значение
+     * @param resource Ресурс, из которого выделяются узлы
+     */
+    BTreeTable(std::initializer_list<value_type> init, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : BTreeTable(resource) {
+        for (const auto& p : init) insert(p);
+    }
+
+    /**
+     * @brief Конструктор копирования.
+     * @param other Дерево для копирования
+     */
+    BTreeTable(const BTreeTable& other) : BTreeTable(other, std::pmr::get_default_resource()) {}
+
+    /**
+     * @brief Конструктор копирования с указанием ресурса памяти.
+     * @param other Дерево для копирования
+     * @param resource Ресурс, из которого выделяются узлы
+     */
+    BTreeTable(const BTreeTable& other, std::pmr::memory_resource* resource) : BTreeTable(resource) {
+        try {
+            for (const auto& p : other) insert(p);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Конструктор перемещения.
+     * @param other Дерево для перемещения
+     */
+    BTreeTable(BTreeTable&& other) noexcept
+        : root_(other.root_), first_(other.first_), last_(other.last_), size_(other.size_), resource_(other.resource_) {
+        other.root_ = nullptr;
+        other.first_ = other.last_ = nullptr;
+        other.size_ = 0;
+    }
+
+    /**
+     * @brief Копирующий оператор присваивания.
+     * @param other Дерево для копирования
+     * @return Ссылка на это дерево
+     */
+    BTreeTable& operator=(const BTreeTable& other) {
+        if (this == &other) return *this;
+        BTreeTable temp(other, resource_);
+        swap(temp);
+        return *this;
+    }
+
+    /**
+     * @brief Перемещающий оператор присваивания.
+     * @param other Дерево для перемещения
+     * @return Ссылка на это дерево
+     */
+    BTreeTable& operator=(BTreeTable&& other) noexcept {
+        if (this == &other) return *this;
+        BTreeTable temp(std::move(other));
+        swap(temp);
+        return *this;
+    }
+
+    /**
+     * @brief Деструктор.
+     */
+    ~BTreeTable() noexcept { destroy(root_); }
+
+    /**
+     * @brief Получить итератор на начало.
+     * @return Итератор на первый элемент
+     */
+    iterator begin() noexcept { return iterator(this, first_, 0); }
+
+    /**
+     * @brief Получить константный итератор на начало.
+     * @return Константный итератор на первый элемент
+     */
+    const_iterator begin() const noexcept { return const_iterator(this, first_, 0); }
+
+    /**
+     * @brief Получить константный итератор на начало.
+     * @return Константный итератор на первый элемент
+     */
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    /**
+     * @brief Получить итератор на конец.
+     * @return Итератор за последним элементом
+     */
+    iterator end() noexcept { return iterator(this, nullptr, 0); }
+
+    /**
+     * @brief Получить константный итератор на конец.
+     * @return Константный итератор за последним элементом
+     */
+    const_iterator end() const noexcept { return const_iterator(this, nullptr, 0); }
+
+    /**
+     * @brief Получить константный итератор на конец.
+     * @return Константный итератор за последним элементом
+     */
+    const_iterator cend() const noexcept { return end(); }
+
+    /**
+     * @brief Проверить, пусто ли дерево.
+     * @return true если дерево пусто
+     */
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Получить количество элементов.
+     * @return Количество элементов
+     */
+    size_type size() const noexcept { return size_; }
+
+    /**
+     * @brief Очистить дерево.
+     */
+    void clear() noexcept {
+        destroy(root_);
+        root_ = nullptr;
+        first_ = last_ = nullptr;
+        size_ = 0;
+    }
+
+    /**
+     * @brief Вставить пару ключ-значение.
+     * @param value Пара для вставки
+     * @return Пара из итератора и флага успеха
+     */
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert(value_type(value.key, value.value));
+    }
+
+    /**
+     * @brief Вставить пару ключ-значение с перемещением.
+     * @param value Пара для вставки
+     * @return Пара из итератора и флага успеха
+     */
+    std::pair<iterator, bool> insert(value_type&& value) {
+        if (!root_) {
+            Leaf* leaf = new_node<Leaf>();
+            root_ = first_ = last_ = leaf;
+        }
+        Leaf* leaf = find_leaf(value.key);
+        auto [it, inserted] = leaf->items.insert(std::move(value));
+        size_t pos = it - leaf->items.begin();
+        if (!inserted) return {iterator(this, leaf, pos), false};
+        size_++;
+        if (leaf->items.size() <= LeafCapacity) return {iterator(this, leaf, pos), true};
+        size_t half = leaf->items.size() / 2;
+        split_leaf(leaf);
+        if (pos < half) return {iterator(this, leaf, pos), true};
+        return {iterator(this, leaf->next, pos - half), true};
+    }
+
+    /**
+     * @brief Вставить или присвоить значение.
+     * @param key Ключ
+     * @param value Значение
+     * @return Пара из итератора и флага вставки
+     */
+    template<typename K, typename V>
+    std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+        iterator it = find(key);
+        if (it != end()) {
+            it->value = std::forward<V>(value);
+            return {it, false};
+        }
+        return insert(value_type(Key(std::forward<K>(key)), T(std::forward<V>(value))));
+    }
+
+    /**
+     * @brief Удалить элемент по ключу.
+     * @param key Ключ
+     * @return Количество удаленных элементов (0 или 1)
+     */
+    size_type erase(const Key& key) {
+        Leaf* leaf = find_leaf(key);
+        if (!leaf || !leaf->items.erase(key)) return 0;
+        size_--;
+        rebalance_leaf(leaf);
+        return 1;
+    }
+
+    /**
+     * @brief Удалить элемент по итератору.
+     * @param pos Итератор на элемент
+     * @return Итератор на следующий элемент
+     */
+    iterator erase(const_iterator pos) {
+        if (pos == end()) return end();
+        Key key = pos.key();
+        erase(key);
+        return lower_bound(key);
+    }
+
+    /**
+     * @brief Обменять содержимое с другим деревом.
+     * @param other Другое дерево
+     */
+    void swap(BTreeTable& other) noexcept {
+        std::swap(root_, other.root_);
+        std::swap(first_, other.first_);
+        std::swap(last_, other.last_);
+        std::swap(size_, other.size_);
+        std::swap(resource_, other.resource_);
+    }
+
+    /**
+     * @brief Получить ресурс памяти дерева.
+     * @return Ресурс, из которого выделяются узлы
+     */
+    std::pmr::memory_resource* get_resource() const noexcept { return resource_; }
+
+    /**
+     * @brief Найти элемент по ключу.
+     * @param key Ключ
+     * @return Итератор на элемент или end()
+     */
+    template<typename K = Key>
+    iterator find(const K& key) noexcept {
+        Leaf* leaf = find_leaf(key);
+        if (!leaf) return end();
+        auto it = leaf->items.find(key);
+        if (it == leaf->items.end()) return end();
+        return iterator(this, leaf, it - leaf->items.begin());
+    }
+
+    /**
+     * @brief Найти элемент по ключу (константная версия).
+     * @param key Ключ
+     * @return Константный итератор на элемент или end()
+     */
+    template<typename K = Key>
+    const_iterator find(const K& key) const noexcept {
+        return const_cast<BTreeTable*>(this)->find(key);
+    }
+
+    /**
+     * @brief Проверить наличие ключа.
+     * @param key Ключ
+     * @return true если ключ присутствует
+     */
+    template<typename K = Key>
+    bool contains(const K& key) const noexcept {
+        Leaf* leaf = find_leaf(key);
+        return leaf && leaf->items.contains(key);
+    }
+
+    /**
+     * @brief Получить количество элементов с ключом.
+     * @param key Ключ
+     * @return 0 или 1
+     */
+    template<typename K = Key>
+    size_type count(const K& key) const noexcept { return contains(key) ? 1 : 0; }
+
+    /**
+     * @brief Получить итератор на первый элемент не меньше ключа.
+     * @param key Ключ
+     * @return Итератор
+     */
+    template<typename K = Key>
+    iterator lower_bound(const K& key) noexcept {
+        Leaf* leaf = find_leaf(key);
+        if (!leaf) return end();
+        size_t pos = leaf->items.lower_bound(key) - leaf->items.begin();
+        if (pos < leaf->items.size()) return iterator(this, leaf, pos);
+        return iterator(this, leaf->next, 0);
+    }
+
+    /**
+     * @brief Получить константный итератор на первый элемент не меньше ключа.
+     * @param key Ключ
+     * @return Константный итератор
+     */
+    template<typename K = Key>
+    const_iterator lower_bound(const K& key) const noexcept {
+        return const_cast<BTreeTable*>(this)->lower_bound(key);
+    }
+
+    /**
+     * @brief Получить итератор на первый элемент больше ключа.
+     * @param key Ключ
+     * @return Итератор
+     */
+    template<typename K = Key>
+    iterator upper_bound(const K& key) noexcept {
+        iterator it = lower_bound(key);
+        if (it != end() && !(key < it.key())) ++it;
+        return it;
+    }
+
+    /**
+     * @brief Получить константный итератор на первый элемент больше ключа.
+     * @param key Ключ
+     * @return Константный итератор
+     */
+    template<typename K = Key>
+    const_iterator upper_bound(const K& key) const noexcept {
+        return const_cast<BTreeTable*>(this)->upper_bound(key);
+    }
+
+    /**
+     * @brief Доступ к элементу по ключу с проверкой.
+     * @param key Ключ
+     * @return Ссылка на значение
+     * @throws std::out_of_range если ключ не найден
+     */
+    T& at(const Key& key) {
+        iterator it = find(key);
+        if (it == end()) throw std::out_of_range("BTreeTable::at: key not found");
+        return it->value;
+    }
+
+    /**
+     * @brief Доступ к элементу по ключу с проверкой (константная версия).
+     * @param key Ключ
+     * @return Константная ссылка на значение
+     * @throws std::out_of_range если ключ не найден
+     */
+    const T& at(const Key& key) const {
+        const_iterator it = find(key);
+        if (it == end()) throw std::out_of_range("BTreeTable::at: key not found");
+        return it->value;
+    }
+
+    /**
+     * @brief Доступ к элементу по ключу с вставкой при отсутствии.
+     * @param key Ключ
+     * @return Ссылка на значение
+     */
+    T& operator[](const Key& key) {
+        iterator it = find(key);
+        if (it != end()) return it->value;
+        return insert(value_type(key, T())).first->value;
+    }
+};
+
+static_assert(std::bidirectional_iterator<BTreeTable<int, int>::iterator>);
+static_assert(std::bidirectional_iterator<BTreeTable<int, int>::const_iterator>);
+
+/**
+ * @brief Оператор равенства.
+ * @param lhs Левое дерево
+ * @param rhs Правое дерево
+ * @return true если деревья равны
+ */
+template<typename Key, typename T, size_t L, size_t I>
+bool operator==(const BTreeTable<Key, T, L, I>& lhs, const BTreeTable<Key, T, L, I>& rhs) noexcept {
+    if (lhs.size() != rhs.size()) return false;
+    for (auto it1 = lhs.begin(), it2 = rhs.begin(); it1 != lhs.end(); ++it1, ++it2) {
+        if (it1->key != it2->key || it1->value != it2->value) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief std::swap для BTreeTable.
+ */
+template<typename Key, typename T, size_t L, size_t I>
+void swap(BTreeTable<Key, T, L, I>& lhs, BTreeTable<Key, T, L, I>& rhs) noexcept { lhs.swap(rhs); }
+
+#endif
\ No newline at end of file
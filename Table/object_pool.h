@@ -0,0 +1,146 @@
+#ifndef LAB3_OBJECT_POOL_H
+#define LAB3_OBJECT_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Пул объектов одного типа, выделяемых слабами.
+ *
+ * Объекты размещаются в слотах больших блоков (слабов), поэтому создание объекта не
+ * обращается к общему аллокатору, а объекты одного типа лежат плотно. Освобождённый
+ * слот попадает в интрузивный список свободных слотов (указатель на следующий слот
+ * хранится в самом слоте) и переиспользуется следующим create().
+ *
+ * release() возвращает все слабы разом, когда живых объектов не осталось, - так
+ * очистка хранилища не проходит по списку свободных слотов.
+ *
+ * Пул не синхронизирован: создавать и уничтожать объекты должен один поток-владелец.
+ *
+ * @tparam T Тип объектов
+ * @tparam SlabBytes Желаемый размер слаба в байтах
+ */
+template<typename T, size_t SlabBytes = 64 * 1024>
+class ObjectPool {
+private:
+    /**
+     * @brief Слот пула: объект или ссылка на следующий свободный слот.
+     */
+    union Slot {
+        Slot* next;                                 ///< Следующий свободный слот
+        alignas(T) std::byte storage[sizeof(T)];    ///< Память под объект
+    };
+
+public:
+    /// Количество слотов в одном слабе
+    static constexpr size_t SLOTS_PER_SLAB = std::max<size_t>(1, SlabBytes / sizeof(Slot));
+
+private:
+    std::vector<std::unique_ptr<Slot[]>> slabs;     ///< Слабы (последний заполняется по порядку)
+    Slot* freeList = nullptr;                       ///< Список освобождённых слотов
+    size_t used = SLOTS_PER_SLAB;                   ///< Занятые по порядку слоты последнего слаба
+    size_t live = 0;                                ///< Количество живых объектов
+
+    /**
+     * @brief Получить свободный слот.
+     * @return Слот (из списка свободных или из последнего слаба)
+     */
+    Slot* acquire() {
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        if (used == SLOTS_PER_SLAB) {
+            slabs.push_back(std::make_unique_for_overwrite<Slot[]>(SLOTS_PER_SLAB));
+            used = 0;
+        }
+        return &slabs.back()[used++];
+    }
+
+    /**
+     * @brief Вернуть слот в список свободных.
+     * @param slot Слот
+     */
+    void recycle(Slot* slot) noexcept {
+        slot->next = freeList;
+        freeList = slot;
+    }
+
+public:
+    ObjectPool() = default;
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Деструктор. Все объекты пула к этому моменту должны быть уничтожены.
+     */
+    ~ObjectPool() = default;
+
+    /**
+     * @brief Создать объект в пуле.
+     * @param args Аргументы конструктора T
+     * @return Указатель на объект (уничтожается через destroy())
+     */
+    template<typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = acquire();
+        T* object;
+        try {
+            object = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            recycle(slot);
+            throw;
+        }
+        live++;
+        return object;
+    }
+
+    /**
+     * @brief Уничтожить объект и вернуть его слот в пул.
+     * @param object Объект, созданный этим пулом
+     */
+    void destroy(T* object) noexcept {
+        if (!object) return;
+        object->~T();
+        recycle(reinterpret_cast<Slot*>(object));
+        live--;
+    }
+
+    /**
+     * @brief Вернуть все слабы, если в пуле нет живых объектов.
+     * @return true если слабы освобождены
+     */
+    bool release() noexcept {
+        if (live != 0) return false;
+        slabs.clear();
+        freeList = nullptr;
+        used = SLOTS_PER_SLAB;
+        return true;
+    }
+
+    /**
+     * @brief Получить количество живых объектов.
+     * @return Количество объектов
+     */
+    [[nodiscard]] size_t size() const noexcept { return live; }
+
+    /**
+     * @brief Получить количество слотов во всех слабах.
+     * @return Ёмкость пула
+     */
+    [[nodiscard]] size_t capacity() const noexcept { return slabs.size() * SLOTS_PER_SLAB; }
+
+    /**
+     * @brief Получить количество слабов.
+     * @return Количество слабов
+     */
+    [[nodiscard]] size_t slabCount() const noexcept { return slabs.size(); }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef LAB3_RELOCATION_H
+#define LAB3_RELOCATION_H
+
+#include "iterator.h"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Признак тривиальной перемещаемости типа.
+ *
+ * Тип тривиально перемещаем, если перемещение объекта на новое место с последующим
+ * уничтожением исходного эквивалентно побайтовому копированию. Это верно для всех
+ * тривиально копируемых типов и для многих типов с нетривиальными конструкторами:
+ * умных указателей, строк без ссылки на собственный буфер и т.п.
+ *
+ * Для своих типов признак можно включить специализацией:
+ * template<> struct TriviallyRelocatable<MyType> : std::true_type {};
+ *
+ * @tparam T Проверяемый тип
+ */
+template<typename T>
+struct TriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+/**
+ * @brief std::unique_ptr со стандартным удалителем хранит только указатель.
+ */
+template<typename T>
+struct TriviallyRelocatable<std::unique_ptr<T>> : std::true_type {};
+
+/**
+ * @brief std::shared_ptr хранит указатели на объект и блок управления.
+ */
+template<typename T>
+struct TriviallyRelocatable<std::shared_ptr<T>> : std::true_type {};
+
+/**
+ * @brief std::weak_ptr хранит указатели на объект и блок управления.
+ */
+template<typename T>
+struct TriviallyRelocatable<std::weak_ptr<T>> : std::true_type {};
+
+#if defined(_LIBCPP_VERSION)
+/**
+ * @brief В libc++ короткая строка хранится внутри объекта без указателя на себя.
+ *
+ * В libstdc++ короткая строка ссылается на собственный буфер, поэтому там
+ * std::string перемещается поэлементно.
+ */
+template<typename CharT, typename Traits>
+struct TriviallyRelocatable<std::basic_string<CharT, Traits, std::allocator<CharT>>> : std::true_type {};
+#endif
+
+/**
+ * @brief Пара таблицы перемещаема побайтово, если перемещаемы ключ и значение.
+ */
+template<typename Key, typename T>
+struct TriviallyRelocatable<TablePair<Key, T>>
+    : std::bool_constant<TriviallyRelocatable<Key>::value && TriviallyRelocatable<T>::value> {};
+
+/**
+ * @brief Сокращение для TriviallyRelocatable<T>::value.
+ */
+template<typename T>
+inline constexpr bool trivially_relocatable_v = TriviallyRelocatable<std::remove_cv_t<T>>::value;
+
+/**
+ * @brief Переместить count объектов из src в неинициализированную память dst (области могут перекрываться).
+ *
+ * После вызова объекты в src считаются уничтоженными.
+ *
+ * @tparam T Тривиально перемещаемый тип
+ * @param dst Приемник
+ * @param src Источник
+ * @param count Количество объектов
+ */
+template<typename T>
+void relocate_bytes(T* dst, T* src, size_t count) noexcept {
+    static_assert(trivially_relocatable_v<T>, "relocate_bytes requires a trivially relocatable type");
+    if (count) std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+}
+
+#endif
\ No newline at end of file
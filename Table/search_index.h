@@ -0,0 +1,341 @@
+#ifndef LAB3_SEARCH_INDEX_H
+#define LAB3_SEARCH_INDEX_H
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Режим поиска в Table.
+ */
+enum class TableSearchMode {
+    Bisection,  ///< Обычный бинарный поиск по массиву пар
+    Eytzinger   ///< Поиск по компактному индексу префиксов ключей в порядке Эйтцингера
+};
+
+/**
+ * @brief 64-битный префикс ключа, сохраняющий порядок.
+ *
+ * Если a < b, то get(a) <= get(b). Равенство префиксов не означает равенства ключей,
+ * поэтому окончательное решение принимается сравнением полных ключей.
+ * Для типов без специализации индекс не строится.
+ *
+ * @tparam Key Тип ключа
+ */
+template<typename Key>
+struct TableKeyPrefix {};
+
+/**
+ * @brief Префикс целочисленного ключа - само значение со сдвигом знакового бита.
+ */
+template<std::integral Key>
+struct TableKeyPrefix<Key> {
+    static uint64_t get(Key key) noexcept {
+        if constexpr (std::is_signed_v<Key>) {
+            return static_cast<uint64_t>(static_cast<int64_t>(key)) ^ (uint64_t(1) << 63);
+        } else {
+            return static_cast<uint64_t>(key);
+        }
+    }
+};
+
+/**
+ * @brief Префикс строкового ключа - первые 8 байт в порядке big-endian, дополненные нулями.
+ */
+template<>
+struct TableKeyPrefix<std::string> {
+    static uint64_t get(std::string_view key) noexcept {
+        uint64_t prefix = 0;
+        size_t length = key.size() < 8 ? key.size() : 8;
+        for (size_t i = 0; i < length; i++) {
+            prefix |= static_cast<uint64_t>(static_cast<unsigned char>(key[i])) << (56 - 8 * i);
+        }
+        return prefix;
+    }
+};
+
+/**
+ * @brief Можно ли получить префикс ключа Key из значения типа K.
+ */
+template<typename Key, typename K>
+concept PrefixSearchable = requires(const K& key) {
+    { TableKeyPrefix<Key>::get(key) } -> std::same_as<uint64_t>;
+};
+
+/**
+ * @brief Можно ли искать ключ типа K через индекс префиксов таблицы с компаратором Compare.
+ *
+ * Префикс сохраняет порядок только для стандартного сравнения, поэтому
+ * для пользовательских компараторов всегда используется бинарный поиск.
+ */
+template<typename Key, typename K, typename Compare>
+concept PrefixIndexable = PrefixSearchable<Key, K> &&
+    (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Key>>);
+
+/**
+ * @brief Индекс префиксов ключей в порядке Эйтцингера (неявное бинарное дерево в массиве).
+ *
+ * Спуск по такому массиву обращается к памяти предсказуемо: потомки узла k лежат в 2k и 2k+1,
+ * поэтому узлы на три уровня ниже (одна кэш-линия) можно предзагружать, а сам спуск не содержит ветвлений.
+ * Индекс хранит только 8-байтовые префиксы и позиции в отсортированном массиве,
+ * поэтому на одну кэш-линию приходится восемь ключей вместо одной-двух пар ключ-значение.
+ */
+class EytzingerIndex {
+private:
+    std::vector<uint64_t> prefixes_;  ///< Префиксы в порядке Эйтцингера, индексация с 1
+    std::vector<uint32_t> ranks_;     ///< Позиция элемента в отсортированном массиве для каждого узла
+    size_t size_ = 0;                 ///< Количество проиндексированных элементов
+
+    /**
+     * @brief Разложить отсортированные префиксы по узлам дерева (обход in-order).
+     * @param prefixAt Функция, возвращающая префикс ключа на позиции i
+     * @param next Следующая позиция в отсортированном массиве
+     * @param k Текущий узел
+     */
+    template<typename PrefixAt>
+    void fill(PrefixAt& prefixAt, size_t& next, size_t k) {
+        if (k > size_) return;
+        fill(prefixAt, next, 2 * k);
+        prefixes_[k] = prefixAt(next);
+        ranks_[k] = static_cast<uint32_t>(next);
+        next++;
+        fill(prefixAt, next, 2 * k + 1);
+    }
+
+public:
+    static constexpr size_t MIN_SIZE = 64;  ///< Меньшие таблицы быстрее просматривать обычным бинарным поиском
+
+    /**
+     * @brief Перестроить индекс.
+     * @param size Количество элементов таблицы
+     * @param prefixAt Функция, возвращающая префикс ключа на позиции i (ключи отсортированы)
+     */
+    template<typename PrefixAt>
+    void build(size_t size, PrefixAt prefixAt) {
+        prefixes_.assign(size + 1, 0);
+        ranks_.assign(size + 1, 0);
+        size_ = size;
+        size_t next = 0;
+        fill(prefixAt, next, 1);
+    }
+
+    /**
+     * @brief Найти позицию первого элемента с префиксом не меньше заданного.
+     * @param prefix Префикс искомого ключа
+     * @return Позиция в отсортированном массиве или size, если такой нет
+     */
+    size_t lower_bound(uint64_t prefix) const noexcept {
+        const uint64_t* nodes = prefixes_.data();
+        size_t k = 1;
+        while (k <= size_) {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(nodes + 8 * k);
+#endif
+            k = 2 * k + (nodes[k] < prefix);
+        }
+        k >>= std::countr_one(k) + 1;
+        return k == 0 ? size_ : ranks_[k];
+    }
+};
+
+/**
+ * @brief Поиск по отсортированным ключам таблицы: режим поиска и индекс Эйтцингера.
+ *
+ * Общая часть Table и SplitTable: таблица передает доступ к ключу по позиции,
+ * а раскладка самих элементов остается ее делом.
+ *
+ * Изменяющие операции таблицы только помечают индекс устаревшим (invalidate() - O(1)).
+ * Перестраивает его поиск, и не сразу: пока индекса нет, поиск идёт бинарным поиском,
+ * а перестройка за O(n) начинается, когда таких поисков набралось n / REBUILD_RATIO.
+ * Серия изменений без чтений, как и чередование изменений с редкими чтениями, индекс
+ * не перестраивает вовсе. Индекс выделяется только в режиме Eytzinger и только для
+ * таблиц от EytzingerIndex::MIN_SIZE элементов.
+ *
+ * Константные методы таблицы, как и у стандартных контейнеров, можно вызывать из
+ * нескольких потоков одновременно: строит индекс один поток, выигравший переход
+ * состояния Stale -> Building, и публикует его переходом в Ready с release-семантикой.
+ * Остальные потоки до публикации продолжают искать бинарным поиском и не ждут.
+ */
+class TableSearchIndex {
+private:
+    /**
+     * @brief Состояние индекса.
+     */
+    enum State : uint8_t {
+        Stale,      ///< Индекс не соответствует таблице
+        Building,   ///< Индекс строит один из читателей
+        Ready       ///< Индекс построен и опубликован
+    };
+
+    /// Во сколько раз перестройка индекса дороже одного бинарного поиска (на элемент таблицы)
+    static constexpr size_t REBUILD_RATIO = 32;
+
+    mutable std::unique_ptr<EytzingerIndex> index_;       ///< Индекс (меняет только поток, перешедший в Building)
+    mutable std::atomic<uint8_t> state_{Stale};           ///< Состояние индекса
+    mutable std::atomic<size_t> stale_lookups_{0};        ///< Поиски без индекса с последнего изменения
+    TableSearchMode mode_ = TableSearchMode::Bisection;   ///< Выбранный режим поиска
+
+    /**
+     * @brief Получить опубликованный индекс, построив его, если поисков без индекса было достаточно.
+     * @tparam Key Тип ключа таблицы
+     * @param size Количество элементов таблицы
+     * @param keyAt Функция, возвращающая ключ на позиции i
+     * @return Индекс или nullptr, если искать нужно бинарным поиском
+     */
+    template<typename Key, typename KeyAt>
+    const EytzingerIndex* ready_index(size_t size, const KeyAt& keyAt) const noexcept {
+        if (mode_ != TableSearchMode::Eytzinger || size < EytzingerIndex::MIN_SIZE) return nullptr;
+        uint8_t state = state_.load(std::memory_order_acquire);
+        if (state == Ready) return index_.get();
+        if (state == Building) return nullptr;
+        if (stale_lookups_.fetch_add(1, std::memory_order_relaxed) + 1 < size / REBUILD_RATIO) return nullptr;
+        if (!state_.compare_exchange_strong(state, Building, std::memory_order_acquire)) return nullptr;
+        try {
+            if (!index_) index_ = std::make_unique<EytzingerIndex>();
+            index_->build(size, [&keyAt](size_t i) { return TableKeyPrefix<Key>::get(keyAt(i)); });
+            state_.store(Ready, std::memory_order_release);
+            return index_.get();
+        } catch (...) {
+            stale_lookups_.store(0, std::memory_order_relaxed);
+            state_.store(Stale, std::memory_order_release);
+            return nullptr;
+        }
+    }
+
+public:
+    /**
+     * @brief Конструктор индекса в режиме Bisection.
+     */
+    TableSearchIndex() = default;
+
+    /**
+     * @brief Конструктор перемещения; перемещённый индекс остаётся устаревшим.
+     * @param other Индекс для перемещения
+     */
+    TableSearchIndex(TableSearchIndex&& other) noexcept
+        : index_(std::move(other.index_)), state_(other.state_.load(std::memory_order_relaxed)),
+          stale_lookups_(other.stale_lookups_.load(std::memory_order_relaxed)), mode_(other.mode_) {
+        other.invalidate();
+    }
+
+    /**
+     * @brief Перемещающий оператор присваивания.
+     * @param other Индекс для перемещения
+     * @return Ссылка на этот индекс
+     */
+    TableSearchIndex& operator=(TableSearchIndex&& other) noexcept {
+        if (this == &other) return *this;
+        index_ = std::move(other.index_);
+        state_.store(other.state_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        stale_lookups_.store(other.stale_lookups_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        mode_ = other.mode_;
+        other.invalidate();
+        return *this;
+    }
+
+    /**
+     * @brief Получить выбранный режим поиска.
+     * @return Режим поиска
+     */
+    TableSearchMode mode() const noexcept { return mode_; }
+
+    /**
+     * @brief Выбрать режим поиска; индекс при этом не строится.
+     * @param mode Новый режим
+     */
+    void set_mode(TableSearchMode mode) noexcept {
+        mode_ = mode;
+        if (mode == TableSearchMode::Bisection) index_.reset();
+        invalidate();
+    }
+
+    /**
+     * @brief Пометить индекс устаревшим после изменения таблицы.
+     *
+     * Вызывается изменяющими операциями, которые, как и у стандартных контейнеров,
+     * не выполняются параллельно с поиском.
+     */
+    void invalidate() noexcept {
+        state_.store(Stale, std::memory_order_relaxed);
+        stale_lookups_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Бинарный поиск позиции ключа в диапазоне позиций.
+     * @param keyAt Функция, возвращающая ключ на позиции i
+     * @param key Ключ для поиска (Key или тип, сравнимый с ним через Compare)
+     * @param left Начало диапазона
+     * @param right Конец диапазона (не включительно)
+     * @param comp Компаратор ключей
+     * @return Первая позиция диапазона, ключ на которой не меньше искомого
+     */
+    template<typename KeyAt, typename K, typename Compare>
+    static size_t bisect(KeyAt keyAt, const K& key, size_t left, size_t right, const Compare& comp) noexcept {
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (comp(keyAt(mid), key)) left = mid + 1;
+            else right = mid;
+        }
+        return left;
+    }
+
+    /**
+     * @brief Найти позицию ключа для операций чтения.
+     *
+     * Индекс дает первую позицию, префикс ключа на которой не меньше искомого. Все ключи
+     * левее точно меньше, поэтому дальше достаточно экспоненциального поиска вправо:
+     * для различающихся префиксов это одно сравнение полных ключей. Без актуального
+     * индекса выполняется обычный бинарный поиск; устаревший индекс может быть перестроен
+     * здесь же (см. описание класса).
+     *
+     * @tparam Key Тип ключа таблицы
+     * @param keyAt Функция, возвращающая ключ на позиции i
+     * @param size Количество элементов таблицы
+     * @param key Ключ для поиска
+     * @param comp Компаратор ключей
+     * @return Первая позиция, ключ на которой не меньше искомого
+     */
+    template<typename Key, typename KeyAt, typename K, typename Compare>
+    size_t lower_bound(KeyAt keyAt, size_t size, const K& key, const Compare& comp) const noexcept {
+        if constexpr (PrefixIndexable<Key, K, Compare> && PrefixSearchable<Key, Key>) {
+            if (const EytzingerIndex* index = ready_index<Key>(size, keyAt)) {
+                size_t left = index->lower_bound(TableKeyPrefix<Key>::get(key));
+                size_t step = 1;
+                while (left < size && comp(keyAt(left), key)) {
+                    size_t right = left + step < size ? left + step : size;
+                    if (right == size || !comp(keyAt(right), key)) return bisect(keyAt, key, left + 1, right, comp);
+                    left = right + 1;
+                    step *= 2;
+                }
+                return left;
+            }
+        }
+        return bisect(keyAt, key, 0, size, comp);
+    }
+
+    /**
+     * @brief Обменять индекс и режим с другой таблицей.
+     * @param other Другой индекс
+     */
+    void swap(TableSearchIndex& other) noexcept {
+        index_.swap(other.index_);
+        std::swap(mode_, other.mode_);
+        uint8_t state = state_.load(std::memory_order_relaxed);
+        state_.store(other.state_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.state_.store(state, std::memory_order_relaxed);
+        size_t lookups = stale_lookups_.load(std::memory_order_relaxed);
+        stale_lookups_.store(other.stale_lookups_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.stale_lookups_.store(lookups, std::memory_order_relaxed);
+    }
+};
+
+#endif
\ No newline at end of file
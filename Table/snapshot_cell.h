@@ -0,0 +1,76 @@
+#ifndef LAB3_SNAPSHOT_CELL_H
+#define LAB3_SNAPSHOT_CELL_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Ячейка с неизменяемым снимком данных для чтения параллельно с изменениями.
+ *
+ * Снимок публикуется через std::atomic<std::shared_ptr<const T>>: читатель атомарно
+ * получает ссылку на текущую версию и работает с ней сколько угодно долго, а старая
+ * версия освобождается, когда её отпускает последний читатель (подсчёт ссылок играет
+ * роль отложенного освобождения в RCU).
+ *
+ * Писатель изменяет исходные данные под write_lock() и вызывает invalidate(). Новая
+ * версия собирается лениво первым читателем, которому не хватило снимка: только он
+ * берёт тот же мьютекс, остальные читатели продолжают работать со своими версиями.
+ * Поэтому серия изменений стоит O(1) на изменение, а не O(n) на пересборку.
+ *
+ * Чтение не является lock-free: std::atomic<std::shared_ptr> в libstdc++ защищён
+ * внутренней блокировкой, а читатель устаревшего снимка ждёт текущего писателя.
+ * Гарантируется только, что читатель актуального снимка не ждёт писателей.
+ *
+ * @tparam T Тип снимка
+ */
+template<typename T>
+class SnapshotCell {
+private:
+    mutable std::atomic<std::shared_ptr<const T>> current_;  ///< Опубликованная версия (nullptr - устарела)
+    mutable std::mutex write_mutex_;                         ///< Сериализует изменения источника и сборку снимка
+
+public:
+    /**
+     * @brief Конструктор пустой (устаревшей) ячейки.
+     */
+    SnapshotCell() = default;
+
+    SnapshotCell(const SnapshotCell&) = delete;
+    SnapshotCell& operator=(const SnapshotCell&) = delete;
+
+    /**
+     * @brief Захватить право изменять исходные данные.
+     * @return Блокировка, которую нужно держать на время изменения
+     */
+    [[nodiscard]] std::unique_lock<std::mutex> write_lock() const { return std::unique_lock<std::mutex>(write_mutex_); }
+
+    /**
+     * @brief Пометить снимок устаревшим. Вызывается писателем под write_lock().
+     */
+    void invalidate() noexcept { current_.store(nullptr, std::memory_order_release); }
+
+    /**
+     * @brief Получить опубликованный снимок без сборки.
+     * @return Снимок или nullptr, если он устарел
+     */
+    std::shared_ptr<const T> peek() const noexcept { return current_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Получить актуальный снимок, собрав его при необходимости.
+     * @param build Функция, строящая T из исходных данных (вызывается под write_lock())
+     * @return Неизменяемый снимок
+     */
+    template<typename Build>
+    std::shared_ptr<const T> get(Build&& build) const {
+        if (auto snapshot = current_.load(std::memory_order_acquire)) return snapshot;
+        std::lock_guard<std::mutex> guard(write_mutex_);
+        if (auto snapshot = current_.load(std::memory_order_acquire)) return snapshot;
+        std::shared_ptr<const T> snapshot = std::make_shared<const T>(std::forward<Build>(build)());
+        current_.store(snapshot, std::memory_order_release);
+        return snapshot;
+    }
+};
+
+#endif
\ No newline at end of file
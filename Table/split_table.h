@@ -0,0 +1,777 @@
+#ifndef LAB3_SPLIT_TABLE_H
+#define LAB3_SPLIT_TABLE_H
+
+#include "table.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Пара ссылок на ключ и значение элемента SplitTable.
+ *
+ * Заменяет TablePair& там, где ключ и значение хранятся в разных массивах:
+ * поля называются так же, поэтому код вида it->key / (*it).value не меняется.
+ *
+ * @tparam Key Тип ключа
+ * @tparam T Тип значения
+ * @tparam IsConst Флаг константности значения
+ */
+template<typename Key, typename T, bool IsConst>
+struct TablePairRef {
+    const Key& key;                                          ///< Ссылка на ключ
+    std::conditional_t<IsConst, const T&, T&> value;         ///< Ссылка на значение
+
+    /**
+     * @brief Конструктор из ссылок на ключ и значение.
+     * @param k Ключ
+     * @param v Значение
+     */
+    TablePairRef(const Key& k, std::conditional_t<IsConst, const T&, T&> v) noexcept : key(k), value(v) {}
+
+    /**
+     * @brief Преобразование неконстантной пары ссылок в константную.
+     */
+    template<bool WasConst = IsConst, typename = std::enable_if_t<WasConst>>
+    TablePairRef(const TablePairRef<Key, T, false>& other) noexcept : key(other.key), value(other.value) {}
+
+    /**
+     * @brief Оператор доступа к членам (для итератора, возвращающего пару по значению).
+     * @return Указатель на эту пару
+     */
+    const TablePairRef* operator->() const noexcept { return this; }
+
+    /**
+     * @brief Скопировать элемент в самостоятельную пару.
+     * @return Пара с копиями ключа и значения
+     */
+    operator TablePair<Key, T>() const { return TablePair<Key, T>(key, value); }
+};
+
+/**
+ * @brief Итератор SplitTable с поддержкой случайного доступа.
+ *
+ * Хранит указатели на текущий ключ и текущее значение; разыменование
+ * возвращает TablePairRef по значению.
+ *
+ * @tparam Key Тип ключа
+ * @tparam T Тип значения
+ * @tparam IsConst Флаг константности итератора
+ */
+template<typename Key, typename T, bool IsConst>
+class SplitTableIterator {
+private:
+    using ValuePtr = std::conditional_t<IsConst, const T*, T*>;
+    const Key* keys_;   ///< Указатель на текущий ключ
+    ValuePtr values_;   ///< Указатель на текущее значение
+
+    template<typename, typename, bool> friend class SplitTableIterator;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = TablePairRef<Key, T, IsConst>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type;
+    using reference = value_type;
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    SplitTableIterator() noexcept : keys_(nullptr), values_(nullptr) {}
+
+    /**
+     * @brief Конструктор с указателями на ключ и значение.
+     * @param k Указатель на ключ
+     * @param v Указатель на значение
+     */
+    SplitTableIterator(const Key* k, ValuePtr v) noexcept : keys_(k), values_(v) {}
+
+    /**
+     * @brief Преобразование неконстантного итератора в константный.
+     */
+    template<bool WasConst = IsConst, typename = std::enable_if_t<WasConst>>
+    SplitTableIterator(const SplitTableIterator<Key, T, false>& other) noexcept : keys_(other.keys_), values_(other.values_) {}
+
+    /**
+     * @brief Оператор разыменования.
+     * @return Пара ссылок на текущий элемент
+     */
+    reference operator*() const noexcept { return reference(*keys_, *values_); }
+
+    /**
+     * @brief Оператор доступа к членам.
+     * @return Пара ссылок, перенаправляющая -> на себя
+     */
+    pointer operator->() const noexcept { return **this; }
+
+    /**
+     * @brief Получить ключ текущего элемента.
+     * @return Константная ссылка на ключ
+     */
+    const Key& key() const noexcept { return *keys_; }
+
+    /**
+     * @brief Получить указатель на текущий ключ.
+     * @return Указатель в массиве ключей
+     */
+    const Key* key_base() const noexcept { return keys_; }
+
+    /**
+     * @brief Префиксный инкремент.
+     * @return Ссылка на этот итератор
+     */
+    SplitTableIterator& operator++() noexcept { ++keys_; ++values_; return *this; }
+
+    /**
+     * @brief Постфиксный инкремент.
+     * @return Копия итератора до инкремента
+     */
+    SplitTableIterator operator++(int) noexcept { auto tmp = *this; ++*this; return tmp; }
+
+    /**
+     * @brief Префиксный декремент.
+     * @return Ссылка на этот итератор
+     */
+    SplitTableIterator& operator--() noexcept { --keys_; --values_; return *this; }
+
+    /**
+     * @brief Постфиксный декремент.
+     * @return Копия итератора до декремента
+     */
+    SplitTableIterator operator--(int) noexcept { auto tmp = *this; --*this; return tmp; }
+
+    /**
+     * @brief Оператор сдвига вперед.
+     * @param n Количество позиций для сдвига
+     * @return Ссылка на этот итератор
+     */
+    SplitTableIterator& operator+=(difference_type n) noexcept { keys_ += n; values_ += n; return *this; }
+
+    /**
+     * @brief Оператор сдвига назад.
+     * @param n Количество позиций для сдвига
+     * @return Ссылка на этот итератор
+     */
+    SplitTableIterator& operator-=(difference_type n) noexcept { keys_ -= n; values_ -= n; return *this; }
+
+    /**
+     * @brief Оператор разности итераторов.
+     * @param other Другой итератор
+     * @return Расстояние между итераторами
+     */
+    difference_type operator-(const SplitTableIterator& other) const noexcept { return keys_ - other.keys_; }
+
+    /**
+     * @brief Оператор индексирования.
+     * @param n Смещение от текущей позиции
+     * @return Пара ссылок на элемент по смещению
+     */
+    reference operator[](difference_type n) const noexcept { return reference(keys_[n], values_[n]); }
+
+    /**
+     * @brief Оператор равенства.
+     * @param other Другой итератор
+     * @return true если итераторы указывают на один элемент
+     */
+    bool operator==(const SplitTableIterator& other) const noexcept { return keys_ == other.keys_; }
+
+    /**
+     * @brief Оператор сравнения.
+     * @param other Другой итератор
+     * @return Порядок позиций итераторов
+     */
+    auto operator<=>(const SplitTableIterator& other) const noexcept { return keys_ <=> other.keys_; }
+
+    /**
+     * @brief Оператор вычитания.
+     * @param n Количество позиций для сдвига назад
+     * @return Новый итератор
+     */
+    SplitTableIterator operator-(difference_type n) const noexcept { return SplitTableIterator(keys_ - n, values_ - n); }
+
+    /**
+     * @brief Оператор сложения.
+     * @param n Количество позиций для сдвига вперед
+     * @return Новый итератор
+     */
+    SplitTableIterator operator+(difference_type n) const noexcept { return SplitTableIterator(keys_ + n, values_ + n); }
+
+    /**
+     * @brief Оператор сложения (дружественная функция).
+     * @param n Количество позиций для сдвига
+     * @param it Итератор для сдвига
+     * @return Новый итератор
+     */
+    friend SplitTableIterator operator+(difference_type n, const SplitTableIterator& it) noexcept { return it + n; }
+};
+
+static_assert(std::random_access_iterator<SplitTableIterator<int, int, false>>);
+static_assert(std::random_access_iterator<SplitTableIterator<int, int, true>>);
+
+/**
+ * @brief Ассоциативный контейнер с отсортированными ключами, хранящий ключи и значения в разных массивах.
+ *
+ * Раскладка Table "структура массивов": вместо массива TablePair используются два
+ * параллельных массива. Поиск и просмотр одних только ключей (бинарный поиск, lower_bound,
+ * фильтрация по шаблону через keys()) читает только массив ключей, не подтягивая значения
+ * в кэш. Поиск, индекс Эйтцингера и пакетная вставка - те же, что у Table (TableSearchIndex,
+ * table_merge_order); отличается только хранение. Итераторы возвращают TablePairRef -
+ * пару ссылок с полями key и value.
+ *
+ * Память выделяется из std::pmr::memory_resource. Массивы - std::pmr::vector, поэтому
+ * действуют правила стандартных pmr-контейнеров: копия получает ресурс по умолчанию,
+ * присваивание и обмен сохраняют ресурс каждой из таблиц.
+ *
+ * @tparam Key Тип ключа, должен поддерживать операторы сравнения
+ * @tparam T Тип значения
+ * @tparam Compare Компаратор ключей (по умолчанию прозрачный std::less<>)
+ */
+template<typename Key, typename T, typename Compare = std::less<>>
+class SplitTable {
+private:
+    std::pmr::vector<Key> keys_;    ///< Отсортированные ключи
+    std::pmr::vector<T> values_;    ///< Значения в порядке ключей
+    [[no_unique_address]] Compare comp_;  ///< Компаратор ключей
+    TableSearchIndex search_index_;  ///< Режим поиска и индекс для режима Eytzinger
+
+    /// Ключ, заданный значением типа K, допустим для поиска (Key или прозрачный Compare)
+    template<typename K>
+    static constexpr bool lookup_key_v = std::is_same_v<K, Key> || TransparentCompare<Compare>;
+
+    /**
+     * @brief Получить функцию доступа к ключу по позиции (для TableSearchIndex).
+     * @return Функция, возвращающая ключ на позиции i
+     */
+    auto key_at() const noexcept {
+        return [keys = keys_.data()](size_t i) -> const Key& { return keys[i]; };
+    }
+
+    /**
+     * @brief Бинарный поиск позиции для ключа.
+     * @param key Ключ для поиска
+     * @return Позиция, где должен находиться ключ
+     */
+    template<typename K>
+    size_t binary_search(const K& key) const noexcept {
+        return TableSearchIndex::bisect(key_at(), key, 0, keys_.size(), comp_);
+    }
+
+    /**
+     * @brief Найти позицию ключа для операций чтения (через индекс префиксов в режиме Eytzinger).
+     * @param key Ключ для поиска
+     * @return Позиция, где должен находиться ключ
+     */
+    template<typename K>
+    size_t lookup_position(const K& key) const noexcept {
+        return search_index_.template lower_bound<Key>(key_at(), keys_.size(), key, comp_);
+    }
+
+    /**
+     * @brief Проверить, находится ли ключ на указанной позиции.
+     * @param pos Позиция, полученная из binary_search
+     * @param key Ключ для сравнения
+     * @return true если ключ найден на позиции, иначе false
+     */
+    template<typename K>
+    bool key_at_position(size_t pos, const K& key) const noexcept {
+        return pos < keys_.size() && !comp_(key, keys_[pos]);
+    }
+
+    /**
+     * @brief Вставить ключ и значение на позицию, сохраняя согласованность массивов.
+     * @param pos Позиция вставки
+     * @param key Ключ
+     * @param value Значение
+     */
+    template<typename K, typename V>
+    void insert_at(size_t pos, K&& key, V&& value) {
+        keys_.insert(keys_.begin() + pos, std::forward<K>(key));
+        try {
+            values_.insert(values_.begin() + pos, std::forward<V>(value));
+        } catch (...) {
+            keys_.erase(keys_.begin() + pos);
+            throw;
+        }
+        search_index_.invalidate();
+    }
+
+    /**
+     * @brief Удалить диапазон позиций из обоих массивов.
+     * @param first Начало диапазона
+     * @param last Конец диапазона (не включительно)
+     */
+    void erase_positions(size_t first, size_t last) {
+        keys_.erase(keys_.begin() + first, keys_.begin() + last);
+        values_.erase(values_.begin() + first, values_.begin() + last);
+        search_index_.invalidate();
+    }
+
+    /**
+     * @brief Итератор на позицию.
+     * @param pos Позиция
+     * @return Итератор
+     */
+    auto iterator_at(size_t pos) noexcept { return SplitTableIterator<Key, T, false>(keys_.data() + pos, values_.data() + pos); }
+
+    /**
+     * @brief Константный итератор на позицию.
+     * @param pos Позиция
+     * @return Константный итератор
+     */
+    auto iterator_at(size_t pos) const noexcept { return SplitTableIterator<Key, T, true>(keys_.data() + pos, values_.data() + pos); }
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = TablePair<Key, T>;
+    using reference = TablePairRef<Key, T, false>;
+    using const_reference = TablePairRef<Key, T, true>;
+    using iterator = SplitTableIterator<Key, T, false>;
+    using const_iterator = SplitTableIterator<Key, T, true>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Конструктор по умолчанию.
+     */
+    SplitTable() noexcept : SplitTable(std::pmr::get_default_resource()) {}
+
+    /**
+     * @brief Конструктор с указанием ресурса памяти.
+     * @param resource Ресурс, из которого выделяются массивы ключей и значений
+     */
+    explicit SplitTable(std::pmr::memory_resource* resource) noexcept : keys_(resource), values_(resource), comp_() {}
+
+    /**
+     * @brief Конструктор из списка инициализации.
+     * @param init Список пар ключ-значение
+     * @param resource Ресурс, из которого выделяются массивы
+     */
+    SplitTable(std::initializer_list<value_type> init, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : SplitTable(resource) {
+        insert_bulk(init.begin(), init.end());
+    }
+
+    /**
+     * @brief Конструктор копирования.
+     * @param other Таблица для копирования
+     */
+    SplitTable(const SplitTable& other) : SplitTable(other, std::pmr::get_default_resource()) {}
+
+    /**
+     * @brief Конструктор копирования с указанием ресурса памяти.
+     * @param other Таблица для копирования
+     * @param resource Ресурс, из которого выделяются массивы
+     */
+    SplitTable(const SplitTable& other, std::pmr::memory_resource* resource)
+        : keys_(other.keys_, resource), values_(other.values_, resource), comp_(other.comp_) {
+        set_search_mode(other.search_mode());
+    }
+
+    /**
+     * @brief Конструктор перемещения.
+     * @param other Таблица для перемещения
+     */
+    SplitTable(SplitTable&& other) noexcept
+        : keys_(std::move(other.keys_)), values_(std::move(other.values_)), comp_(std::move(other.comp_)),
+          search_index_(std::move(other.search_index_)) {
+        other.keys_.clear();
+        other.values_.clear();
+    }
+
+    /**
+     * @brief Оператор копирующего присваивания.
+     * @param other Таблица для копирования
+     * @return Ссылка на эту таблицу
+     */
+    SplitTable& operator=(const SplitTable& other) {
+        if (this == &other) return *this;
+        SplitTable temp(other, get_resource());
+        swap(temp);
+        return *this;
+    }
+
+    /**
+     * @brief Оператор перемещающего присваивания.
+     * @param other Таблица для перемещения
+     * @return Ссылка на эту таблицу
+     */
+    SplitTable& operator=(SplitTable&& other) {
+        if (this == &other) return *this;
+        keys_ = std::move(other.keys_);
+        values_ = std::move(other.values_);
+        comp_ = std::move(other.comp_);
+        search_index_ = std::move(other.search_index_);
+        other.keys_.clear();
+        other.values_.clear();
+        return *this;
+    }
+
+    /**
+     * @brief Получить итератор на начало.
+     * @return Итератор на первый элемент
+     */
+    iterator begin() noexcept { return iterator_at(0); }
+
+    /**
+     * @brief Получить константный итератор на начало.
+     * @return Константный итератор на первый элемент
+     */
+    const_iterator begin() const noexcept { return iterator_at(0); }
+
+    /**
+     * @brief Получить итератор на конец.
+     * @return Итератор за последним элементом
+     */
+    iterator end() noexcept { return iterator_at(keys_.size()); }
+
+    /**
+     * @brief Получить константный итератор на конец.
+     * @return Константный итератор за последним элементом
+     */
+    const_iterator end() const noexcept { return iterator_at(keys_.size()); }
+
+    /**
+     * @brief Получить обратный итератор на начало.
+     * @return Обратный итератор на последний элемент
+     */
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    /**
+     * @brief Получить обратный итератор на конец.
+     * @return Обратный итератор перед первым элементом
+     */
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    /**
+     * @brief Получить все ключи в порядке сортировки.
+     * @return Непрерывный массив ключей (действителен до изменения таблицы)
+     */
+    std::span<const Key> keys() const noexcept { return {keys_.data(), keys_.size()}; }
+
+    /**
+     * @brief Получить все значения в порядке ключей.
+     * @return Непрерывный массив значений (действителен до изменения таблицы)
+     */
+    std::span<T> values() noexcept { return {values_.data(), values_.size()}; }
+
+    /**
+     * @brief Получить все значения в порядке ключей (константная версия).
+     * @return Непрерывный массив значений
+     */
+    std::span<const T> values() const noexcept { return {values_.data(), values_.size()}; }
+
+    /**
+     * @brief Проверить, пуста ли таблица.
+     * @return true если таблица пуста
+     */
+    bool empty() const noexcept { return keys_.empty(); }
+
+    /**
+     * @brief Получить количество элементов.
+     * @return Количество элементов
+     */
+    size_type size() const noexcept { return keys_.size(); }
+
+    /**
+     * @brief Очистить таблицу.
+     */
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+        search_index_.invalidate();
+    }
+
+    /**
+     * @brief Вставить пару ключ-значение.
+     * @param value Пара для вставки
+     * @return Пара из итератора и флага успеха
+     */
+    std::pair<iterator, bool> insert(value_type value) {
+        size_t pos = binary_search(value.key);
+        if (key_at_position(pos, value.key)) return {iterator_at(pos), false};
+        insert_at(pos, std::move(value.key), std::move(value.value));
+        return {iterator_at(pos), true};
+    }
+
+    /**
+     * @brief Пакетная вставка элементов из диапазона (см. Table::insert_bulk).
+     * @param first Итератор начала (элементы приводимы к value_type)
+     * @param last Итератор конца
+     * @return Количество вставленных элементов
+     */
+    template<class InputIt>
+    size_type insert_bulk(InputIt first, InputIt last) {
+        std::vector<value_type> staged(first, last);
+        std::vector<size_t> order;
+        size_t size = keys_.size();
+        size_t added = table_merge_order(staged, key_at(), size, comp_, order);
+        if (added == 0) return 0;
+
+        std::pmr::vector<Key> keys(keys_.get_allocator());
+        std::pmr::vector<T> values(values_.get_allocator());
+        keys.reserve(size + added);
+        values.reserve(size + added);
+        size_t i = 0;
+        for (size_t idx : order) {
+            value_type& item = staged[idx];
+            for (; i < size && comp_(keys_[i], item.key); i++) {
+                keys.push_back(std::move_if_noexcept(keys_[i]));
+                values.push_back(std::move_if_noexcept(values_[i]));
+            }
+            if (key_at_position(i, item.key)) continue;
+            keys.push_back(std::move(item.key));
+            values.push_back(std::move(item.value));
+        }
+        for (; i < size; i++) {
+            keys.push_back(std::move_if_noexcept(keys_[i]));
+            values.push_back(std::move_if_noexcept(values_[i]));
+        }
+        keys_.swap(keys);
+        values_.swap(values);
+        search_index_.invalidate();
+        return added;
+    }
+
+    /**
+     * @brief Вставить или присвоить значение.
+     * @param key Ключ
+     * @param value Значение
+     * @return Пара из итератора и флага вставки
+     */
+    template<typename K, typename V>
+    std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+        size_t pos = binary_search(key);
+        if (key_at_position(pos, key)) {
+            values_[pos] = std::forward<V>(value);
+            return {iterator_at(pos), false};
+        }
+        insert_at(pos, Key(std::forward<K>(key)), std::forward<V>(value));
+        return {iterator_at(pos), true};
+    }
+
+    /**
+     * @brief Попытаться создать элемент с перемещением ключа.
+     * @param key Ключ
+     * @param args Аргументы для конструктора значения
+     * @return Пара из итератора и флага успеха
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        size_t pos = binary_search(key);
+        if (key_at_position(pos, key)) return {iterator_at(pos), false};
+        insert_at(pos, std::move(key), T(std::forward<Args>(args)...));
+        return {iterator_at(pos), true};
+    }
+
+    /**
+     * @brief Удалить элемент по итератору.
+     * @param pos Итератор на элемент
+     * @return Итератор на следующий элемент
+     */
+    iterator erase(const_iterator pos) {
+        size_t index = pos.key_base() - keys_.data();
+        if (index >= keys_.size()) return end();
+        erase_positions(index, index + 1);
+        return iterator_at(index);
+    }
+
+    /**
+     * @brief Удалить диапазон элементов.
+     * @param first Итератор начала
+     * @param last Итератор конца
+     * @return Итератор на элемент после удаленного диапазона
+     */
+    iterator erase(const_iterator first, const_iterator last) {
+        size_t start_idx = first.key_base() - keys_.data();
+        size_t end_idx = last.key_base() - keys_.data();
+        if (start_idx < end_idx) erase_positions(start_idx, end_idx);
+        return iterator_at(start_idx);
+    }
+
+    /**
+     * @brief Удалить элемент по ключу.
+     * @param key Ключ (Key или значение, сравнимое с ним через прозрачный Compare)
+     * @return Количество удаленных элементов (0 или 1)
+     */
+    template<typename K = Key> requires lookup_key_v<K> &&
+        (!std::is_convertible_v<const K&, const_iterator>)
+    size_type erase(const K& key) {
+        size_t pos = binary_search(key);
+        if (!key_at_position(pos, key)) return 0;
+        erase_positions(pos, pos + 1);
+        return 1;
+    }
+
+    /**
+     * @brief Обменять содержимое с другой таблицей.
+     *
+     * При одинаковых ресурсах памяти выполняется за O(1), иначе элементы перемещаются.
+     *
+     * @param other Другая таблица
+     */
+    void swap(SplitTable& other) {
+        if (get_resource() != other.get_resource()) {
+            SplitTable temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+            return;
+        }
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        std::swap(comp_, other.comp_);
+        search_index_.swap(other.search_index_);
+    }
+
+    /**
+     * @brief Найти элемент по ключу.
+     * @param key Ключ (Key или значение, сравнимое с ним через прозрачный Compare)
+     * @return Итератор на элемент или end()
+     */
+    template<typename K = Key> requires lookup_key_v<K>
+    iterator find(const K& key) noexcept {
+        size_t pos = lookup_position(key);
+        return key_at_position(pos, key) ? iterator_at(pos) : end();
+    }
+
+    /**
+     * @brief Найти элемент по ключу (константная версия).
+     * @param key Ключ
+     * @return Константный итератор на элемент или end()
+     */
+    template<typename K = Key> requires lookup_key_v<K>
+    const_iterator find(const K& key) const noexcept {
+        size_t pos = lookup_position(key);
+        return key_at_position(pos, key) ? iterator_at(pos) : end();
+    }
+
+    /**
+     * @brief Проверить наличие ключа.
+     * @param key Ключ
+     * @return true если ключ присутствует
+     */
+    template<typename K = Key> requires lookup_key_v<K>
+    bool contains(const K& key) const noexcept {
+        return key_at_position(lookup_position(key), key);
+    }
+
+    /**
+     * @brief Найти первый элемент с ключом не меньше заданного.
+     * @param key Ключ
+     * @return Константный итератор на элемент или end()
+     */
+    template<typename K = Key> requires lookup_key_v<K>
+    const_iterator lower_bound(const K& key) const noexcept { return iterator_at(lookup_position(key)); }
+
+    /**
+     * @brief Найти первый элемент с ключом больше заданного.
+     * @param key Ключ
+     * @return Константный итератор на элемент или end()
+     */
+    template<typename K = Key> requires lookup_key_v<K>
+    const_iterator upper_bound(const K& key) const noexcept {
+        size_t pos = lookup_position(key);
+        return iterator_at(key_at_position(pos, key) ? pos + 1 : pos);
+    }
+
+    /**
+     * @brief Получить диапазон элементов с ключом.
+     * @param key Ключ
+     * @return Пара константных итераторов [lower_bound, upper_bound)
+     */
+    template<typename K = Key> requires lookup_key_v<K>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const noexcept {
+        size_t pos = lookup_position(key);
+        return {iterator_at(pos), iterator_at(key_at_position(pos, key) ? pos + 1 : pos)};
+    }
+
+    /**
+     * @brief Доступ к элементу по ключу с проверкой.
+     * @param key Ключ
+     * @return Ссылка на значение
+     * @throws std::out_of_range если ключ не найден
+     */
+    template<typename K = Key> requires lookup_key_v<K>
+    T& at(const K& key) {
+        size_t pos = lookup_position(key);
+        if (!key_at_position(pos, key)) throw std::out_of_range("SplitTable::at: key not found");
+        return values_[pos];
+    }
+
+    /**
+     * @brief Доступ к элементу по ключу с проверкой (константная версия).
+     * @param key Ключ
+     * @return Константная ссылка на значение
+     * @throws std::out_of_range если ключ не найден
+     */
+    template<typename K = Key> requires lookup_key_v<K>
+    const T& at(const K& key) const {
+        size_t pos = lookup_position(key);
+        if (!key_at_position(pos, key)) throw std::out_of_range("SplitTable::at: key not found");
+        return values_[pos];
+    }
+
+    /**
+     * @brief Доступ к элементу по ключу с вставкой при отсутствии.
+     * @param key Ключ
+     * @return Ссылка на значение
+     */
+    T& operator[](Key key) {
+        size_t pos = binary_search(key);
+        if (!key_at_position(pos, key)) insert_at(pos, std::move(key), T());
+        return values_[pos];
+    }
+
+    /**
+     * @brief Выбрать режим поиска (см. Table::set_search_mode).
+     * @param mode Новый режим
+     */
+    void set_search_mode(TableSearchMode mode) noexcept {
+        if (mode == search_mode()) return;
+        search_index_.set_mode(mode);
+    }
+
+    /**
+     * @brief Получить текущий режим поиска.
+     * @return Режим поиска
+     */
+    TableSearchMode search_mode() const noexcept {
+        return search_index_.mode();
+    }
+
+    /**
+     * @brief Получить ресурс памяти таблицы.
+     * @return Ресурс, из которого выделяются массивы
+     */
+    std::pmr::memory_resource* get_resource() const noexcept { return keys_.get_allocator().resource(); }
+};
+
+/**
+ * @brief Оператор равенства.
+ * @param lhs Левая таблица
+ * @param rhs Правая таблица
+ * @return true если таблицы равны
+ */
+template<typename Key, typename T, typename Compare>
+bool operator==(const SplitTable<Key, T, Compare>& lhs, const SplitTable<Key, T, Compare>& rhs) {
+    return std::ranges::equal(lhs.keys(), rhs.keys()) && std::ranges::equal(lhs.values(), rhs.values());
+}
+
+/**
+ * @brief std::swap для SplitTable.
+ */
+template<typename Key, typename T, typename Compare>
+void swap(SplitTable<Key, T, Compare>& lhs, SplitTable<Key, T, Compare>& rhs) { lhs.swap(rhs); }
+
+#endif
\ No newline at end of file
@@ -4,12 +4,96 @@
 #include <algorithm>
 #include <cstddef>
 #include "iterator.h"
+#include "search_index.h"
+#include "relocation.h"
 #include <initializer_list>
 #include <iterator>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <limits>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <vector>
+
+/**
+ * @brief Компаратор, допускающий сравнение ключа с объектами других типов.
+ *
+ * Как и в std::map, гетерогенный поиск включается только при наличии
+ * вложенного типа Compare::is_transparent.
+ */
+template<typename Compare>
+concept TransparentCompare = requires { typename Compare::is_transparent; };
+
+/**
+ * @brief Встроенный буфер для первых N элементов Table.
+ *
+ * Адрес буфера берется статической функцией по адресу хранилища, а не методом объекта:
+ * Table получает его в списке инициализации, до того как создан сам член-буфер.
+ *
+ * @tparam Pair Тип хранимой пары
+ * @tparam N Количество элементов
+ */
+template<typename Pair, size_t N>
+struct TableInlineStorage {
+    alignas(Pair) unsigned char bytes[N * sizeof(Pair)];  ///< Неинициализированная память под N пар
+
+    /**
+     * @brief Получить указатель на начало буфера.
+     * @param storage Адрес хранилища
+     * @return Указатель на первую пару
+     */
+    static Pair* data(TableInlineStorage* storage) noexcept { return reinterpret_cast<Pair*>(storage); }
+
+    /**
+     * @brief Получить указатель на начало буфера (константная версия).
+     * @param storage Адрес хранилища
+     * @return Указатель на первую пару
+     */
+    static const Pair* data(const TableInlineStorage* storage) noexcept { return reinterpret_cast<const Pair*>(storage); }
+};
+
+/**
+ * @brief Пустая специализация: без встроенного буфера таблица всегда хранит элементы в куче.
+ */
+template<typename Pair>
+struct TableInlineStorage<Pair, 0> {
+    static Pair* data(TableInlineStorage*) noexcept { return nullptr; }
+    static const Pair* data(const TableInlineStorage*) noexcept { return nullptr; }
+};
+
+/**
+ * @brief Упорядочить пакет новых элементов для слияния с отсортированной таблицей.
+ *
+ * Общая часть пакетной вставки Table и SplitTable: пакет сортируется один раз
+ * (уже отсортированный вход не сортируется), повторяющиеся ключи отбрасываются.
+ *
+ * @param staged Новые элементы в произвольном порядке
+ * @param keyAt Функция, возвращающая ключ таблицы на позиции i
+ * @param size Количество элементов таблицы
+ * @param comp Компаратор ключей
+ * @param order Сюда записываются индексы элементов staged по возрастанию ключа (из повторяющихся остается первый)
+ * @return Количество ключей пакета, которых нет в таблице
+ */
+template<typename Key, typename T, typename KeyAt, typename Compare>
+size_t table_merge_order(const std::vector<TablePair<Key, T>>& staged, KeyAt keyAt, size_t size, const Compare& comp,
+                         std::vector<size_t>& order) {
+    order.resize(staged.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    auto less = [&](size_t a, size_t b) { return comp(staged[a].key, staged[b].key); };
+    if (!std::is_sorted(order.begin(), order.end(), less)) std::stable_sort(order.begin(), order.end(), less);
+    order.erase(std::unique(order.begin(), order.end(), [&](size_t a, size_t b) { return !less(a, b); }), order.end());
+
+    size_t added = 0;
+    for (size_t i = 0, j = 0; j < order.size(); j++) {
+        const Key& key = staged[order[j]].key;
+        while (i < size && comp(keyAt(i), key)) i++;
+        if (i == size || comp(key, keyAt(i))) added++;
+    }
+    return added;
+}
 
 /**
  * @brief Ассоциативный контейнер с отсортированными ключами.
@@ -19,49 +103,241 @@
  *
  * @tparam Key Тип ключа, должен поддерживать операторы сравнения
  * @tparam T Тип значения
+ * @tparam Compare Компаратор ключей (по умолчанию прозрачный std::less<>)
+ * @tparam InlineCapacity Количество элементов, хранимых внутри объекта без выделения памяти в куче
+ *
+ * Память под элементы выделяется через std::pmr::memory_resource (по умолчанию -
+ * std::pmr::get_default_resource()). Как и у std::pmr-контейнеров, копия таблицы
+ * получает ресурс по умолчанию, а копирующее присваивание сохраняет ресурс приемника;
+ * при перемещении и обмене ресурс переходит вместе с памятью.
+ *
+ * Если ключ и значение тривиально перемещаемы (см. TriviallyRelocatable), сдвиги при
+ * вставке и удалении и перенос элементов при росте массива выполняются одним memmove.
  */
-template<typename Key, typename T>
+template<typename Key, typename T, typename Compare = std::less<>, size_t InlineCapacity = 0>
 class Table {
 private:
     TablePair<Key, T>* data_;   ///< Указатель на массив пар ключ-значение
     size_t size_;               ///< Текущее количество элементов
     size_t capacity_;           ///< Выделенная емкость массива
+    std::pmr::memory_resource* resource_;  ///< Источник памяти для массива
+    [[no_unique_address]] Compare comp_;  ///< Компаратор ключей
+    TableSearchIndex search_index_;  ///< Режим поиска и индекс для режима Eytzinger
+    [[no_unique_address]] TableInlineStorage<TablePair<Key, T>, InlineCapacity> inline_;  ///< Встроенный буфер
 
     static constexpr size_t INITIAL_CAPACITY = 16;  ///< Начальная емкость
     static constexpr size_t GROWTH_FACTOR = 2;      ///< Коэффициент роста
+    static constexpr bool NOTHROW_RELOCATE = InlineCapacity == 0 ||
+        std::is_nothrow_move_constructible_v<TablePair<Key, T>>;  ///< Перемещение таблицы не бросает исключений
+    static constexpr bool RELOCATE_BYTES = trivially_relocatable_v<TablePair<Key, T>>;  ///< Элементы переносятся через memmove
+
+    /**
+     * @brief Получить адрес встроенного буфера.
+     * @return Указатель на первую пару буфера (nullptr, если InlineCapacity == 0)
+     */
+    TablePair<Key, T>* inline_data() noexcept {
+        return TableInlineStorage<TablePair<Key, T>, InlineCapacity>::data(std::addressof(inline_));
+    }
+
+    /**
+     * @brief Получить адрес встроенного буфера (константная версия).
+     * @return Указатель на первую пару буфера (nullptr, если InlineCapacity == 0)
+     */
+    const TablePair<Key, T>* inline_data() const noexcept {
+        return TableInlineStorage<TablePair<Key, T>, InlineCapacity>::data(std::addressof(inline_));
+    }
+
+    /**
+     * @brief Проверить, хранятся ли элементы во встроенном буфере.
+     * @return true если data_ указывает на встроенный буфер
+     */
+    bool is_inline() const noexcept {
+        return InlineCapacity > 0 && data_ == inline_data();
+    }
+
+    /**
+     * @brief Освободить буфер в куче, если он используется (элементы должны быть уничтожены).
+     */
+    void release_storage() noexcept {
+        if (!is_inline() && data_) deallocate(data_, capacity_);
+    }
+
+    /**
+     * @brief Выделить неинициализированный массив пар через ресурс памяти.
+     * @param n Количество пар
+     * @return Указатель на массив
+     */
+    TablePair<Key, T>* allocate(size_t n) {
+        return static_cast<TablePair<Key, T>*>(resource_->allocate(n * sizeof(TablePair<Key, T>), alignof(TablePair<Key, T>)));
+    }
+
+    /**
+     * @brief Вернуть массив пар ресурсу памяти.
+     * @param p Указатель на массив
+     * @param n Количество пар, под которое он выделялся
+     */
+    void deallocate(TablePair<Key, T>* p, size_t n) noexcept {
+        resource_->deallocate(p, n * sizeof(TablePair<Key, T>), alignof(TablePair<Key, T>));
+    }
+
+    /**
+     * @brief Забрать содержимое другой таблицы; эта таблица должна быть пустой и использовать встроенный буфер.
+     * @param other Таблица-источник, остается пустой
+     */
+    void take_contents(Table& other) noexcept(NOTHROW_RELOCATE) {
+        if (other.is_inline()) {
+            if constexpr (RELOCATE_BYTES) {
+                relocate_bytes(data_, other.data_, other.size_);
+                size_ = other.size_;
+                other.size_ = 0;
+            } else if constexpr (NOTHROW_RELOCATE) {
+                for (; size_ < other.size_; size_++) {
+                    new (&data_[size_]) TablePair<Key, T>(std::move(other.data_[size_]));
+                }
+            } else {
+                try {
+                    for (; size_ < other.size_; size_++) {
+                        new (&data_[size_]) TablePair<Key, T>(std::move_if_noexcept(other.data_[size_]));
+                    }
+                } catch (...) {
+                    clear();
+                    throw;
+                }
+            }
+            other.clear();
+            return;
+        }
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = other.inline_data();
+        other.size_ = 0;
+        other.capacity_ = InlineCapacity;
+    }
+
+    /**
+     * @brief Получить функцию доступа к ключу по позиции (для TableSearchIndex).
+     * @return Функция, возвращающая ключ на позиции i
+     */
+    auto key_at() const noexcept {
+        return [this](size_t i) -> const Key& { return data_[i].key; };
+    }
 
     /**
      * @brief Бинарный поиск позиции для ключа.
-     * @param key Ключ для поиска
+     * @param key Ключ для поиска (Key или тип, сравнимый с ним через Compare)
      * @return Позиция, где должен находиться ключ
      */
-    size_t binary_search(const Key& key) const noexcept {
-        size_t left = 0, right = size_;
-        while (left < right) {
-            size_t mid = left + (right - left) / 2;
-            if (data_[mid].key < key) left = mid + 1;
-            else right = mid;
-        }
-        return left;
+    template<typename K>
+    size_t binary_search(const K& key) const noexcept {
+        return TableSearchIndex::bisect(key_at(), key, 0, size_, comp_);
     }
 
     /**
      * @brief Проверить, находится ли ключ на указанной позиции.
-     * @param pos Позиция для проверки
+     * @param pos Позиция, полученная из binary_search
      * @param key Ключ для сравнения
      * @return true если ключ найден на позиции, иначе false
      */
-    bool key_at_position(size_t pos, const Key& key) const noexcept {
-        return pos < size_ && data_[pos].key == key;
+    template<typename K>
+    bool key_at_position(size_t pos, const K& key) const noexcept {
+        return pos < size_ && !comp_(key, data_[pos].key);
+    }
+
+    /**
+     * @brief Найти позицию ключа для операций чтения (через индекс префиксов в режиме Eytzinger).
+     * @param key Ключ для поиска
+     * @return Позиция, где должен находиться ключ
+     */
+    template<typename K>
+    size_t lookup_position(const K& key) const noexcept {
+        return search_index_.template lower_bound<Key>(key_at(), size_, key, comp_);
+    }
+
+    /**
+     * @brief Слить набор новых элементов с таблицей.
+     * @param staged Новые элементы в произвольном порядке (могут быть перемещены)
+     * @return Количество вставленных элементов
+     */
+    size_t merge_staged(std::vector<TablePair<Key, T>>& staged) {
+        std::vector<size_t> order;
+        size_t added = table_merge_order(staged, key_at(), size_, comp_, order);
+        if (added == 0) return 0;
+
+        size_t new_size = size_ + added;
+        if constexpr (std::is_nothrow_move_constructible_v<TablePair<Key, T>>) {
+            if (new_size <= capacity_) {
+                size_t i = size_, out = new_size;
+                for (size_t j = order.size(); j > 0 && out > i; j--) {
+                    TablePair<Key, T>& item = staged[order[j - 1]];
+                    for (; i > 0 && comp_(item.key, data_[i - 1].key); i--) {
+                        new (&data_[--out]) TablePair<Key, T>(std::move(data_[i - 1]));
+                        data_[i - 1].~TablePair<Key, T>();
+                    }
+                    if (i > 0 && !comp_(data_[i - 1].key, item.key)) continue;
+                    new (&data_[--out]) TablePair<Key, T>(std::move(item));
+                }
+                size_ = new_size;
+                search_index_.invalidate();
+                return added;
+            }
+        }
+        size_t new_cap = (capacity_ == 0) ? INITIAL_CAPACITY : capacity_;
+        while (new_cap < new_size) new_cap *= GROWTH_FACTOR;
+        TablePair<Key, T>* new_data = allocate(new_cap);
+        size_t constructed = 0;
+        try {
+            size_t i = 0;
+            for (size_t idx : order) {
+                TablePair<Key, T>& item = staged[idx];
+                for (; i < size_ && comp_(data_[i].key, item.key); i++, constructed++) {
+                    new (&new_data[constructed]) TablePair<Key, T>(std::move_if_noexcept(data_[i]));
+                }
+                if (key_at_position(i, item.key)) continue;
+                new (&new_data[constructed]) TablePair<Key, T>(std::move_if_noexcept(item));
+                constructed++;
+            }
+            for (; i < size_; i++, constructed++) {
+                new (&new_data[constructed]) TablePair<Key, T>(std::move_if_noexcept(data_[i]));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < constructed; i++) {
+                new_data[i].~TablePair<Key, T>();
+            }
+            deallocate(new_data, new_cap);
+            throw;
+        }
+        for (size_t i = 0; i < size_; i++) {
+            data_[i].~TablePair<Key, T>();
+        }
+        release_storage();
+        data_ = new_data;
+        size_ = new_size;
+        capacity_ = new_cap;
+        search_index_.invalidate();
+        return added;
     }
 
     /**
      * @brief Безопасное перераспределение памяти.
+     *
+     * Тривиально перемещаемые элементы переносятся одним копированием памяти.
+     *
      * @param new_capacity Новая емкость
      */
     void safe_reallocate(size_t new_capacity) {
+        if (new_capacity < InlineCapacity) new_capacity = InlineCapacity;
         if (new_capacity == capacity_) return;
-        TablePair<Key, T>* new_data = static_cast<TablePair<Key, T>*>(::operator new(new_capacity * sizeof(TablePair<Key, T>)));
+        bool to_inline = InlineCapacity > 0 && new_capacity == InlineCapacity;
+        TablePair<Key, T>* new_data = to_inline ? inline_data()
+            : allocate(new_capacity);
+        if constexpr (RELOCATE_BYTES) {
+            relocate_bytes(new_data, data_, size_);
+            release_storage();
+            data_ = new_data;
+            capacity_ = new_capacity;
+            return;
+        }
         size_t constructed = 0;
         try {
             for (; constructed < size_; constructed++) {
@@ -71,13 +347,13 @@ private:
             for (size_t i = 0; i < constructed; i++) {
                 new_data[i].~TablePair<Key, T>();
             }
-            ::operator delete(new_data);
+            if (!to_inline) deallocate(new_data, new_capacity);
             throw;
         }
         for (size_t i = 0; i < size_; i++) {
             data_[i].~TablePair<Key, T>();
         }
-        ::operator delete(data_);
+        release_storage();
         data_ = new_data;
         capacity_ = new_capacity;
     }
@@ -96,10 +372,19 @@ private:
 
     /**
      * @brief Сдвинуть элементы вправо начиная с позиции, освобождая место для вставки.
+     *
+     * Индекс префиксов помечается устаревшим, поэтому вставляющим операциям
+     * больше ничего делать с ним не нужно.
+     *
      * @param pos Позиция, с которой начинается сдвиг
      */
     void shift_right(size_t pos) {
         ensure_capacity(size_ + 1);
+        search_index_.invalidate();
+        if constexpr (RELOCATE_BYTES) {
+            relocate_bytes(data_ + pos + 1, data_ + pos, size_ - pos);
+            return;
+        }
         for (size_t i = size_; i > pos; --i) {
             new (&data_[i]) TablePair<Key, T>(std::move_if_noexcept(data_[i - 1]));
             data_[i - 1].~TablePair<Key, T>();
@@ -112,11 +397,16 @@ private:
      */
     void shift_left(size_t pos) noexcept {
         data_[pos].~TablePair<Key, T>();
-        for (size_t i = pos; i < size_ - 1; i++) {
-            new (&data_[i]) TablePair<Key, T>(std::move_if_noexcept(data_[i + 1]));
-            data_[i + 1].~TablePair<Key, T>();
+        if constexpr (RELOCATE_BYTES) {
+            relocate_bytes(data_ + pos, data_ + pos + 1, size_ - pos - 1);
+        } else {
+            for (size_t i = pos; i < size_ - 1; i++) {
+                new (&data_[i]) TablePair<Key, T>(std::move_if_noexcept(data_[i + 1]));
+                data_[i + 1].~TablePair<Key, T>();
+            }
         }
         size_--;
+        search_index_.invalidate();
     }
 
 public:
@@ -133,34 +423,44 @@ public:
     /**
      * @brief Конструктор по умолчанию.
      */
-    Table() noexcept : data_(nullptr), size_(0), capacity_(0) {}
+    Table() noexcept : Table(std::pmr::get_default_resource()) {}
+
+    /**
+     * @brief Конструктор с указанием ресурса памяти.
+     * @param resource Ресурс, из которого выделяется массив элементов
+     */
+    explicit Table(std::pmr::memory_resource* resource) noexcept
+        : data_(inline_data()), size_(0), capacity_(InlineCapacity), resource_(resource), comp_() {}
 
     /**
      * @brief Конструктор из списка инициализации.
      * @param init Список пар ключ-значение
      */
-    Table(std::initializer_list<value_type> init) : data_(nullptr), size_(0), capacity_(0) {
-        try {
-            reserve(init.size());
-            for (const auto& p : init) {
-                insert(p);
-            }
-        } catch (...) {
-            clear();
-            ::operator delete(data_);
-            throw;
-        }
+    Table(std::initializer_list<value_type> init, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : data_(inline_data()), size_(0), capacity_(InlineCapacity), resource_(resource) {
+        insert_bulk(init.begin(), init.end());
     }
 
     /**
      * @brief Конструктор копирования.
      * @param other Таблица для копирования
      */
-    Table(const Table& other) : data_(nullptr), size_(0), capacity_(0) {
+    Table(const Table& other) : Table(other, std::pmr::get_default_resource()) {}
+
+    /**
+     * @brief Конструктор копирования с указанием ресурса памяти.
+     * @param other Таблица для копирования
+     * @param resource Ресурс, из которого выделяется массив элементов
+     */
+    Table(const Table& other, std::pmr::memory_resource* resource)
+        : data_(inline_data()), size_(0), capacity_(InlineCapacity), resource_(resource), comp_(other.comp_) {
+        set_search_mode(other.search_mode());
         if (other.size_ > 0) {
             try {
-                data_ = static_cast<TablePair<Key, T>*>(::operator new(other.size_ * sizeof(TablePair<Key, T>)));
-                capacity_ = other.size_;
+                if (other.size_ > InlineCapacity) {
+                    data_ = allocate(other.size_);
+                    capacity_ = other.size_;
+                }
                 for (; size_ < other.size_; size_++) {
                     new (&data_[size_]) TablePair<Key, T>(other.data_[size_]);
                 }
@@ -168,20 +468,21 @@ public:
                 for (size_t i = 0; i < size_; i++) {
                     data_[i].~TablePair<Key, T>();
                 }
-                ::operator delete(data_);
+                release_storage();
                 throw;
             }
         }
+        search_index_.invalidate();
     }
 
     /**
      * @brief Конструктор перемещения.
      * @param other Таблица для перемещения
      */
-    Table(Table&& other) noexcept : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
-        other.data_ = nullptr;
-        other.size_ = 0;
-        other.capacity_ = 0;
+    Table(Table&& other) noexcept(NOTHROW_RELOCATE)
+        : data_(inline_data()), size_(0), capacity_(InlineCapacity), resource_(other.resource_), comp_(other.comp_),
+          search_index_(std::move(other.search_index_)) {
+        take_contents(other);
     }
 
     /**
@@ -190,21 +491,16 @@ public:
      * @param last Итератор конца
      */
     template<class InputIt>
-    Table(InputIt first, InputIt last) : data_(nullptr), size_(0), capacity_(0) {
-        if constexpr (std::is_convertible_v<typename std::iterator_traits<InputIt>::iterator_category, std::random_access_iterator_tag>) {
-            reserve(std::distance(first, last));
-        } else reserve(8);
-        try {
-            for (; first != last; first++) {
-                insert(value_type(first->first, first->second));
-            }
-        } catch (...) {
-            clear();
-            ::operator delete(data_);
-            data_ = nullptr;
-            capacity_ = 0;
-            throw;
+    Table(InputIt first, InputIt last, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : data_(inline_data()), size_(0), capacity_(InlineCapacity), resource_(resource) {
+        std::vector<value_type> staged;
+        if constexpr (std::is_convertible_v<typename std::iterator_traits<InputIt>::iterator_category, std::forward_iterator_tag>) {
+            staged.reserve(std::distance(first, last));
+        }
+        for (; first != last; first++) {
+            staged.emplace_back(first->first, first->second);
         }
+        merge_staged(staged);
     }
 
     /**
@@ -214,7 +510,7 @@ public:
      */
     Table& operator=(const Table& other) {
         if (this == &other) return *this;
-        Table temp(other);
+        Table temp(other, resource_);
         swap(temp);
         return *this;
     }
@@ -224,16 +520,16 @@ public:
      * @param other Таблица для перемещения
      * @return Ссылка на эту таблицу
      */
-    Table& operator=(Table&& other) noexcept {
+    Table& operator=(Table&& other) noexcept(NOTHROW_RELOCATE) {
         if (this == &other) return *this;
         clear();
-        ::operator delete(data_);
-        data_ = other.data_;
-        size_ = other.size_;
-        capacity_ = other.capacity_;
-        other.data_ = nullptr;
-        other.size_ = 0;
-        other.capacity_ = 0;
+        release_storage();
+        data_ = inline_data();
+        capacity_ = InlineCapacity;
+        resource_ = other.resource_;
+        comp_ = other.comp_;
+        search_index_ = std::move(other.search_index_);
+        take_contents(other);
         return *this;
     }
 
@@ -242,7 +538,7 @@ public:
      */
     ~Table() noexcept {
         clear();
-        ::operator delete(data_);
+        release_storage();
     }
 
     /**
@@ -345,6 +641,7 @@ public:
             data_[i].~TablePair<Key, T>();
         }
         size_ = 0;
+        search_index_.invalidate();
     }
 
     /**
@@ -382,9 +679,7 @@ public:
      */
     template<class InputIt>
     void insert(InputIt first, InputIt last) {
-        for (; first != last; first++) {
-            insert(*first);
-        }
+        insert_bulk(first, last);
     }
 
     /**
@@ -392,9 +687,32 @@ public:
      * @param ilist Список инициализации
      */
     void insert(std::initializer_list<value_type> ilist) {
-        for (const auto& val : ilist) {
-            insert(val);
+        insert_bulk(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief Пакетная вставка элементов из диапазона.
+     *
+     * Диапазон может быть неотсортированным: он копируется во временный буфер,
+     * сортируется один раз (уже отсортированный вход не сортируется) и сливается
+     * с содержимым таблицы за один проход, т.е. за O(n + m log m) вместо O(n * m)
+     * при поэлементной вставке. Как и insert, не перезаписывает существующие ключи;
+     * из повторяющихся ключей диапазона вставляется первый.
+     *
+     * @param first Итератор начала (элементы приводимы к value_type)
+     * @param last Итератор конца
+     * @return Количество вставленных элементов
+     */
+    template<class InputIt>
+    size_type insert_bulk(InputIt first, InputIt last) {
+        std::vector<value_type> staged;
+        if constexpr (std::is_convertible_v<typename std::iterator_traits<InputIt>::iterator_category, std::forward_iterator_tag>) {
+            staged.reserve(std::distance(first, last));
         }
+        for (; first != last; first++) {
+            staged.emplace_back(*first);
+        }
+        return merge_staged(staged);
     }
 
     /**
@@ -503,6 +821,7 @@ public:
             data_[i].~TablePair<Key, T>();
         }
         size_ -= count;
+        search_index_.invalidate();
         return iterator(data_ + start_idx);
     }
 
@@ -532,10 +851,19 @@ public:
      * @brief Обменять содержимое с другой таблицей.
      * @param other Другая таблица
      */
-    void swap(Table& other) noexcept {
+    void swap(Table& other) noexcept(NOTHROW_RELOCATE) {
+        if (is_inline() || other.is_inline()) {
+            Table temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+            return;
+        }
         std::swap(data_, other.data_);
         std::swap(size_, other.size_);
         std::swap(capacity_, other.capacity_);
+        std::swap(resource_, other.resource_);
+        std::swap(comp_, other.comp_);
+        search_index_.swap(other.search_index_);
     }
 
     /**
@@ -544,7 +872,7 @@ public:
      * @return 0 или 1
      */
     size_type count(const Key& key) const noexcept {
-        size_t pos = binary_search(key);
+        size_t pos = lookup_position(key);
         return key_at_position(pos, key) ? 1 : 0;
     }
 
@@ -554,7 +882,7 @@ public:
      * @return Итератор на элемент или end()
      */
     iterator find(const Key& key) noexcept {
-        size_t pos = binary_search(key);
+        size_t pos = lookup_position(key);
         return key_at_position(pos, key) ? iterator(data_ + pos) : end();
     }
 
@@ -564,7 +892,7 @@ public:
      * @return Константный итератор на элемент или end()
      */
     const_iterator find(const Key& key) const noexcept {
-        size_t pos = binary_search(key);
+        size_t pos = lookup_position(key);
         return key_at_position(pos, key) ? const_iterator(data_ + pos) : end();
     }
 
@@ -574,7 +902,7 @@ public:
      * @return true если ключ присутствует
      */
     bool contains(const Key& key) const noexcept {
-        size_t pos = binary_search(key);
+        size_t pos = lookup_position(key);
         return key_at_position(pos, key);
     }
 
@@ -584,7 +912,7 @@ public:
      * @return Итератор
      */
     iterator lower_bound(const Key& key) noexcept {
-        return iterator(data_ + binary_search(key));
+        return iterator(data_ + lookup_position(key));
     }
 
     /**
@@ -593,7 +921,7 @@ public:
      * @return Константный итератор
      */
     const_iterator lower_bound(const Key& key) const noexcept {
-        return const_iterator(data_ + binary_search(key));
+        return const_iterator(data_ + lookup_position(key));
     }
 
     /**
@@ -602,7 +930,7 @@ public:
      * @return Итератор
      */
     iterator upper_bound(const Key& key) noexcept {
-        size_t pos = binary_search(key);
+        size_t pos = lookup_position(key);
         if (key_at_position(pos, key)) pos++;
         return iterator(data_ + pos);
     }
@@ -613,7 +941,7 @@ public:
      * @return Константный итератор
      */
     const_iterator upper_bound(const Key& key) const noexcept {
-        size_t pos = binary_search(key);
+        size_t pos = lookup_position(key);
         if (key_at_position(pos, key)) pos++;
         return const_iterator(data_ + pos);
     }
@@ -624,9 +952,8 @@ public:
      * @return Пара итераторов
      */
     std::pair<iterator, iterator> equal_range(const Key& key) noexcept {
-        iterator lb = lower_bound(key);
-        iterator ub = (lb != end() && lb->key == key) ? lb + 1 : lb;
-        return {lb, ub};
+        size_t pos = lookup_position(key);
+        return {iterator(data_ + pos), iterator(data_ + pos + (key_at_position(pos, key) ? 1 : 0))};
     }
 
     /**
@@ -635,9 +962,108 @@ public:
      * @return Пара константных итераторов
      */
     std::pair<const_iterator, const_iterator> equal_range(const Key& key) const noexcept {
-        const_iterator lb = lower_bound(key);
-        const_iterator ub = (lb != end() && lb->key == key) ? lb + 1 : lb;
-        return {lb, ub};
+        size_t pos = lookup_position(key);
+        return {const_iterator(data_ + pos), const_iterator(data_ + pos + (key_at_position(pos, key) ? 1 : 0))};
+    }
+
+    /**
+     * @brief Найти элемент по ключу другого типа.
+     * @param key Значение, сравнимое с ключом через прозрачный Compare (например, std::string_view)
+     * @return Итератор на элемент или end()
+     */
+    template<typename K> requires TransparentCompare<Compare>
+    iterator find(const K& key) noexcept {
+        size_t pos = lookup_position(key);
+        return key_at_position(pos, key) ? iterator(data_ + pos) : end();
+    }
+
+    /**
+     * @brief Найти элемент по ключу другого типа (константная версия).
+     * @param key Значение, сравнимое с ключом через прозрачный Compare
+     * @return Константный итератор на элемент или end()
+     */
+    template<typename K> requires TransparentCompare<Compare>
+    const_iterator find(const K& key) const noexcept {
+        size_t pos = lookup_position(key);
+        return key_at_position(pos, key) ? const_iterator(data_ + pos) : end();
+    }
+
+    /**
+     * @brief Проверить наличие ключа, заданного значением другого типа.
+     * @param key Значение, сравнимое с ключом через прозрачный Compare
+     * @return true если ключ присутствует
+     */
+    template<typename K> requires TransparentCompare<Compare>
+    bool contains(const K& key) const noexcept {
+        return key_at_position(lookup_position(key), key);
+    }
+
+    /**
+     * @brief Получить количество элементов с ключом другого типа.
+     * @param key Значение, сравнимое с ключом через прозрачный Compare
+     * @return 0 или 1
+     */
+    template<typename K> requires TransparentCompare<Compare>
+    size_type count(const K& key) const noexcept {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Получить итератор на первый элемент не меньше значения другого типа.
+     * @param key Значение, сравнимое с ключом через прозрачный Compare
+     * @return Итератор
+     */
+    template<typename K> requires TransparentCompare<Compare>
+    iterator lower_bound(const K& key) noexcept {
+        return iterator(data_ + lookup_position(key));
+    }
+
+    /**
+     * @brief Получить константный итератор на первый элемент не меньше значения другого типа.
+     * @param key Значение, сравнимое с ключом через прозрачный Compare
+     * @return Константный итератор
+     */
+    template<typename K> requires TransparentCompare<Compare>
+    const_iterator lower_bound(const K& key) const noexcept {
+        return const_iterator(data_ + lookup_position(key));
+    }
+
+    /**
+     * @brief Получить итератор на первый элемент больше значения другого типа.
+     * @param key Значение, сравнимое с ключом через прозрачный Compare
+     * @return Итератор
+     */
+    template<typename K> requires TransparentCompare<Compare>
+    iterator upper_bound(const K& key) noexcept {
+        size_t pos = lookup_position(key);
+        if (key_at_position(pos, key)) pos++;
+        return iterator(data_ + pos);
+    }
+
+    /**
+     * @brief Получить константный итератор на первый элемент больше значения другого типа.
+     * @param key Значение, сравнимое с ключом через прозрачный Compare
+     * @return Константный итератор
+     */
+    template<typename K> requires TransparentCompare<Compare>
+    const_iterator upper_bound(const K& key) const noexcept {
+        size_t pos = lookup_position(key);
+        if (key_at_position(pos, key)) pos++;
+        return const_iterator(data_ + pos);
+    }
+
+    /**
+     * @brief Удалить элемент по ключу другого типа.
+     * @param key Значение, сравнимое с ключом через прозрачный Compare
+     * @return Количество удаленных элементов (0 или 1)
+     */
+    template<typename K> requires TransparentCompare<Compare> &&
+        (!std::is_convertible_v<K&&, iterator>) && (!std::is_convertible_v<K&&, const_iterator>)
+    size_type erase(K&& key) {
+        size_t pos = binary_search(key);
+        if (!key_at_position(pos, key)) return 0;
+        shift_left(pos);
+        return 1;
     }
 
     /**
@@ -647,7 +1073,7 @@ public:
      * @throws std::out_of_range если ключ не найден
      */
     T& at(const Key& key) {
-        size_t pos = binary_search(key);
+        size_t pos = lookup_position(key);
         if (!key_at_position(pos, key)) throw std::out_of_range("Table::at: key not found");
         return data_[pos].value;
     }
@@ -659,7 +1085,7 @@ public:
      * @throws std::out_of_range если ключ не найден
      */
     const T& at(const Key& key) const {
-        size_t pos = binary_search(key);
+        size_t pos = lookup_position(key);
         if (!key_at_position(pos, key)) throw std::out_of_range("Table::at: key not found");
         return data_[pos].value;
     }
@@ -713,6 +1139,37 @@ public:
         if (size_ < capacity_) safe_reallocate(size_);
     }
 
+    /**
+     * @brief Выбрать режим поиска.
+     *
+     * В режиме Eytzinger таблица, начиная с EytzingerIndex::MIN_SIZE элементов, держит
+     * отдельный индекс 64-битных префиксов ключей; меньшие таблицы память под индекс не
+     * выделяют. Изменяющие операции только помечают индекс устаревшим, а перестраивают
+     * его операции чтения (find, contains, count, lower_bound, upper_bound, equal_range, at),
+     * когда без индекса выполнено достаточно поисков (см. TableSearchIndex).
+     * Режим действует для ключей, у которых есть специализация TableKeyPrefix.
+     *
+     * @param mode Новый режим
+     */
+    void set_search_mode(TableSearchMode mode) noexcept {
+        if (mode == search_mode()) return;
+        search_index_.set_mode(mode);
+    }
+
+    /**
+     * @brief Получить текущий режим поиска.
+     * @return Режим поиска
+     */
+    TableSearchMode search_mode() const noexcept {
+        return search_index_.mode();
+    }
+
+    /**
+     * @brief Получить ресурс памяти таблицы.
+     * @return Ресурс, из которого выделяется массив элементов
+     */
+    std::pmr::memory_resource* get_resource() const noexcept { return resource_; }
+
     // /**
     //  * @brief Извлечь значение по ключу.
     //  * @param key Ключ
@@ -736,8 +1193,8 @@ public:
  * @param rhs Правая таблица
  * @return true если таблицы равны
  */
-template<typename Key, typename T>
-bool operator==(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept {
+template<typename Key, typename T, typename Compare, size_t InlineCapacity>
+bool operator==(const Table<Key, T, Compare, InlineCapacity>& lhs, const Table<Key, T, Compare, InlineCapacity>& rhs) noexcept {
     if (lhs.size() != rhs.size()) return false;
     for (auto it1 = lhs.begin(), it2 = rhs.begin(); it1 != lhs.end(); ++it1, ++it2) {
         if (it1->key != it2->key || it1->value != it2->value) return false;
@@ -751,8 +1208,8 @@ bool operator==(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept {
  * @param rhs Правая таблица
  * @return true если таблицы не равны
  */
-template<typename Key, typename T>
-bool operator!=(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept { return !(lhs == rhs); }
+template<typename Key, typename T, typename Compare, size_t InlineCapacity>
+bool operator!=(const Table<Key, T, Compare, InlineCapacity>& lhs, const Table<Key, T, Compare, InlineCapacity>& rhs) noexcept { return !(lhs == rhs); }
 
 /**
  * @brief Оператор "меньше".
@@ -761,8 +1218,8 @@ bool operator!=(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept { r
  * @param rhs Правая таблица
  * @return true если левая таблица меньше правой
  */
-template<typename Key, typename T>
-bool operator<(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept {
+template<typename Key, typename T, typename Compare, size_t InlineCapacity>
+bool operator<(const Table<Key, T, Compare, InlineCapacity>& lhs, const Table<Key, T, Compare, InlineCapacity>& rhs) noexcept {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
         [](const TablePair<Key, T>& a, const TablePair<Key, T>& b) {
             if (a.key < b.key) return true;
@@ -778,8 +1235,8 @@ bool operator<(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept {
  * @param rhs Правая таблица
  * @return true если левая таблица меньше или равна правой
  */
-template<typename Key, typename T>
-bool operator<=(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept { return !(rhs < lhs); }
+template<typename Key, typename T, typename Compare, size_t InlineCapacity>
+bool operator<=(const Table<Key, T, Compare, InlineCapacity>& lhs, const Table<Key, T, Compare, InlineCapacity>& rhs) noexcept { return !(rhs < lhs); }
 
 /**
  * @brief Оператор "больше".
@@ -787,8 +1244,8 @@ bool operator<=(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept { r
  * @param rhs Правая таблица
  * @return true если левая таблица больше правой
  */
-template<typename Key, typename T>
-bool operator>(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept { return rhs < lhs; }
+template<typename Key, typename T, typename Compare, size_t InlineCapacity>
+bool operator>(const Table<Key, T, Compare, InlineCapacity>& lhs, const Table<Key, T, Compare, InlineCapacity>& rhs) noexcept { return rhs < lhs; }
 
 /**
  * @brief Оператор "больше или равно".
@@ -796,13 +1253,13 @@ bool operator>(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept { re
  * @param rhs Правая таблица
  * @return true если левая таблица больше или равна правой
  */
-template<typename Key, typename T>
-bool operator>=(const Table<Key, T>& lhs, const Table<Key, T>& rhs) noexcept { return !(lhs < rhs); }
+template<typename Key, typename T, typename Compare, size_t InlineCapacity>
+bool operator>=(const Table<Key, T, Compare, InlineCapacity>& lhs, const Table<Key, T, Compare, InlineCapacity>& rhs) noexcept { return !(lhs < rhs); }
 
 /**
  * @brief std::swap для Table.
  */
-template<typename Key, typename T>
-void swap(Table<Key, T>& lhs, Table<Key, T>& rhs) noexcept { lhs.swap(rhs); }
+template<typename Key, typename T, typename Compare, size_t InlineCapacity>
+void swap(Table<Key, T, Compare, InlineCapacity>& lhs, Table<Key, T, Compare, InlineCapacity>& rhs) noexcept(noexcept(lhs.swap(rhs))) { lhs.swap(rhs); }
 
 #endif
\ No newline at end of file
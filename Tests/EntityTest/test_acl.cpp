@@ -2,6 +2,8 @@
 #include <catch2/matchers/catch_matchers_vector.hpp>
 #include "Entity/ACL/acl_class.h"
 #include "base.h"
+#include <map>
+#include <random>
 
 TEST_CASE("ACL") {
     ACL acl(1);
@@ -218,4 +220,154 @@ TEST_CASE("ACL") {
         acl.setEntries(entries);
         REQUIRE(acl.getEntries().size() == 1);
     }
+}
+
+TEST_CASE("ACL: маски разрешений") {
+    SECTION("Маска совпадает с поразрешительной проверкой") {
+        std::mt19937 gen(17);
+        for (int round = 0; round < 200; round++) {
+            ACL acl(1);
+            std::map<ACLKey, std::map<PermissionType, PermissionEffect>> model;
+            for (int op = 0; op < 20; op++) {
+                unsigned int id = gen() % 5;
+                SubjectType type = gen() % 2 ? SubjectType::User : SubjectType::Group;
+                auto perm = static_cast<PermissionType>(gen() % 6);
+                if (gen() % 4 == 0) {
+                    acl.removePermission(id, type, perm);
+                    auto it = model.find({id, type});
+                    if (it != model.end()) {
+                        it->second.erase(perm);
+                        if (it->second.empty()) model.erase(it);
+                    }
+                } else {
+                    auto effect = gen() % 3 ? PermissionEffect::Allow : PermissionEffect::Deny;
+                    acl.setPermission(id, type, perm, effect);
+                    model[{id, type}][perm] = effect;
+                }
+            }
+            REQUIRE(acl.getEntries().size() == model.size());
+            std::vector<unsigned int> groups = {0, 2, 4};
+            for (unsigned int user = 0; user < 5; user++) {
+                PermissionMask mask = acl.getPermissionMask(user, groups);
+                for (int i = 0; i < 6; i++) {
+                    auto perm = static_cast<PermissionType>(i);
+                    bool allow = false, deny = false;
+                    auto apply = [&](const ACLKey& key) {
+                        auto it = model.find(key);
+                        if (it == model.end()) return;
+                        auto p = it->second.find(perm);
+                        if (p == it->second.end()) return;
+                        (p->second == PermissionEffect::Deny ? deny : allow) = true;
+                    };
+                    apply({user, SubjectType::User});
+                    for (unsigned int g : groups) apply({g, SubjectType::Group});
+                    bool expected = !deny && (allow || user == 1);
+                    REQUIRE(((mask & permissionBit(perm)) != 0) == expected);
+                    REQUIRE(acl.checkPermission(user, groups, perm) == expected);
+                }
+            }
+        }
+    }
+
+    SECTION("Записи возвращаются в порядке субъектов, повтор в setEntries заменяет запись") {
+        ACL acl(1);
+        ACLEntry group;
+        group.subjectId = 2;
+        group.subjectType = SubjectType::Group;
+        group.setPermission(PermissionType::Write, PermissionEffect::Deny);
+        ACLEntry first;
+        first.subjectId = 2;
+        first.subjectType = SubjectType::User;
+        first.setPermission(PermissionType::Read, PermissionEffect::Allow);
+        ACLEntry second = first;
+        second.permissions.clear();
+        second.setPermission(PermissionType::Execute, PermissionEffect::Allow);
+        acl.setEntries({group, first, second});
+
+        auto entries = acl.getEntries();
+        REQUIRE(entries.size() == 2);
+        REQUIRE(entries[0].subjectType == SubjectType::User);
+        REQUIRE(entries[0].permissions.size() == 1);
+        REQUIRE(entries[0].getPermissionEffect(PermissionType::Execute) == PermissionEffect::Allow);
+        REQUIRE(entries[1].subjectType == SubjectType::Group);
+        REQUIRE(acl.getPermissionMask(2, {2}) == permissionBit(PermissionType::Execute));
+        REQUIRE(acl.getPermissionMask(1, {2}) == (ALL_PERMISSIONS & ~permissionBit(PermissionType::Write)));
+    }
+}
+
+TEST_CASE("ACL: общие неизменяемые списки") {
+    size_t baseline = ACL::distinctCount();
+
+    SECTION("Равные списки разделяют содержимое") {
+        ACL a(7), b(7);
+        REQUIRE(a == b);
+        REQUIRE(a.identity() == b.identity());
+        a.setPermission(3, SubjectType::Group, PermissionType::Read, PermissionEffect::Allow);
+        REQUIRE_FALSE(a == b);
+        b.setPermission(3, SubjectType::Group, PermissionType::Read, PermissionEffect::Allow);
+        REQUIRE(a == b);
+        b.setOwnerId(8);
+        REQUIRE_FALSE(a == b);
+        REQUIRE(b.getOwner() == 8);
+    }
+
+    SECTION("Изменение копии не затрагивает оригинал") {
+        ACL original(7);
+        original.setPermission(2, SubjectType::User, PermissionType::Read, PermissionEffect::Allow);
+        ACL copy = original;
+        REQUIRE(copy.identity() == original.identity());
+        copy.setPermission(2, SubjectType::User, PermissionType::Read, PermissionEffect::Deny);
+        REQUIRE(original.checkPermission(2, {}, PermissionType::Read));
+        REQUIRE_FALSE(copy.checkPermission(2, {}, PermissionType::Read));
+        copy.removePermission(2, SubjectType::User, PermissionType::Read);
+        REQUIRE(copy.getEntries().empty());
+        REQUIRE(copy == ACL(7));
+
+        const void* before = original.identity();
+        original.setPermission(2, SubjectType::User, PermissionType::Read, PermissionEffect::Allow);
+        REQUIRE(original.identity() == before);
+    }
+
+    SECTION("Содержимое освобождается вместе с последним списком") {
+        {
+            std::vector<ACL> lists(100, ACL(12345));
+            for (auto& list : lists) list.setPermission(1, SubjectType::User, PermissionType::Write, PermissionEffect::Allow);
+            REQUIRE(ACL::distinctCount() <= baseline + 2);
+        }
+        REQUIRE(ACL::distinctCount() == baseline);
+    }
+}
+TEST_CASE("ACL: наследуемые записи") {
+    ACL own(1);
+    own.setPermission(2, SubjectType::User, PermissionType::Write, PermissionEffect::Allow);
+    ACL inherited(0);
+    inherited.setPermission(2, SubjectType::User, PermissionType::Read, PermissionEffect::Allow);
+    inherited.setPermission(5, SubjectType::Group, PermissionType::Execute, PermissionEffect::Allow);
+
+    SECTION("Унаследованные разрешения добавляются к собственным") {
+        PermissionMask mask = own.getPermissionMask(2, {5}, inherited);
+        REQUIRE(mask == (permissionBit(PermissionType::Read) | permissionBit(PermissionType::Write) | permissionBit(PermissionType::Execute)));
+        REQUIRE(own.getPermissionMask(2, {5}, ACL(0)) == own.getPermissionMask(2, {5}));
+    }
+
+    SECTION("Запрет из любого источника сильнее разрешения") {
+        inherited.setPermission(1, SubjectType::User, PermissionType::Modify, PermissionEffect::Deny);
+        inherited.setPermission(2, SubjectType::User, PermissionType::Write, PermissionEffect::Deny);
+        REQUIRE((own.getPermissionMask(2, {}, inherited) & permissionBit(PermissionType::Write)) == 0);
+        REQUIRE(own.getPermissionMask(1, {}, inherited) == (ALL_PERMISSIONS & ~permissionBit(PermissionType::Modify)));
+    }
+
+    SECTION("Объединение списков") {
+        ACL parent(0);
+        parent.setPermission(2, SubjectType::User, PermissionType::Write, PermissionEffect::Deny);
+        parent.setPermission(3, SubjectType::User, PermissionType::Read, PermissionEffect::Allow);
+        ACL merged = parent.mergedWith(inherited);
+        REQUIRE(merged.getOwner() == 0);
+        REQUIRE(merged.getEntries().size() == 3);
+        REQUIRE(merged.getPermissionMask(2, {}) == permissionBit(PermissionType::Read));
+        REQUIRE(merged.checkPermission(3, {}, PermissionType::Read));
+        REQUIRE(merged.checkPermission(9, {5}, PermissionType::Execute));
+        REQUIRE(parent.mergedWith(ACL(0)).identity() == parent.identity());
+        REQUIRE(ACL(0).mergedWith(inherited) == inherited);
+    }
 }
\ No newline at end of file
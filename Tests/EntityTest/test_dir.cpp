@@ -2,7 +2,15 @@
 
 #include "../../Entity/Directory/realisation/directory_descriptor.h"
 #include "../../Entity/File/realisation/file_descriptor.h"
+#include "../../Entity/FSObject/interface/object_cast.h"
 #include "../../Entity/User/user.h"
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <thread>
 
 TEST_CASE("DirectoryDescriptor") {
     User owner(1, "test_user");
@@ -12,7 +20,8 @@ TEST_CASE("DirectoryDescriptor") {
 
         REQUIRE(dir.getName() == "test_dir");
         REQUIRE(dir.getAddress() == 200);
-        REQUIRE(dir.getOwner().getId() == 1);
+        REQUIRE(dir.getOwnerId() == 1);
+        REQUIRE(dir.getType() == ObjectType::Directory);
         REQUIRE(dir.getChildCount() == 0);
     }
     
@@ -74,5 +83,282 @@ TEST_CASE("DirectoryDescriptor") {
         REQUIRE_FALSE(dir.containChild("test.txt"));
         REQUIRE(dir.addChild(&file));
         REQUIRE(dir.containChild("test.txt"));
+        std::string_view path = "/parent/test.txt";
+        REQUIRE(dir.containChild(path.substr(8)));
+        REQUIRE(dir.getChild(path.substr(8)) == &file);
+        REQUIRE_FALSE(dir.containChild(path.substr(8, 4)));
+    }
+
+    SECTION("Пакетное добавление дочерних объектов") {
+        DirectoryDescriptor dir("parent", 0, owner, 200);
+        FileDescriptor existing("b.txt", dir.getAddress(), owner, 100);
+        FileDescriptor fileC("c.txt", dir.getAddress(), owner, 101);
+        FileDescriptor fileA("a.txt", dir.getAddress(), owner, 102);
+        FileDescriptor duplicate("b.txt", dir.getAddress(), owner, 103);
+        REQUIRE(dir.addChild(&existing));
+
+        std::vector<IFileSystemObject*> batch = {&fileC, nullptr, &fileA, &duplicate};
+        REQUIRE(dir.addChildren(batch) == 2);
+        REQUIRE(dir.getChildCount() == 3);
+        REQUIRE(dir.getChild("b.txt") == &existing);
+        auto children = dir.listChild();
+        REQUIRE(children[0] == &fileA);
+        REQUIRE(children[2] == &fileC);
+    }
+
+    SECTION("Большая директория переходит на B+дерево и обратно") {
+        DirectoryDescriptor dir("parent", 0, owner, 200);
+        std::vector<std::unique_ptr<FileDescriptor>> files;
+        size_t count = DirectoryDescriptor::LARGE_DIRECTORY_THRESHOLD + 100;
+        for (size_t i = 0; i < count; i++) {
+            files.push_back(std::make_unique<FileDescriptor>("f" + std::to_string(i), dir.getAddress(), owner, 1000 + i));
+            REQUIRE(dir.addChild(files.back().get()));
+        }
+        REQUIRE(dir.getChildCount() == static_cast<int>(count));
+        REQUIRE(dir.getChild("f4000") == files[4000].get());
+        REQUIRE_FALSE(dir.addChild(files[10].get()));
+
+        auto children = dir.listChild();
+        REQUIRE(children.size() == count);
+        REQUIRE(std::is_sorted(children.begin(), children.end(), [](auto* a, auto* b) { return a->getName() < b->getName(); }));
+
+        for (size_t i = 0; i < count - 10; i++) {
+            REQUIRE(dir.removeChild("f" + std::to_string(i)));
+        }
+        REQUIRE(dir.getChildCount() == 10);
+        REQUIRE(dir.containChild("f" + std::to_string(count - 1)));
+        REQUIRE_FALSE(dir.containChild("f0"));
+    }
+
+    SECTION("Снимок дочерних объектов при параллельных изменениях") {
+        std::vector<std::unique_ptr<FileDescriptor>> files;
+        for (int i = 0; i < 500; i++) {
+            files.push_back(std::make_unique<FileDescriptor>("f" + std::to_string(i), 100, owner, 1000 + i));
+        }
+        DirectoryDescriptor dir("concurrent", 0, owner, 100);
+        auto before = dir.snapshotChildren();
+        REQUIRE(before->empty());
+
+        std::atomic<bool> stop{false};
+        std::atomic<bool> consistent{true};
+        std::thread reader([&] {
+            while (!stop.load()) {
+                auto snapshot = dir.snapshotChildren();
+                for (size_t i = 1; i < snapshot->size(); i++) {
+                    if ((*snapshot)[i - 1]->getName() >= (*snapshot)[i]->getName()) consistent.store(false);
+                }
+            }
+        });
+        for (auto& file : files) dir.addChild(file.get());
+        for (int i = 0; i < 500; i += 2) dir.removeChild("f" + std::to_string(i));
+        stop.store(true);
+        reader.join();
+
+        REQUIRE(consistent.load());
+        REQUIRE(before->empty());
+        auto after = dir.snapshotChildren();
+        REQUIRE(after->size() == 250);
+        REQUIRE(dir.snapshotChildren() == after);
+        REQUIRE(dir.listChild() == *after);
+        dir.removeChild("f1");
+        REQUIRE(after->size() == 250);
+        REQUIRE(dir.snapshotChildren()->size() == 249);
+    }
+
+    SECTION("Таблица дочерних объектов в заданном ресурсе памяти") {
+        std::vector<std::unique_ptr<FileDescriptor>> files;
+        for (int i = 0; i < 100; i++) {
+            files.push_back(std::make_unique<FileDescriptor>("f" + std::to_string(i), 100, owner, 1000 + i));
+        }
+        std::pmr::monotonic_buffer_resource arena;
+        DirectoryDescriptor dir("arena", 0, owner, 100, &arena);
+
+        std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        bool allAdded = true;
+        for (auto& file : files) allAdded = dir.addChild(file.get()) && allAdded;
+        std::pmr::set_default_resource(previous);
+
+        REQUIRE(allAdded);
+        REQUIRE(dir.getChildCount() == 100);
+        REQUIRE(dir.getChild("f42") == files[42].get());
+    }
+
+    SECTION("Поиск в очень большой директории через хеш-индекс") {
+        DirectoryDescriptor dir("huge", 0, owner, 300);
+        std::vector<std::unique_ptr<FileDescriptor>> files;
+        std::vector<IFileSystemObject*> batch;
+        size_t count = DirectoryDescriptor::HASH_INDEX_THRESHOLD + 1000;
+        for (size_t i = 0; i < count; i++) {
+            files.push_back(std::make_unique<FileDescriptor>("f" + std::to_string(i), dir.getAddress(), owner, 1000 + i));
+            batch.push_back(files.back().get());
+        }
+        REQUIRE(dir.addChildren(batch) == static_cast<int>(count));
+        REQUIRE(dir.getChild("f12345") == files[12345].get());
+        REQUIRE(dir.containChild(std::string_view("f0")));
+        REQUIRE_FALSE(dir.containChild("missing"));
+
+        REQUIRE(dir.removeChild("f12345"));
+        REQUIRE(dir.getChild("f12345") == nullptr);
+        REQUIRE(dir.getChild("f12346") == files[12346].get());
+        REQUIRE(dir.addChild(files[12345].get()));
+        REQUIRE_FALSE(dir.addChild(files[7].get()));
+        REQUIRE(dir.getChild("f12345") == files[12345].get());
+
+        auto children = dir.listChild();
+        REQUIRE(children.size() == count);
+        REQUIRE(std::is_sorted(children.begin(), children.end(), [](auto* a, auto* b) { return a->getName() < b->getName(); }));
+
+        for (size_t i = 0; i < count - 100; i++) {
+            REQUIRE(dir.removeChild("f" + std::to_string(i)));
+        }
+        REQUIRE(dir.getChildCount() == 100);
+        REQUIRE(dir.getChild("f" + std::to_string(count - 1)) == files.back().get());
+        REQUIRE(dir.getChild("f0") == nullptr);
+    }
+
+    SECTION("Хеш-индекс строится при добавлении, а поиск его только читает") {
+        DirectoryDescriptor dir("huge", 0, owner, 350);
+        std::vector<std::unique_ptr<FileDescriptor>> files;
+        size_t count = DirectoryDescriptor::HASH_INDEX_THRESHOLD + 10;
+        for (size_t i = 0; i < count; i++) {
+            files.push_back(std::make_unique<FileDescriptor>("f" + std::to_string(i), dir.getAddress(), owner, 1000 + i));
+            REQUIRE(dir.addChild(files.back().get()));
+        }
+
+        const DirectoryDescriptor& view = dir;
+        std::atomic<bool> found{true};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; t++) {
+            readers.emplace_back([&, t] {
+                for (size_t i = t; i < count; i += 4) {
+                    if (view.getChild("f" + std::to_string(i)) != files[i].get()) found.store(false);
+                }
+            });
+        }
+        for (auto& reader : readers) reader.join();
+        REQUIRE(found.load());
+        REQUIRE_FALSE(view.containChild("missing"));
+    }
+
+    SECTION("Приведение по тегу типа без dynamic_cast") {
+        DirectoryDescriptor dir("dir", 0, owner, 400);
+        FileDescriptor file("file.txt", dir.getAddress(), owner, 401);
+        IFileSystemObject* dirObject = &dir;
+        IFileSystemObject* fileObject = &file;
+
+        REQUIRE(dirObject->asDirectory() == &dir);
+        REQUIRE(dirObject->asFile() == nullptr);
+        REQUIRE(dirObject->asLockable() == nullptr);
+        REQUIRE(fileObject->asFile() == &file);
+        REQUIRE(fileObject->asDirectory() == nullptr);
+        REQUIRE(fileObject->asLockable() == &file);
+
+        REQUIRE(asObject(dirObject->asDirectory()) == dirObject);
+        REQUIRE(asObject(fileObject->asFile()) == fileObject);
+        REQUIRE(asDirectory(static_cast<IFileSystemObject*>(nullptr)) == nullptr);
+        REQUIRE(asFile(static_cast<const IFileSystemObject*>(fileObject)) == &file);
+    }
+}
+
+TEST_CASE("ChildHashIndex") {
+    User owner(1, "owner");
+    std::vector<std::unique_ptr<FileDescriptor>> files;
+    for (int i = 0; i < 1000; i++) {
+        files.push_back(std::make_unique<FileDescriptor>("n" + std::to_string(i), 100, owner, 1000 + i));
+    }
+    ChildHashIndex index;
+
+    SECTION("Построение и поиск") {
+        REQUIRE_FALSE(index.isActive());
+        REQUIRE(index.find("n1") == nullptr);
+        std::vector<IFileSystemObject*> objects;
+        for (auto& file : files) objects.push_back(file.get());
+        index.build(objects);
+        REQUIRE(index.isActive());
+        REQUIRE(index.size() == 1000);
+        REQUIRE(index.find("n500") == files[500].get());
+        REQUIRE(index.find("n1000") == nullptr);
+        REQUIRE_FALSE(index.insert(files[3].get()));
+        index.reset();
+        REQUIRE_FALSE(index.isActive());
+        REQUIRE(index.find("n500") == nullptr);
+    }
+
+    SECTION("Удаление обратным сдвигом сохраняет цепочки пробирования") {
+        for (auto& file : files) REQUIRE(index.insert(file.get()));
+        for (int i = 0; i < 1000; i += 3) REQUIRE(index.erase("n" + std::to_string(i)));
+        REQUIRE_FALSE(index.erase("n0"));
+        for (int i = 0; i < 1000; i++) {
+            REQUIRE((index.find("n" + std::to_string(i)) != nullptr) == (i % 3 != 0));
+        }
+        REQUIRE(index.size() == 666);
+    }
+}
+
+TEST_CASE("NamePool") {
+    NamePool& pool = NamePool::instance();
+    User owner(1, "test_user");
+
+    SECTION("Одинаковые имена разделяют одну запись") {
+        InternedName a("name_pool_alpha");
+        InternedName b(std::string("name_pool_") + "alpha");
+        InternedName c("name_pool_beta");
+        REQUIRE(a == b);
+        REQUIRE(&a.str() == &b.str());
+        REQUIRE(a.hash() == NamePool::hashName("name_pool_alpha"));
+        REQUIRE(a != c);
+        REQUIRE(a < c);
+        REQUIRE(a == std::string_view("name_pool_alpha"));
+        REQUIRE(InternedName().empty());
+        REQUIRE(InternedName("").empty());
+    }
+
+    SECTION("Запись освобождается с последней ссылкой") {
+        size_t before = pool.statistics().names;
+        {
+            InternedName a("name_pool_temporary");
+            InternedName copy = a;
+            InternedName moved = std::move(copy);
+            REQUIRE(pool.statistics().names == before + 1);
+        }
+        REQUIRE(pool.statistics().names == before);
+    }
+
+    SECTION("Ключ директории ссылается на имя объекта") {
+        DirectoryDescriptor dir("dir", 0, owner, 1);
+        FileDescriptor file("name_pool_child", 1, owner, 2);
+        FileDescriptor twin("name_pool_child", 1, owner, 3);
+        size_t names = pool.statistics().names;
+
+        REQUIRE(dir.addChild(&file));
+        REQUIRE_FALSE(dir.addChild(&twin));
+        REQUIRE(pool.statistics().names == names);
+        REQUIRE(&file.getName() == &twin.getName());
+        REQUIRE(dir.getChild("name_pool_child") == &file);
+
+        REQUIRE(file.setName("name_pool_renamed"));
+        REQUIRE(file.getName() == "name_pool_renamed");
+        REQUIRE(twin.getName() == "name_pool_child");
+        REQUIRE(dir.removeChild("name_pool_child"));
+        REQUIRE(dir.getChildCount() == 0);
+    }
+
+    SECTION("Параллельная регистрация и освобождение имён") {
+        std::atomic<bool> consistent{true};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 2000; i++) {
+                    std::string text = "name_pool_shared_" + std::to_string(i % 7);
+                    InternedName name(text);
+                    InternedName copy = name;
+                    if (copy.str() != text) consistent.store(false);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        REQUIRE(consistent.load());
+        InternedName probe("name_pool_shared_3");
+        REQUIRE(probe.str() == "name_pool_shared_3");
     }
 }
\ No newline at end of file
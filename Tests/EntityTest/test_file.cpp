@@ -1,7 +1,19 @@
 #include <catch2/catch_all.hpp>
 #include "../Entity/File/realisation/file_descriptor.h"
+#include "../Entity/File/realisation/content_store.h"
+#include "../Entity/File/realisation/lz_codec.h"
+#include "../Entity/File/interface/file_lock.h"
 #include "../Entity/User/user.h"
 #include "../base.h"
+#include <memory_resource>
+#include <random>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include <string>
 
 TEST_CASE("FileDescriptor") {
     User owner(1, "test_user");
@@ -11,7 +23,8 @@ TEST_CASE("FileDescriptor") {
 
         REQUIRE(file.getName() == "test");
         REQUIRE(file.getAddress() == 100);
-        REQUIRE(file.getOwner().getId() == 1);
+        REQUIRE(file.getOwnerId() == 1);
+        REQUIRE(file.getType() == ObjectType::File);
         REQUIRE(file.getSize() == 0);
         REQUIRE(file.getParentDirectoryAddress() == 0);
         REQUIRE(file.getCreateTime() <= std::chrono::system_clock::now());
@@ -30,6 +43,17 @@ TEST_CASE("FileDescriptor") {
         REQUIRE(file.getSize() == 11);
     }
 
+    SECTION("Дописывание в конец") {
+        FileDescriptor file("log", 0, owner, 100);
+        file.writeContent("first");
+        REQUIRE(file.appendContent(" second"));
+        REQUIRE(file.readContent() == "first second");
+        REQUIRE(file.getSize() == 12);
+
+        file.setMode(Lock::WriteLock);
+        REQUIRE_THROWS_AS(file.appendContent("x"), std::runtime_error);
+    }
+
     SECTION("Очистка содержимого") {
         FileDescriptor file("test", 0, owner, 100);
 
@@ -46,8 +70,9 @@ TEST_CASE("FileDescriptor") {
         FileDescriptor file("test", 0, owner, 100);
 
         file.setOwner(newOwner);
-        REQUIRE(file.getOwner().getId() == 2);
-        REQUIRE(file.getOwner().getName() == "new_owner");
+        REQUIRE(file.getOwnerId() == 2);
+        REQUIRE(file.checkPermission(2, {}, PermissionType::Write));
+        REQUIRE_FALSE(file.checkPermission(1, {}, PermissionType::Write));
     }
 
     SECTION("Смена адреса родительской директории") {
@@ -124,21 +149,27 @@ TEST_CASE("FileDescriptor") {
     }
 
     SECTION("Проверка временных меток") {
-        auto start_time = std::chrono::system_clock::now();
+        auto start_time = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
         FileDescriptor file("test", 0, owner, 100);
 
         REQUIRE(file.getCreateTime() >= start_time);
         REQUIRE(file.getLastModifyTime() >= start_time);
 
-        auto before_write = std::chrono::system_clock::now();
+        auto before_write = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
         file.writeContent("test");
         REQUIRE(file.getLastModifyTime() >= before_write);
 
-        auto custom_time = std::chrono::system_clock::now() - std::chrono::hours(1);
+        std::chrono::system_clock::time_point custom_time =
+            std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now() - std::chrono::hours(1));
         file.setCreateTime(custom_time);
         file.setLastModifyTime(custom_time);
         REQUIRE(file.getCreateTime() == custom_time);
         REQUIRE(file.getLastModifyTime() == custom_time);
+
+        file.setLastModifyTime(custom_time + std::chrono::milliseconds(900));
+        REQUIRE(file.getLastModifyTime() == custom_time);
+        file.setCreateTime(std::chrono::system_clock::time_point(std::chrono::seconds(-5)));
+        REQUIRE(file.getCreateTime().time_since_epoch().count() == 0);
     }
 
     SECTION("Проверка ACL") {
@@ -218,4 +249,404 @@ TEST_CASE("FileDescriptor Edge Cases") {
         REQUIRE(file.truncateContent(0));
         REQUIRE(file.readContent().empty());
     }
+
+    SECTION("Содержимое в заданном ресурсе памяти") {
+        alignas(std::max_align_t) char buffer[1024];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        FileDescriptor file("arena", 0, owner, 100, &arena);
+
+        std::string text(200, 'x');
+        REQUIRE(file.appendContent(text));
+        REQUIRE(file.readContent() == text);
+        REQUIRE(file.getSize() == 200);
+        REQUIRE_THROWS_AS(file.appendContent(std::string(2000, 'y')), std::bad_alloc);
+
+        // Полная перезапись хранится в ContentStore и память файла не использует.
+        REQUIRE(file.writeContent(std::string(2000, 'y')));
+        REQUIRE(file.getSize() == 2000);
+    }
+}
+
+TEST_CASE("FileContent") {
+    SECTION("Небольшое содержимое хранится одной строкой") {
+        FileContent content;
+        content.assign("abc");
+        content.append("def");
+        REQUIRE(content.str() == "abcdef");
+        REQUIRE(content.size() == 6);
+        REQUIRE_FALSE(content.isChunked());
+    }
+
+    SECTION("Большое содержимое делится на фрагменты") {
+        FileContent content;
+        std::string expected;
+        for (int i = 0; i < 5000; i++) {
+            std::string line = "line " + std::to_string(i) + "\n";
+            content.append(line);
+            expected += line;
+        }
+        REQUIRE(content.isChunked());
+        REQUIRE(content.size() == expected.size());
+        REQUIRE(content.chunkCount() == (expected.size() + FileContent::CHUNK_SIZE - 1) / FileContent::CHUNK_SIZE);
+        REQUIRE(content.str() == expected);
+
+        size_t parts = 0;
+        content.forEachChunk([&](std::string_view part) {
+            if (++parts < content.chunkCount()) REQUIRE(part.size() == FileContent::CHUNK_SIZE);
+        });
+        REQUIRE(parts == content.chunkCount());
+    }
+
+    SECTION("Одна большая запись и усечение через границы фрагментов") {
+        FileContent content;
+        std::string data(FileContent::CHUNK_SIZE * 3 + 17, 'q');
+        for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<char>('a' + i % 26);
+        content.assign(data);
+        REQUIRE(content.chunkCount() == 4);
+
+        REQUIRE(content.truncate(FileContent::CHUNK_SIZE * 2));
+        REQUIRE(content.chunkCount() == 2);
+        REQUIRE(content.str() == data.substr(0, FileContent::CHUNK_SIZE * 2));
+        REQUIRE_FALSE(content.truncate(data.size()));
+
+        content.append(std::string_view(data).substr(FileContent::CHUNK_SIZE * 2));
+        REQUIRE(content.str() == data);
+
+        REQUIRE(content.truncate(10));
+        REQUIRE_FALSE(content.isChunked());
+        REQUIRE(content.str() == data.substr(0, 10));
+        content.clear();
+        REQUIRE(content.empty());
+    }
+}
+
+TEST_CASE("ContentView") {
+    User owner(1, "owner");
+
+    SECTION("Чтение не копирует данные") {
+        FileDescriptor file("big", 0, owner, 100);
+        std::string data(FileContent::CHUNK_SIZE * 2 + 100, 'z');
+        file.writeContent(data);
+        ContentView first = file.viewContent();
+        ContentView second = file.viewContent();
+        REQUIRE(first.chunkCount() == 3);
+        REQUIRE(first.chunk(0).data() == second.chunk(0).data());
+        REQUIRE(first == second);
+        REQUIRE(first == data);
+        REQUIRE(first.str() == data);
+    }
+
+    SECTION("Представление удерживает версию, запись копирует только изменяемый фрагмент") {
+        FileDescriptor file("log", 0, owner, 100);
+        std::string data(FileContent::CHUNK_SIZE + 10, 'a');
+        file.writeContent(data);
+        ContentView before = file.viewContent();
+        const char* firstChunk = before.chunk(0).data();
+
+        file.appendContent("tail");
+        ContentView after = file.viewContent();
+        REQUIRE(before == data);
+        REQUIRE(after == data + "tail");
+        REQUIRE(after.chunk(0).data() == firstChunk);
+        REQUIRE(after.chunk(1).data() != before.chunk(1).data());
+        REQUIRE_FALSE(before == after);
+
+        file.writeContent("new");
+        REQUIRE(before.size() == data.size());
+        REQUIRE(file.viewContent() == "new");
+        REQUIRE(file.viewContent().isContiguous());
+        REQUIRE(file.viewContent().front() == "new");
+    }
+
+    SECTION("Совместное содержимое копируется при первой записи") {
+        FileDescriptor source("source", 0, owner, 100);
+        FileDescriptor copy("copy", 0, owner, 101);
+        std::string data(FileContent::CHUNK_SIZE * 3, 'c');
+        source.writeContent(data);
+        REQUIRE(copy.shareContent(source.viewContent()));
+        REQUIRE(copy.getSize() == source.getSize());
+        for (size_t i = 0; i < 3; i++) REQUIRE(copy.viewContent().chunk(i).data() == source.viewContent().chunk(i).data());
+
+        copy.truncateContent(static_cast<int>(FileContent::CHUNK_SIZE + 5));
+        copy.appendContent("!");
+        REQUIRE(source.viewContent() == data);
+        REQUIRE(copy.viewContent() == data.substr(0, FileContent::CHUNK_SIZE + 5) + "!");
+        REQUIRE(copy.viewContent().chunk(0).data() == source.viewContent().chunk(0).data());
+
+        source.appendContent("?");
+        REQUIRE(source.viewContent() == data + "?");
+        REQUIRE(copy.getSize() == static_cast<int>(FileContent::CHUNK_SIZE + 6));
+    }
+
+    SECTION("Пустое содержимое и проверка блокировки") {
+        FileDescriptor file("empty", 0, owner, 100);
+        REQUIRE(file.viewContent().empty());
+        REQUIRE(file.viewContent() == "");
+        file.setMode(Lock::AllLock);
+        REQUIRE_THROWS_AS(file.viewContent(), std::runtime_error);
+    }
+}
+
+TEST_CASE("ContentStore") {
+    User owner(1, "owner");
+    ContentStore& store = ContentStore::instance();
+
+    SECTION("Одинаковое содержимое хранится одним блобом") {
+        std::string data(FileContent::CHUNK_SIZE * 2 + 7, 'd');
+        ContentStore::Statistics before = store.statistics();
+        {
+            FileDescriptor first("first", 0, owner, 100);
+            FileDescriptor second("second", 0, owner, 101);
+            first.writeContent(data);
+            second.writeContent(data);
+            REQUIRE(first.viewContent().chunk(0).data() == second.viewContent().chunk(0).data());
+            REQUIRE(store.statistics().blobs == before.blobs + 1);
+            REQUIRE(store.statistics().bytes == before.bytes + data.size());
+
+            second.appendContent("x");
+            REQUIRE(first.viewContent() == data);
+            REQUIRE(second.viewContent() == data + "x");
+        }
+        REQUIRE(store.statistics().blobs == before.blobs);
+        REQUIRE(store.statistics().bytes == before.bytes);
+    }
+
+    SECTION("Блоб не ссылается на память репозитория, в котором был записан") {
+        std::string data(FileContent::CHUNK_SIZE + 5, 'r');
+        FileDescriptor survivor("survivor", 0, owner, 101);
+        {
+            std::pmr::unsynchronized_pool_resource arena;
+            FileDescriptor file("file", 0, owner, 100, &arena);
+            file.appendContent(data);
+            ContentStore::BlobId id = 0;
+            ContentView blob = store.intern(file.viewContent(), &id);
+            REQUIRE(id != 0);
+            REQUIRE(blob.chunk(0).data() != file.viewContent().chunk(0).data());
+            survivor.shareContent(blob);
+        }
+        REQUIRE(survivor.viewContent() == data);
+    }
+
+    SECTION("Хеш не зависит от разбиения на фрагменты") {
+        FileContent content;
+        std::string data(FileContent::CHUNK_SIZE + 123, 'h');
+        content.append(data.substr(0, 10));
+        content.append(data.substr(10));
+        REQUIRE(content.isChunked());
+        REQUIRE(ContentStore::hashContent(content.view()) == ContentStore::hashContent(data));
+        REQUIRE(ContentStore::hashContent("a") != ContentStore::hashContent("b"));
+        REQUIRE(ContentStore::hashContent("abc") != 0);
+    }
+
+    SECTION("Поиск по идентификатору") {
+        FileDescriptor file("file", 0, owner, 100);
+        file.writeContent("stored");
+        ContentStore::BlobId id = 0;
+        ContentView view = store.intern(file.viewContent(), &id);
+        REQUIRE(id != 0);
+        REQUIRE(view.chunk(0).data() == file.viewContent().chunk(0).data());
+        REQUIRE(ContentStore::parseId(ContentStore::formatId(id)) == id);
+        REQUIRE(ContentStore::formatId(id).size() == 16);
+        REQUIRE(store.find(id) == "stored");
+        REQUIRE(ContentStore::parseId("not a blob") == 0);
+        REQUIRE(store.find(0).empty());
+        REQUIRE(store.intern(ContentView{}).empty());
+    }
+}
+
+TEST_CASE("LZCodec") {
+    auto roundTrip = [](const std::string& input) {
+        std::string packed(LZCodec::maxCompressedSize(input.size()), '\0');
+        packed.resize(LZCodec::compress(input, packed.data()));
+        std::string unpacked(input.size(), '\0');
+        REQUIRE(LZCodec::decompress(packed, unpacked.data(), unpacked.size()));
+        REQUIRE(unpacked == input);
+        return packed.size();
+    };
+
+    SECTION("Текст сжимается и восстанавливается") {
+        std::string text;
+        for (int i = 0; i < 2000; i++) text += "record " + std::to_string(i % 37) + ": status=ok, owner=admin\n";
+        REQUIRE(roundTrip(text) * 4 < text.size());
+    }
+
+    SECTION("Граничные случаи") {
+        roundTrip("");
+        roundTrip("abc");
+        roundTrip(std::string(100000, 'z'));
+        roundTrip(std::string(15, 'q') + std::string(300, 'w') + "tail");
+        std::mt19937 gen(7);
+        std::string noise(70000, '\0');
+        for (char& c : noise) c = static_cast<char>(gen());
+        REQUIRE(roundTrip(noise) <= LZCodec::maxCompressedSize(noise.size()));
+    }
+
+    SECTION("Повреждённые данные отвергаются") {
+        std::string input = "abcabcabcabcabcabcabcabc";
+        std::string packed(LZCodec::maxCompressedSize(input.size()), '\0');
+        packed.resize(LZCodec::compress(input, packed.data()));
+        std::string out(input.size(), '\0');
+        REQUIRE_FALSE(LZCodec::decompress(packed, out.data(), out.size() - 1));
+        REQUIRE_FALSE(LZCodec::decompress(packed.substr(0, packed.size() - 2), out.data(), out.size()));
+        REQUIRE_FALSE(LZCodec::decompress(std::string("\x04\x00\x00", 3), out.data(), 8));
+    }
+}
+
+TEST_CASE("Сжатие содержимого") {
+    User owner(1, "owner");
+    std::string text;
+    for (int i = 0; i < 3000; i++) text += "line " + std::to_string(i % 50) + " of an archived report\n";
+
+    SECTION("Сжатое содержимое читается без распаковки на месте") {
+        FileContent content;
+        content.assign(text);
+        REQUIRE(content.isChunked());
+        REQUIRE(content.compress());
+        REQUIRE(content.isCompressed());
+        REQUIRE(content.size() == text.size());
+        REQUIRE(content.storedSize() * 3 < text.size());
+        REQUIRE(content.view() == text);
+        REQUIRE(content.isCompressed());
+
+        ContentView first = content.view();
+        REQUIRE(content.view().chunk(0).data() == first.chunk(0).data());
+        REQUIRE_FALSE(content.compress());
+        REQUIRE(content.view().chunk(0).data() != first.chunk(0).data());
+        first = ContentView{};
+
+        REQUIRE(content.unpack());
+        REQUIRE_FALSE(content.unpack());
+        REQUIRE_FALSE(content.isCompressed());
+        REQUIRE(content.storedSize() == text.size());
+        REQUIRE(content.view() == text);
+    }
+
+    SECTION("Запись распаковывает содержимое") {
+        FileContent content;
+        content.append(text);
+        REQUIRE(content.compress());
+        content.append("tail");
+        REQUIRE_FALSE(content.isCompressed());
+        REQUIRE(content.view() == text + "tail");
+
+        REQUIRE(content.compress());
+        REQUIRE(content.truncate(10));
+        REQUIRE(content.view() == text.substr(0, 10));
+    }
+
+    SECTION("Небольшое и разделяемое содержимое не сжимается") {
+        FileContent small;
+        small.assign("short");
+        REQUIRE_FALSE(small.compress());
+
+        FileContent content;
+        content.append(text);
+        ContentView held = content.view();
+        REQUIRE_FALSE(content.compress());
+        held = ContentView{};
+        REQUIRE(content.compress());
+    }
+
+    SECTION("Чтение файла обновляет время обращения, а распаковка выполняется явно") {
+        FileDescriptor file("archive", 0, owner, 100);
+        file.writeContent(text);
+        REQUIRE(file.compressContent());
+        REQUIRE(file.isContentCompressed());
+        REQUIRE(file.getSize() == static_cast<int>(text.size()));
+        REQUIRE(file.viewContentAlways() == text);
+        REQUIRE(file.isContentCompressed());
+
+        auto before = file.getLastAccessTime();
+        REQUIRE(file.readContent() == text);
+        REQUIRE(file.isContentCompressed());
+        REQUIRE(file.getLastAccessTime() >= before);
+
+        REQUIRE(file.decompressContent());
+        REQUIRE_FALSE(file.isContentCompressed());
+        REQUIRE_FALSE(file.decompressContent());
+        REQUIRE(file.getStoredSize() == text.size());
+    }
+}
+
+TEST_CASE("FileLock") {
+    using namespace std::chrono_literals;
+    FileLock lock;
+
+    SECTION("Несколько читателей или один писатель") {
+        REQUIRE(sizeof(FileLock) == sizeof(uint32_t));
+        REQUIRE(lock.try_lock_shared());
+        REQUIRE(lock.try_lock_shared());
+        REQUIRE(lock.readerCount() == 2);
+        REQUIRE_FALSE(lock.try_lock());
+        REQUIRE_FALSE(lock.try_lock_for(10ms));
+        lock.unlock_shared();
+        lock.unlock_shared();
+
+        REQUIRE(lock.try_lock());
+        REQUIRE(lock.isLocked());
+        REQUIRE_FALSE(lock.try_lock_shared());
+        REQUIRE_FALSE(lock.try_lock_shared_for(10ms));
+        REQUIRE_FALSE(lock.try_lock_until(std::chrono::steady_clock::now() + 5ms));
+        lock.unlock();
+        REQUIRE_FALSE(lock.isLocked());
+        REQUIRE(lock.try_lock_shared_for(10ms));
+        lock.unlock_shared();
+    }
+
+    SECTION("Ожидающий писатель не пропускает новых читателей") {
+        lock.lock_shared();
+        std::atomic<bool> acquired{false};
+        std::thread writer([&] {
+            std::unique_lock<FileLock> guard(lock);
+            acquired = true;
+        });
+        auto deadline = std::chrono::steady_clock::now() + 5s;
+        bool readersBlocked = false;
+        while (!readersBlocked && std::chrono::steady_clock::now() < deadline) {
+            if (lock.try_lock_shared()) lock.unlock_shared();
+            else readersBlocked = true;
+        }
+        REQUIRE(readersBlocked);
+        REQUIRE_FALSE(acquired);
+        lock.unlock_shared();
+        writer.join();
+        REQUIRE(acquired);
+        REQUIRE(lock.try_lock_shared());
+        lock.unlock_shared();
+    }
+
+    SECTION("Писатель, не дождавшийся захвата, пропускает читателей") {
+        lock.lock_shared();
+        REQUIRE_FALSE(lock.try_lock_for(20ms));
+        REQUIRE(lock.try_lock_shared());
+        lock.unlock_shared();
+        lock.unlock_shared();
+    }
+
+    SECTION("Писатели сериализуются, читатели видят согласованное состояние") {
+        long first = 0;
+        long second = 0;
+        std::atomic<bool> consistent{true};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 2000; i++) {
+                    std::unique_lock<FileLock> guard(lock);
+                    first++;
+                    second++;
+                }
+            });
+            threads.emplace_back([&] {
+                for (int i = 0; i < 2000; i++) {
+                    std::shared_lock<FileLock> guard(lock);
+                    if (first != second) consistent = false;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        REQUIRE(consistent);
+        REQUIRE(first == 8000);
+        REQUIRE(lock.readerCount() == 0);
+        REQUIRE_FALSE(lock.isLocked());
+    }
 }
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "Entity/User/user.h"
 #include "Entity/Directory/realisation/directory_descriptor.h"
 #include "Entity/File/realisation/file_descriptor.h"
+#include "Entity/FSObject/interface/object_cast.h"
+#include <algorithm>
+#include <memory_resource>
 
 TEST_CASE("FileSystemRepository") {
     FileSystemRepository repo;
@@ -157,6 +160,140 @@ TEST_CASE("FileSystemRepository") {
         REQUIRE(repo2.getAllObjects().size() == 1);
     }
 
+    SECTION("Пулы объектов") {
+        ObjectPtr dir = repo.allocateDirectory("pooled", 0, admin, repo.getAddress());
+        unsigned int dirAddress = dir->getAddress();
+        REQUIRE(dynamic_cast<IDirectory*>(dir.get()) != nullptr);
+        REQUIRE(repo.getRootDirectory()->addChild(dir.get()));
+        REQUIRE(repo.saveObject(std::move(dir)));
+        std::vector<unsigned int> files;
+        for (int i = 0; i < 100; i++) {
+            ObjectPtr file = repo.allocateFile("f" + std::to_string(i), dirAddress, admin, repo.getAddress());
+            REQUIRE(dynamic_cast<IFile*>(file.get()) != nullptr);
+            files.push_back(file->getAddress());
+            REQUIRE(repo.saveObject(std::move(file)));
+        }
+        REQUIRE(repo.getFilePool().size() == 100);
+        REQUIRE(repo.getDirectoryPool().size() == 1);
+        REQUIRE(repo.getObjectByPath("/pooled")->getAddress() == dirAddress);
+
+        size_t slabs = repo.getFilePool().slabCount();
+        REQUIRE(repo.deleteObject(files[10]));
+        REQUIRE(repo.getFilePool().size() == 99);
+        ObjectPtr reused = repo.allocateFile("again", dirAddress, admin, repo.getAddress());
+        REQUIRE(repo.saveObject(std::move(reused)));
+        REQUIRE(repo.getFilePool().slabCount() == slabs);
+
+        {
+            ObjectPtr unsaved = repo.allocateFile("unsaved", dirAddress, admin, repo.getAddress());
+            REQUIRE(repo.getFilePool().size() == 101);
+        }
+        REQUIRE(repo.getFilePool().size() == 100);
+
+        repo.clear();
+        REQUIRE(repo.getFilePool().size() == 0);
+        REQUIRE(repo.getFilePool().slabCount() == 0);
+        REQUIRE(repo.getDirectoryPool().slabCount() == 0);
+        REQUIRE(repo.getAllObjects().size() == 1);
+    }
+
+    SECTION("Таблица объектов: повторное использование адресов и поколения") {
+        ObjectPtr dir = repo.allocateDirectory("dense", 0, admin, repo.getAddress());
+        unsigned int dirAddress = dir->getAddress();
+        REQUIRE(repo.getRootDirectory()->addChild(dir.get()));
+        REQUIRE(repo.saveObject(std::move(dir)));
+        auto* denseDir = repo.getDirectoryByPath("/dense");
+        REQUIRE(denseDir != nullptr);
+
+        ObjectPtr nested = repo.allocateDirectory("nested", dirAddress, admin, repo.getAddress());
+        unsigned int nestedAddress = nested->getAddress();
+        REQUIRE(denseDir->addChild(nested.get()));
+        auto* nestedDir = asDirectory(nested.get());
+        REQUIRE(repo.saveObject(std::move(nested)));
+        ObjectPtr file = repo.allocateFile("leaf", nestedAddress, admin, repo.getAddress());
+        unsigned int fileAddress = file->getAddress();
+        REQUIRE(nestedDir->addChild(file.get()));
+        REQUIRE(repo.saveObject(std::move(file)));
+        size_t before = repo.getAllObjects().size();
+
+        auto handle = repo.getHandle(fileAddress);
+        REQUIRE(repo.getObjectByHandle(handle) == repo.getObjectByAddress(fileAddress));
+        REQUIRE(repo.getHandle(9999).address == 0);
+
+        REQUIRE(repo.deleteObject(dirAddress));
+        REQUIRE_FALSE(repo.objectExists(dirAddress));
+        REQUIRE_FALSE(repo.objectExists(nestedAddress));
+        REQUIRE_FALSE(repo.objectExists(fileAddress));
+        REQUIRE(repo.getAllObjects().size() == before - 3);
+        REQUIRE(repo.getObjectByHandle(handle) == nullptr);
+
+        std::vector<unsigned int> reused;
+        for (int i = 0; i < 3; i++) reused.push_back(repo.getAddress());
+        std::sort(reused.begin(), reused.end());
+        std::vector<unsigned int> freed = {dirAddress, nestedAddress, fileAddress};
+        std::sort(freed.begin(), freed.end());
+        REQUIRE(reused == freed);
+
+        REQUIRE(repo.saveObject(repo.allocateFile("again", 0, admin, fileAddress)));
+        REQUIRE(repo.getObjectByAddress(fileAddress)->getName() == "again");
+        REQUIRE(repo.getObjectByHandle(handle) == nullptr);
+        REQUIRE(repo.getObjectByHandle(repo.getHandle(fileAddress)) == repo.getObjectByAddress(fileAddress));
+
+        auto rootHandle = repo.getHandle(0);
+        auto againHandle = repo.getHandle(fileAddress);
+        repo.clear();
+        REQUIRE(repo.getObjectByHandle(rootHandle) == asObject(repo.getRootDirectory()));
+        REQUIRE(repo.saveObject(repo.allocateFile("fresh", 0, admin, fileAddress)));
+        REQUIRE(repo.getObjectByHandle(againHandle) == nullptr);
+    }
+
+    SECTION("Кэш путей и moveObject") {
+        auto makeDir = [&](const std::string& name, unsigned int parentAddress) {
+            ObjectPtr dir = repo.allocateDirectory(name, parentAddress, admin, repo.getAddress());
+            auto* parent = asDirectory(repo.getObjectByAddress(parentAddress));
+            REQUIRE(parent->addChild(dir.get()));
+            unsigned int address = dir->getAddress();
+            REQUIRE(repo.saveObject(std::move(dir)));
+            return address;
+        };
+        unsigned int a = makeDir("a", 0);
+        unsigned int b = makeDir("b", a);
+        unsigned int c = makeDir("c", b);
+        unsigned int other = makeDir("other", 0);
+
+        auto before = repo.getPathCacheStats();
+        REQUIRE(repo.getObjectByPath("/a/b/c")->getAddress() == c);
+        REQUIRE(repo.getObjectByPath("/a/b/c")->getAddress() == c);
+        REQUIRE(repo.getObjectByPath("/a/./b/../b/c")->getAddress() == c);
+        auto after = repo.getPathCacheStats();
+        REQUIRE(after.misses == before.misses + 1);
+        REQUIRE(after.hits == before.hits + 2);
+        REQUIRE(repo.getObjectByPath("/a//b/c")->getAddress() == c);
+        REQUIRE(repo.getPathCacheStats().hits == after.hits);
+
+        REQUIRE(repo.getObjectByPath("/a/b")->getAddress() == b);
+        REQUIRE(repo.moveObject(b, other, "moved"));
+        REQUIRE(repo.getObjectByPath("/a/b") == nullptr);
+        REQUIRE(repo.getObjectByPath("/a/b/c") == nullptr);
+        REQUIRE(repo.getObjectByPath("/other/moved/c")->getAddress() == c);
+        REQUIRE(repo.getPath(repo.getObjectByAddress(c)) == "/other/moved/c");
+        REQUIRE_FALSE(repo.moveObject(other, c, "loop"));
+        REQUIRE_FALSE(repo.moveObject(0, other, "root"));
+        REQUIRE_FALSE(repo.moveObject(c, other, "bad/name"));
+        REQUIRE(repo.getObjectByPath("/other/moved/c")->getAddress() == c);
+
+        REQUIRE(repo.deleteObject(c));
+        REQUIRE(repo.getObjectByPath("/other/moved/c") == nullptr);
+        unsigned int reused = makeDir("c", a);
+        REQUIRE(reused == c);
+        REQUIRE(repo.getObjectByPath("/other/moved/c") == nullptr);
+        REQUIRE(repo.getObjectByPath("/a/c")->getAddress() == c);
+
+        repo.clear();
+        REQUIRE(repo.getPathCacheStats().size == 0);
+        REQUIRE(repo.getObjectByPath("/a/c") == nullptr);
+    }
+
     SECTION("getDirectoryByPath и getFileByPath") {
         auto dir = std::make_unique<DirectoryDescriptor>("testdir", 0, admin, repo.getAddress());
         unsigned int dirAddress = dir->getAddress();
@@ -255,6 +392,19 @@ TEST_CASE("FileSystemRepository") {
         }
     }
 
+    SECTION("Ресурс памяти репозитория") {
+        REQUIRE(repo.getMemoryResource() == std::pmr::get_default_resource());
+
+        std::pmr::monotonic_buffer_resource arena;
+        FileSystemRepository arenaRepo(&arena);
+        REQUIRE(arenaRepo.getMemoryResource() == &arena);
+        auto dir = std::make_unique<DirectoryDescriptor>("dir", 0, admin, arenaRepo.getAddress(), arenaRepo.getMemoryResource());
+        auto* dirPtr = dir.get();
+        REQUIRE(arenaRepo.saveObject(std::move(dir)));
+        REQUIRE(arenaRepo.getRootDirectory()->addChild(dirPtr));
+        REQUIRE(arenaRepo.getDirectoryByPath("/dir") == dirPtr);
+    }
+
     SECTION("getObjectByAddress") {
         auto file = std::make_unique<FileDescriptor>("test_txt", 0, admin, repo.getAddress());
         unsigned int address = file->getAddress();
@@ -500,4 +650,59 @@ TEST_CASE("Path - граничные случаи и обработка ошиб
         REQUIRE(Path::matchesPattern("file.txt", "file\\*.txt") == false);
         REQUIRE(Path::matchesPattern("file*star.txt", "file\\*star.txt") == false);
     }
+}
+
+TEST_CASE("PathCache") {
+    PathCache<int> cache(2);
+    auto always = [](int) { return true; };
+
+    SECTION("Попадания, промахи и устаревшие записи") {
+        REQUIRE_FALSE(cache.find("/a", always));
+        cache.insert("/a", 1);
+        REQUIRE(cache.find("/a", always) == 1);
+        REQUIRE_FALSE(cache.find("/a", [](int value) { return value != 1; }));
+        REQUIRE_FALSE(cache.find("/a", always));
+        auto stats = cache.getStats();
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.misses == 3);
+        REQUIRE(stats.size == 0);
+    }
+
+    SECTION("Размер ограничен двумя поколениями") {
+        for (int i = 0; i < 100; i++) cache.insert("/f" + std::to_string(i), i);
+        REQUIRE(cache.getStats().size <= 4);
+        REQUIRE(cache.find("/f99", always) == 99);
+        REQUIRE_FALSE(cache.find("/f0", always));
+
+        cache.insert("/hot", 1);
+        cache.insert("/x", 2);
+        cache.insert("/y", 3);
+        REQUIRE(cache.find("/hot", always) == 1);
+        cache.insert("/z", 4);
+        REQUIRE(cache.find("/hot", always) == 1);
+    }
+
+    SECTION("Удаление пути вместе с вложенными") {
+        PathCache<int> large;
+        large.insert("/dir", 1);
+        large.insert("/dir/file", 2);
+        large.insert("/dir2", 3);
+        large.invalidate("/dir");
+        REQUIRE_FALSE(large.find("/dir", always));
+        REQUIRE_FALSE(large.find("/dir/file", always));
+        REQUIRE(large.find("/dir2", always) == 3);
+        large.invalidate("/");
+        REQUIRE(large.getStats().size == 0);
+    }
+
+    SECTION("В большом кэше перемещение делает устаревшими все записи") {
+        PathCache<int> large;
+        for (size_t i = 0; i <= PathCache<int>::SCAN_LIMIT; i++) large.insert("/f" + std::to_string(i), static_cast<int>(i));
+        large.insert("/dir/file", 1);
+        large.invalidate("/dir");
+        REQUIRE_FALSE(large.find("/dir/file", always));
+        REQUIRE_FALSE(large.find("/f0", always));
+        large.insert("/f0", 0);
+        REQUIRE(large.find("/f0", always) == 0);
+    }
 }
\ No newline at end of file
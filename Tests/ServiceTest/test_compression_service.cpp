@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Service/CompressionService/realisation/compression_service.h"
+#include "Repository/FSRep/realisation/fs_repository.h"
+#include "Entity/File/realisation/file_descriptor.h"
+#include "Entity/User/user.h"
+#include <chrono>
+#include <string>
+
+TEST_CASE("CompressionService") {
+    FileSystemRepository fsRepo;
+    User admin(1, "admin");
+    CompressionService service(fsRepo, std::chrono::seconds(60), std::chrono::seconds(1));
+
+    std::string text;
+    for (int i = 0; i < 2000; i++) text += "entry " + std::to_string(i % 20) + " unchanged since last audit\n";
+
+    auto addFile = [&](const std::string& name, const std::string& content) {
+        unsigned int address = fsRepo.getAddress();
+        auto file = std::make_unique<FileDescriptor>(name, 0, admin, address, fsRepo.getMemoryResource());
+        file->writeContent(content);
+        auto* ptr = file.get();
+        REQUIRE(fsRepo.saveObject(std::move(file)));
+        return ptr;
+    };
+    FileDescriptor* cold = addFile("cold.log", text);
+    FileDescriptor* small = addFile("small.txt", "tiny");
+    auto now = std::chrono::system_clock::now();
+
+    SECTION("Сжимаются только файлы без обращений дольше заданного времени") {
+        REQUIRE(service.compressIdle(now, std::chrono::seconds(60)) == 0);
+        REQUIRE_FALSE(cold->isContentCompressed());
+
+        REQUIRE(service.compressIdle(now + std::chrono::minutes(2), std::chrono::seconds(60)) == 1);
+        REQUIRE(cold->isContentCompressed());
+        REQUIRE_FALSE(small->isContentCompressed());
+        REQUIRE(service.compressIdle(now + std::chrono::minutes(2), std::chrono::seconds(60)) == 0);
+
+        REQUIRE(cold->readContent() == text);
+        REQUIRE(cold->decompressContent());
+        REQUIRE_FALSE(cold->isContentCompressed());
+        REQUIRE(service.compressIdle(std::chrono::system_clock::now(), std::chrono::seconds(60)) == 0);
+    }
+
+    SECTION("Отчёт о памяти показывает объём до и после сжатия") {
+        MemoryReport before = service.getMemoryReport();
+        REQUIRE(before.files == 2);
+        REQUIRE(before.compressedFiles == 0);
+        REQUIRE(before.contentBytes == text.size() + 4);
+        REQUIRE(before.storedBytes == before.contentBytes);
+
+        service.compressIdle(now, std::chrono::seconds(0));
+        MemoryReport after = service.getMemoryReport();
+        REQUIRE(after.compressedFiles == 1);
+        REQUIRE(after.contentBytes == before.contentBytes);
+        REQUIRE(after.storedBytes * 3 < after.contentBytes);
+    }
+
+    SECTION("Фоновый поток запускается и останавливается") {
+        REQUIRE_FALSE(service.isRunning());
+        service.setIdleInterval(std::chrono::seconds(0));
+        service.start();
+        REQUIRE(service.isRunning());
+        {
+            auto guard = service.hold();
+            REQUIRE(cold->viewContent() == text);
+        }
+        service.stop();
+        REQUIRE_FALSE(service.isRunning());
+        REQUIRE(service.getIdleInterval() == std::chrono::seconds(0));
+    }
+}
\ No newline at end of file
@@ -7,6 +7,10 @@
 #include "Repository/UserRep/realisation/user_repository.h"
 #include "Repository/GroupRep/realisation/group_repository.h"
 #include <memory>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace {
 void initializeTestEnvironment(UserRepository& userRepo, GroupRepository& groupRepo, IFileSystemRepository& fsRepo, SecurityService& securityService, User*& admin, User*& testUser) {
@@ -48,16 +52,20 @@ public:
         return realRepo.getFileByPath(path);
     }
 
-    bool saveObject(std::unique_ptr<IFileSystemObject> object) override {
+    bool saveObject(ObjectPtr object) override {
         if (shouldFailSave) {
             return false;
         }
         return realRepo.saveObject(std::move(object));
     }
+    void reserve(size_t addressLimit) override { realRepo.reserve(addressLimit); }
 
     bool deleteObject(unsigned int address) override {
         return realRepo.deleteObject(address);
     }
+    bool moveObject(unsigned int address, unsigned int newParentAddress, const std::string& newName) override {
+        return realRepo.moveObject(address, newParentAddress, newName);
+    }
     bool pathExists(const std::string& path) const override {
         return realRepo.pathExists(path);
     }
@@ -71,6 +79,7 @@ public:
     std::string getPath(IFileSystemObject* object) const override {
         return realRepo.getPath(object);
     }
+    uint64_t getPathGeneration() const override { return realRepo.getPathGeneration(); }
     void setRootDirectory(IDirectory* rootDirectory) override { realRepo.setRootDirectory(rootDirectory); }
     std::vector<IFileSystemObject*> getAllObjects() const override { return realRepo.getAllObjects(); }
     IFileSystemObject* getObjectByAddress(unsigned int address) const override {
@@ -78,6 +87,16 @@ public:
     }
     bool objectExists(unsigned int address) const override { return realRepo.objectExists(address); }
     void clear() override { realRepo.clear(); }
+    std::pmr::memory_resource* getMemoryResource() const override { return realRepo.getMemoryResource(); }
+    ObjectPtr allocateFile(const std::string& name, unsigned int parentAddress, const User& owner, unsigned int address) override {
+        return realRepo.allocateFile(name, parentAddress, owner, address);
+    }
+    ObjectPtr allocateDirectory(const std::string& name, unsigned int parentAddress, const User& owner, unsigned int address) override {
+        return realRepo.allocateDirectory(name, parentAddress, owner, address);
+    }
+    ACL resolveInheritance(const IDirectory& directory) const override { return realRepo.resolveInheritance(directory); }
+    ACL getInheritedACL(const IFileSystemObject& object) const override { return realRepo.getInheritedACL(object); }
+    void invalidateInheritance() override { realRepo.invalidateInheritance(); }
 };
 }
 
@@ -165,6 +184,20 @@ TEST_CASE("FileSystemService") {
         fsService.createFile(*admin, "/readwrite.txt", "Initial");
         auto content = fsService.readFile(*admin, "/readwrite.txt");
         REQUIRE(content == "Initial");
+
+        fsService.createFile(*admin, "/empty.txt");
+        REQUIRE(fsService.readFile(*admin, "/empty.txt") == "");
+        REQUIRE_FALSE(fsService.readFile(*admin, "/missing.txt"));
+        fsService.createDirectory(*admin, "/dir");
+        REQUIRE_FALSE(fsService.readFile(*admin, "/dir"));
+
+        std::string text;
+        for (int i = 0; i < 1000; i++) text += "archived line " + std::to_string(i % 10) + "\n";
+        IFile* archive = fsService.createFile(*admin, "/archive.txt", text);
+        REQUIRE(archive != nullptr);
+        REQUIRE(archive->compressContent());
+        REQUIRE(fsService.readFile(*admin, "/archive.txt") == text);
+        REQUIRE_FALSE(archive->isContentCompressed());
     }
 
     SECTION("writeFile") {
@@ -192,6 +225,46 @@ TEST_CASE("FileSystemService") {
         REQUIRE(fsService.readFile(*admin, "/readwrite.txt") == "Updated Appended");
     }
 
+    SECTION("concurrent readFile and writeFile") {
+        auto userRepo = std::make_unique<UserRepository>();
+        auto groupRepo = std::make_unique<GroupRepository>();
+        auto fsRepo = std::make_unique<FileSystemRepository>();
+        auto securityService = std::make_unique<SecurityService>(*userRepo, *groupRepo);
+        auto sessionService = std::make_unique<SessionService>(*securityService, *fsRepo);
+        FileSystemService fsService(*fsRepo, *securityService, *sessionService);
+
+        User* admin = nullptr;
+        User* testUser = nullptr;
+        initializeTestEnvironment(*userRepo, *groupRepo, *fsRepo, *securityService, admin, testUser);
+
+        sessionService->setCurrentUser(admin);
+        sessionService->setCurrentDirectory(fsRepo->getRootDirectory());
+
+        const std::string first(40000, 'a');
+        const std::string second(40000, 'b');
+        fsService.createFile(*admin, "/shared.txt", first);
+        std::atomic<bool> consistent{true};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 2; t++) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 200; i++) {
+                    fsService.writeFile(*admin, "/shared.txt", (i + t) % 2 ? first : second);
+                    fsService.writeFile(*admin, "/shared.txt", "", true);
+                }
+            });
+        }
+        for (int t = 0; t < 3; t++) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 400; i++) {
+                    std::optional<ContentView> content = fsService.readFile(*admin, "/shared.txt");
+                    if (!content || (!(*content == first) && !(*content == second))) consistent = false;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        REQUIRE(consistent);
+    }
+
     SECTION("listDirectory") {
         auto userRepo = std::make_unique<UserRepository>();
         auto groupRepo = std::make_unique<GroupRepository>();
@@ -305,6 +378,11 @@ TEST_CASE("FileSystemService") {
         REQUIRE(fsService.exists("/source.txt"));
         REQUIRE(fsService.exists("/dest.txt"));
         REQUIRE(fsService.readFile(*admin, "/source.txt") == fsService.readFile(*admin, "/dest.txt"));
+        REQUIRE(fsService.readFile(*admin, "/source.txt")->front().data() == fsService.readFile(*admin, "/dest.txt")->front().data());
+
+        REQUIRE(fsService.writeFile(*admin, "/dest.txt", " changed", true));
+        REQUIRE(fsService.readFile(*admin, "/source.txt") == "Source content");
+        REQUIRE(fsService.readFile(*admin, "/dest.txt") == "Source content changed");
 
         bool overwriteFail = fsService.copyFile(*admin, "/source.txt", "/dest.txt");
         REQUIRE_FALSE(overwriteFail);
@@ -326,12 +404,20 @@ TEST_CASE("FileSystemService") {
         sessionService->setCurrentDirectory(fsRepo->getRootDirectory());
 
         fsService.createFile(*admin, "/tomove.txt", "Content to move");
+        IFileSystemObject* original = fsRepo->getObjectByPath("/tomove.txt");
 
         bool success = fsService.moveFile(*admin, "/tomove.txt", "/moved.txt");
         REQUIRE(success);
         REQUIRE_FALSE(fsService.exists("/tomove.txt"));
         REQUIRE(fsService.exists("/moved.txt"));
         REQUIRE(fsService.readFile(*admin, "/moved.txt") == "Content to move");
+        REQUIRE(fsRepo->getObjectByPath("/moved.txt") == original);
+
+        fsService.createFile(*admin, "/other.txt", "x");
+        REQUIRE_FALSE(fsService.moveFile(*admin, "/moved.txt", "/other.txt"));
+        REQUIRE_FALSE(fsService.moveFile(*admin, "/missing.txt", "/new.txt"));
+        REQUIRE_FALSE(fsService.moveFile(*testUser, "/moved.txt", "/stolen.txt"));
+        REQUIRE(fsService.exists("/moved.txt"));
     }
 
     SECTION("copyDirectory") {
@@ -361,6 +447,12 @@ TEST_CASE("FileSystemService") {
         REQUIRE(fsService.exists("/destDir/file1.txt"));
         REQUIRE(fsService.exists("/destDir/subdir"));
         REQUIRE(fsService.exists("/destDir/subdir/file2.txt"));
+        REQUIRE(fsService.readFile(*admin, "/destDir/subdir/file2.txt")->front().data() ==
+                fsService.readFile(*admin, "/sourceDir/subdir/file2.txt")->front().data());
+
+        REQUIRE(fsService.writeFile(*admin, "/sourceDir/subdir/file2.txt", "Edited"));
+        REQUIRE(fsService.readFile(*admin, "/destDir/subdir/file2.txt") == "File2");
+        REQUIRE(fsService.readFile(*admin, "/sourceDir/subdir/file2.txt") == "Edited");
     }
 
     SECTION("moveDirectory") {
@@ -381,11 +473,27 @@ TEST_CASE("FileSystemService") {
         fsService.createDirectory(*admin, "/tomoveDir");
         fsService.createFile(*admin, "/tomoveDir/file.txt", "Content");
 
+        IFileSystemObject* file = fsRepo->getObjectByPath("/tomoveDir/file.txt");
+
         bool success = fsService.moveDirectory(*admin, "/tomoveDir", "/movedDir");
         REQUIRE(success);
         REQUIRE_FALSE(fsService.exists("/tomoveDir"));
         REQUIRE(fsService.exists("/movedDir"));
         REQUIRE(fsService.exists("/movedDir/file.txt"));
+        REQUIRE(fsRepo->getObjectByPath("/movedDir/file.txt") == file);
+        REQUIRE(fsService.readFile(*admin, "/movedDir/file.txt") == "Content");
+
+        REQUIRE_FALSE(fsService.moveDirectory(*admin, "/movedDir", "/movedDir/inner"));
+        REQUIRE_FALSE(fsService.moveDirectory(*admin, "/movedDir/file.txt", "/file.txt"));
+        REQUIRE(fsService.exists("/movedDir/file.txt"));
+
+        sessionService->setCurrentDirectory(fsRepo->getDirectoryByPath("/movedDir"));
+        REQUIRE(fsService.exists("file.txt"));
+        REQUIRE(fsService.moveDirectory(*admin, "/movedDir", "/renamedDir"));
+        REQUIRE(fsService.exists("file.txt"));
+        REQUIRE(fsService.readFile(*admin, "file.txt") == "Content");
+        REQUIRE(fsService.createFile(*admin, "new.txt", "x"));
+        REQUIRE(fsService.exists("/renamedDir/new.txt"));
     }
 
     SECTION("changePermissions") {
@@ -422,6 +530,114 @@ TEST_CASE("FileSystemService") {
         REQUIRE(groupSuccess);
     }
 
+    SECTION("changePermissionsRecursive") {
+        auto userRepo = std::make_unique<UserRepository>();
+        auto groupRepo = std::make_unique<GroupRepository>();
+        auto fsRepo = std::make_unique<FileSystemRepository>();
+        auto securityService = std::make_unique<SecurityService>(*userRepo, *groupRepo);
+        auto sessionService = std::make_unique<SessionService>(*securityService, *fsRepo);
+        FileSystemService fsService(*fsRepo, *securityService, *sessionService);
+
+        User* admin = nullptr;
+        User* testUser = nullptr;
+        initializeTestEnvironment(*userRepo, *groupRepo, *fsRepo, *securityService, admin, testUser);
+
+        sessionService->setCurrentUser(admin);
+        sessionService->setCurrentDirectory(fsRepo->getRootDirectory());
+
+        fsService.createDirectory(*admin, "/tree");
+        fsService.createDirectory(*admin, "/tree/sub");
+        for (int i = 0; i < 5; i++) {
+            fsService.createFile(*admin, "/tree/f" + std::to_string(i), "x");
+            fsService.createFile(*admin, "/tree/sub/g" + std::to_string(i), "y");
+        }
+        IFileSystemObject* first = fsRepo->getObjectByPath("/tree/f0");
+        IFileSystemObject* nested = fsRepo->getObjectByPath("/tree/sub/g4");
+        REQUIRE(first->getSharedACL() == nested->getSharedACL());
+        fsService.createFile(*admin, "/outside.txt", "z");
+        IFileSystemObject* outside = fsRepo->getObjectByPath("/outside.txt");
+        ACL outsideBefore = outside->getSharedACL();
+
+        std::map<PermissionType, PermissionEffect> perms;
+        perms[PermissionType::Read] = PermissionEffect::Allow;
+        perms[PermissionType::Write] = PermissionEffect::Deny;
+        REQUIRE(fsService.changePermissionsRecursive(testUser->getId(), SubjectType::User, "/tree", perms));
+
+        for (const char* path : {"/tree", "/tree/sub", "/tree/f3", "/tree/sub/g0"}) {
+            IFileSystemObject* obj = fsRepo->getObjectByPath(path);
+            REQUIRE(securityService->canRead(*testUser, *obj));
+            REQUIRE_FALSE(securityService->canWrite(*testUser, *obj));
+        }
+        REQUIRE(first->getSharedACL() == nested->getSharedACL());
+        REQUIRE(outside->getSharedACL() == outsideBefore);
+        REQUIRE_FALSE(fsService.changePermissionsRecursive(testUser->getId(), SubjectType::User, "/missing", perms));
+    }
+
+    SECTION("changeInheritablePermissions") {
+        auto userRepo = std::make_unique<UserRepository>();
+        auto groupRepo = std::make_unique<GroupRepository>();
+        auto fsRepo = std::make_unique<FileSystemRepository>();
+        auto securityService = std::make_unique<SecurityService>(*userRepo, *groupRepo, fsRepo.get());
+        auto sessionService = std::make_unique<SessionService>(*securityService, *fsRepo);
+        FileSystemService fsService(*fsRepo, *securityService, *sessionService);
+
+        User* admin = nullptr;
+        User* testUser = nullptr;
+        initializeTestEnvironment(*userRepo, *groupRepo, *fsRepo, *securityService, admin, testUser);
+
+        sessionService->setCurrentUser(admin);
+        sessionService->setCurrentDirectory(fsRepo->getRootDirectory());
+
+        fsService.createDirectory(*admin, "/shared");
+        fsService.createDirectory(*admin, "/shared/a");
+        fsService.createDirectory(*admin, "/shared/a/b");
+        fsService.createFile(*admin, "/shared/a/b/deep.txt", "x");
+        fsService.createFile(*admin, "/outside.txt", "z");
+        IFileSystemObject* shared = fsRepo->getObjectByPath("/shared");
+        IFileSystemObject* deep = fsRepo->getObjectByPath("/shared/a/b/deep.txt");
+        IFileSystemObject* outside = fsRepo->getObjectByPath("/outside.txt");
+        ACL deepBefore = deep->getSharedACL();
+        REQUIRE_FALSE(securityService->canRead(*testUser, *deep));
+
+        std::map<PermissionType, PermissionEffect> grant;
+        grant[PermissionType::Read] = PermissionEffect::Allow;
+        REQUIRE(fsService.changeInheritablePermissions(testUser->getId(), SubjectType::User, "/shared", grant));
+
+        REQUIRE(securityService->canRead(*testUser, *deep));
+        REQUIRE(securityService->canRead(*testUser, *fsRepo->getObjectByPath("/shared/a")));
+        REQUIRE_FALSE(securityService->canRead(*testUser, *shared));
+        REQUIRE_FALSE(securityService->canRead(*testUser, *outside));
+        REQUIRE_FALSE(securityService->canWrite(*testUser, *deep));
+        REQUIRE(deep->getSharedACL() == deepBefore);
+
+        std::map<PermissionType, PermissionEffect> deny;
+        deny[PermissionType::Read] = PermissionEffect::Deny;
+        REQUIRE(fsService.changeInheritablePermissions(testUser->getId(), SubjectType::User, "/shared/a/b", deny));
+        REQUIRE_FALSE(securityService->canRead(*testUser, *deep));
+        REQUIRE(securityService->canRead(*testUser, *fsRepo->getObjectByPath("/shared/a/b")));
+
+        REQUIRE(fsService.changeInheritablePermissions(testUser->getId(), SubjectType::User, "/shared/a/b", grant));
+        REQUIRE(securityService->canRead(*testUser, *deep));
+        REQUIRE(securityService->getEffectivePermissions(*testUser, *deep)[PermissionType::Read]);
+
+        REQUIRE_FALSE(fsService.changeInheritablePermissions(testUser->getId(), SubjectType::User, "/outside.txt", grant));
+        REQUIRE_FALSE(fsService.changeInheritablePermissions(testUser->getId(), SubjectType::User, "/missing", grant));
+
+        fsService.createDirectory(*admin, "/public");
+        fsService.createFile(*admin, "/public/secret.txt", "s");
+        IFileSystemObject* secret = fsRepo->getObjectByPath("/public/secret.txt");
+        std::map<PermissionType, PermissionEffect> manage;
+        manage[PermissionType::ChangePermissions] = PermissionEffect::Allow;
+        REQUIRE(fsService.changePermissions(testUser->getId(), SubjectType::User, "/public", manage));
+
+        sessionService->setCurrentUser(testUser);
+        REQUIRE_FALSE(fsService.changeInheritablePermissions(testUser->getId(), SubjectType::User, "/public", grant));
+        REQUIRE_FALSE(securityService->canRead(*testUser, *secret));
+        REQUIRE_FALSE(fsService.changeInheritablePermissions(admin->getId(), SubjectType::User, "/public", deny));
+        REQUIRE(securityService->canRead(*admin, *secret));
+        REQUIRE(fsService.changePermissions(testUser->getId(), SubjectType::User, "/public", grant));
+    }
+
     SECTION("lockFile") {
         auto userRepo = std::make_unique<UserRepository>();
         auto groupRepo = std::make_unique<GroupRepository>();
@@ -9,7 +9,7 @@
 class MockFileSystemObject : public FileSystemObject {
 public:
     MockFileSystemObject(const std::string& name, unsigned int address, unsigned int parentAddress, const User& owner)
-        : FileSystemObject(name, parentAddress, owner, address) {}
+        : FileSystemObject(name, parentAddress, owner, address, ObjectType::File) {}
 
     void testSetPermissions(unsigned int id, SubjectType s_type, const std::vector<PermissionType>& permissions, PermissionEffect effect) {
         setPermissions(id, s_type, permissions, effect);
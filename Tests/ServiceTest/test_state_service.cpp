@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Loader/realisation/loader.h"
+#include "Entity/FSObject/interface/object_cast.h"
+#include "Repository/FSRep/realisation/fs_repository.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+TEST_CASE("FSStateService") {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "fs_state_service_test.yaml";
+
+    auto writeObject = [](std::ofstream& out, const std::string& type, unsigned long long address, const std::string& name,
+                          unsigned long long parent, const std::string& properties) {
+        out << "  - type: " << type << "\n"
+            << "    address: " << address << "\n"
+            << "    name: \"" << name << "\"\n"
+            << "    parentAddress: " << parent << "\n"
+            << "    ownerName: root\n"
+            << "    ownerId: 1\n"
+            << "    creationTime: 0\n"
+            << "    lastModifyTime: 0\n"
+            << "    properties: {" << properties << "}\n";
+    };
+
+    SECTION("Адреса из файла заменяются плотными") {
+        {
+            std::ofstream out(path);
+            out << "filesystem:\n";
+            writeObject(out, "DIR", 0, "/", 0, "children: \"4000000000\"");
+            writeObject(out, "DIR", 4000000000ULL, "big", 0, "children: \"3000000000\"");
+            writeObject(out, "FILE", 3000000000ULL, "f.txt", 4000000000ULL, "size: \"0\"");
+            writeObject(out, "FILE", 17, "orphan.txt", 99, "size: \"0\"");
+            out << "blobs: []\n";
+        }
+        FSLoader loader;
+        IFileSystemRepository& repo = loader.getFsRepository();
+        loader.getFsStateService().load(path.string());
+        std::filesystem::remove(path);
+
+        IFileSystemObject* big = repo.getObjectByPath("/big");
+        IFileSystemObject* file = repo.getObjectByPath("/big/f.txt");
+        REQUIRE(big);
+        REQUIRE(file);
+        REQUIRE(big->getAddress() < 4);
+        REQUIRE(file->getAddress() < 4);
+        REQUIRE(file->getParentDirectoryAddress() == big->getAddress());
+        REQUIRE(repo.getObjectByAddress(big->getAddress()) == big);
+        REQUIRE(repo.getObjectByAddress(file->getAddress()) == file);
+        REQUIRE(repo.getAllObjects().size() == 4);
+        REQUIRE(repo.getAddress() == 4);
+
+        for (IFileSystemObject* object : repo.getAllObjects()) {
+            if (object->getName() == "orphan.txt") REQUIRE(repo.getObjectByAddress(object->getParentDirectoryAddress()) == nullptr);
+        }
+
+        REQUIRE(repo.deleteObject(file->getAddress()));
+        REQUIRE_FALSE(asDirectory(big)->containChild("f.txt"));
+    }
+
+    SECTION("Загруженные объекты размещаются в пулах репозитория") {
+        {
+            std::ofstream out(path);
+            out << "filesystem:\n";
+            writeObject(out, "DIR", 0, "/", 0, "children: \"1\"");
+            writeObject(out, "DIR", 1, "dir", 0, "children: \"2 3\"");
+            writeObject(out, "FILE", 2, "a.txt", 1, "content: \"a\"");
+            writeObject(out, "FILE", 3, "b.txt", 1, "content: \"b\"");
+            out << "blobs: []\n";
+        }
+        FSLoader loader;
+        auto& repo = static_cast<FileSystemRepository&>(loader.getFsRepository());
+        loader.getFsStateService().load(path.string());
+        std::filesystem::remove(path);
+
+        REQUIRE(repo.getObjectByPath("/dir/a.txt"));
+        REQUIRE(repo.getFilePool().size() == 2);
+        REQUIRE(repo.getDirectoryPool().size() == 1);
+
+        repo.clear();
+        REQUIRE(repo.getFilePool().size() == 0);
+        REQUIRE(repo.getDirectoryPool().size() == 0);
+    }
+}
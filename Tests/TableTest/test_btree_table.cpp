@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Table/btree_table.h"
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <map>
+#include <memory_resource>
+#include <stdexcept>
+
+
+TEST_CASE("BTreeTable basic operations") {
+    SECTION("Default constructor") {
+        BTreeTable<int, std::string> tree;
+        REQUIRE(tree.empty());
+        REQUIRE(tree.size() == 0);
+        REQUIRE(tree.begin() == tree.end());
+    }
+
+    SECTION("Insert and find") {
+        BTreeTable<int, std::string> tree = {{2, "two"}, {1, "one"}, {3, "three"}};
+        REQUIRE(tree.size() == 3);
+        REQUIRE(tree.find(1)->value == "one");
+        REQUIRE(tree.find(3)->value == "three");
+        REQUIRE(tree.find(4) == tree.end());
+        REQUIRE_FALSE(tree.insert({1, "again"}).second);
+        REQUIRE(tree.at(1) == "one");
+        REQUIRE_THROWS_AS(tree.at(42), std::out_of_range);
+    }
+
+    SECTION("Insert or assign and operator[]") {
+        BTreeTable<std::string, int> tree;
+        REQUIRE(tree.insert_or_assign(std::string("a"), 1).second);
+        REQUIRE_FALSE(tree.insert_or_assign(std::string("a"), 2).second);
+        REQUIRE(tree.at("a") == 2);
+        tree["b"] = 5;
+        REQUIRE(tree.size() == 2);
+        REQUIRE(tree["b"] == 5);
+    }
+
+    SECTION("Erase by key and by iterator") {
+        BTreeTable<int, int> tree = {{1, 10}, {2, 20}, {3, 30}};
+        REQUIRE(tree.erase(2) == 1);
+        REQUIRE(tree.erase(2) == 0);
+        auto next = tree.erase(tree.find(1));
+        REQUIRE(next->key == 3);
+        REQUIRE(tree.size() == 1);
+        REQUIRE(tree.erase(3) == 1);
+        REQUIRE(tree.empty());
+        REQUIRE(tree.begin() == tree.end());
+    }
+
+    SECTION("Memory resource") {
+        std::pmr::monotonic_buffer_resource arena;
+        BTreeTable<int, int, 8, 4> tree(&arena);
+        for (int i = 0; i < 500; i++) tree.insert({i, i});
+        REQUIRE(tree.get_resource() == &arena);
+        BTreeTable<int, int, 8, 4> copy(tree);
+        REQUIRE(copy.get_resource() == std::pmr::get_default_resource());
+        REQUIRE(copy == tree);
+        BTreeTable<int, int, 8, 4> target(&arena);
+        target = copy;
+        REQUIRE(target.get_resource() == &arena);
+        REQUIRE(target == tree);
+        for (int i = 0; i < 500; i += 2) REQUIRE(tree.erase(i) == 1);
+        REQUIRE(tree.size() == 250);
+    }
+
+    SECTION("Copy, move and swap") {
+        BTreeTable<int, int> original;
+        for (int i = 0; i < 500; i++) original.insert({i, i * i});
+        BTreeTable<int, int> copy(original);
+        REQUIRE(copy == original);
+        BTreeTable<int, int> moved(std::move(original));
+        REQUIRE(moved == copy);
+        REQUIRE(original.empty());
+        BTreeTable<int, int> other = {{-1, 1}};
+        swap(other, moved);
+        REQUIRE(other == copy);
+        REQUIRE(moved.size() == 1);
+    }
+}
+
+TEST_CASE("BTreeTable ordering and bounds") {
+    BTreeTable<int, int, 4, 4> tree;
+    for (int i = 0; i < 200; i += 2) tree.insert({i, i});
+
+    SECTION("Ordered iteration") {
+        int expected = 0;
+        for (const auto& pair : tree) {
+            REQUIRE(pair.key == expected);
+            expected += 2;
+        }
+        REQUIRE(expected == 200);
+    }
+
+    SECTION("Reverse iteration with decrement") {
+        auto it = tree.end();
+        int expected = 198;
+        while (it != tree.begin()) {
+            --it;
+            REQUIRE(it->key == expected);
+            expected -= 2;
+        }
+        REQUIRE(expected == -2);
+    }
+
+    SECTION("Lower and upper bound") {
+        REQUIRE(tree.lower_bound(7)->key == 8);
+        REQUIRE(tree.lower_bound(8)->key == 8);
+        REQUIRE(tree.upper_bound(8)->key == 10);
+        REQUIRE(tree.lower_bound(199) == tree.end());
+        REQUIRE(tree.upper_bound(198) == tree.end());
+        REQUIRE(tree.lower_bound(-5)->key == 0);
+    }
+}
+
+TEST_CASE("BTreeTable stress against std::map") {
+    BTreeTable<int, int, 8, 4> tree;
+    std::map<int, int> reference;
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<int> keyDist(0, 2000);
+
+    for (int step = 0; step < 20000; step++) {
+        int key = keyDist(gen);
+        if (step % 3 == 0) {
+            REQUIRE(tree.erase(key) == reference.erase(key));
+        } else {
+            bool inserted = tree.insert({key, step}).second;
+            REQUIRE(inserted == reference.insert({key, step}).second);
+        }
+    }
+
+    REQUIRE(tree.size() == reference.size());
+    auto it = tree.begin();
+    for (const auto& [key, value] : reference) {
+        REQUIRE(it != tree.end());
+        REQUIRE(it->key == key);
+        REQUIRE(it->value == value);
+        ++it;
+    }
+    REQUIRE(it == tree.end());
+
+    for (const auto& [key, value] : reference) tree.erase(key);
+    REQUIRE(tree.empty());
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Table/object_pool.h"
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+    struct Tracked {
+        static inline int alive = 0;
+        std::string value;
+
+        explicit Tracked(std::string v) : value(std::move(v)) {
+            if (value == "throw") throw std::runtime_error("construction failed");
+            alive++;
+        }
+        ~Tracked() { alive--; }
+    };
+}
+
+TEST_CASE("ObjectPool") {
+    using Pool = ObjectPool<Tracked, 1024>;
+    Pool pool;
+
+    SECTION("Objects are placed in slabs and destroyed in place") {
+        std::vector<Tracked*> objects;
+        for (int i = 0; i < 100; i++) objects.push_back(pool.create(std::to_string(i)));
+        REQUIRE(Tracked::alive == 100);
+        REQUIRE(pool.size() == 100);
+        REQUIRE(pool.capacity() >= 100);
+        REQUIRE(pool.slabCount() == (100 + Pool::SLOTS_PER_SLAB - 1) / Pool::SLOTS_PER_SLAB);
+        for (int i = 0; i < 100; i++) REQUIRE(objects[i]->value == std::to_string(i));
+        for (Tracked* object : objects) pool.destroy(object);
+        REQUIRE(Tracked::alive == 0);
+        REQUIRE(pool.size() == 0);
+    }
+
+    SECTION("Freed slots are reused before a new slab is allocated") {
+        std::vector<Tracked*> objects;
+        for (size_t i = 0; i < Pool::SLOTS_PER_SLAB; i++) objects.push_back(pool.create("x"));
+        REQUIRE(pool.slabCount() == 1);
+        std::set<Tracked*> freed;
+        for (size_t i = 0; i < objects.size(); i += 2) {
+            freed.insert(objects[i]);
+            pool.destroy(objects[i]);
+        }
+        for (size_t i = 0; i < freed.size(); i++) REQUIRE(freed.count(pool.create("y")) == 1);
+        REQUIRE(pool.slabCount() == 1);
+        pool.create("z");
+        REQUIRE(pool.slabCount() == 2);
+    }
+
+    SECTION("Slabs are released only when the pool is empty") {
+        Tracked* first = pool.create("a");
+        for (size_t i = 0; i < 2 * Pool::SLOTS_PER_SLAB; i++) pool.destroy(pool.create("b"));
+        REQUIRE_FALSE(pool.release());
+        REQUIRE(pool.slabCount() == 1);
+        pool.destroy(first);
+        REQUIRE(pool.release());
+        REQUIRE(pool.slabCount() == 0);
+        REQUIRE(pool.capacity() == 0);
+        REQUIRE(pool.create("c")->value == "c");
+        REQUIRE(pool.slabCount() == 1);
+    }
+
+    SECTION("A throwing constructor returns the slot") {
+        pool.create("a");
+        REQUIRE_THROWS_AS(pool.create("throw"), std::runtime_error);
+        REQUIRE(pool.size() == 1);
+        Tracked* next = pool.create("b");
+        REQUIRE(next->value == "b");
+        REQUIRE(pool.slabCount() == 1);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Table/snapshot_cell.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("SnapshotCell") {
+    SnapshotCell<std::vector<int>> cell;
+    std::vector<int> source = {1, 2, 3};
+    int builds = 0;
+    auto build = [&] { builds++; return source; };
+
+    SECTION("Snapshot is built lazily and reused until invalidated") {
+        REQUIRE(cell.peek() == nullptr);
+        auto first = cell.get(build);
+        REQUIRE(*first == std::vector<int>{1, 2, 3});
+        REQUIRE(cell.get(build) == first);
+        REQUIRE(builds == 1);
+
+        {
+            auto lock = cell.write_lock();
+            source.push_back(4);
+            cell.invalidate();
+        }
+        REQUIRE(cell.peek() == nullptr);
+        auto second = cell.get(build);
+        REQUIRE(builds == 2);
+        REQUIRE(second->size() == 4);
+        REQUIRE(first->size() == 3);
+    }
+
+    SECTION("Readers always see a complete version while a writer mutates the source") {
+        std::atomic<bool> stop{false};
+        std::atomic<bool> consistent{true};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; r++) {
+            readers.emplace_back([&] {
+                while (!stop.load()) {
+                    auto snapshot = cell.get([&] { return source; });
+                    bool ok = std::is_sorted(snapshot->begin(), snapshot->end()) &&
+                              (snapshot->empty() || (snapshot->front() == 1 && snapshot->back() == static_cast<int>(snapshot->size())));
+                    if (!ok) consistent.store(false);
+                }
+            });
+        }
+        for (int i = 4; i <= 2000; i++) {
+            auto lock = cell.write_lock();
+            if (i % 3 == 0 && source.size() > 3) source.pop_back();
+            else source.push_back(static_cast<int>(source.size()) + 1);
+            cell.invalidate();
+        }
+        stop.store(true);
+        for (auto& reader : readers) reader.join();
+        REQUIRE(consistent.load());
+    }
+}
\ No newline at end of file
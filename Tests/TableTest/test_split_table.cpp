@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Table/split_table.h"
+#include <algorithm>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+TEST_CASE("SplitTable basic operations") {
+    SECTION("Default constructor") {
+        SplitTable<int, std::string> table;
+        REQUIRE(table.empty());
+        REQUIRE(table.size() == 0);
+        REQUIRE(table.begin() == table.end());
+    }
+
+    SECTION("Insert and find") {
+        SplitTable<int, std::string> table = {{2, "two"}, {1, "one"}, {3, "three"}};
+        REQUIRE(table.size() == 3);
+        REQUIRE(table.find(1)->value == "one");
+        REQUIRE(table.find(3)->key == 3);
+        REQUIRE(table.find(4) == table.end());
+        REQUIRE_FALSE(table.insert({1, "again"}).second);
+        REQUIRE(table.at(1) == "one");
+        REQUIRE_THROWS_AS(table.at(42), std::out_of_range);
+    }
+
+    SECTION("Insert or assign, try_emplace and operator[]") {
+        SplitTable<std::string, int> table;
+        REQUIRE(table.insert_or_assign(std::string("a"), 1).second);
+        REQUIRE_FALSE(table.insert_or_assign(std::string("a"), 2).second);
+        REQUIRE(table.at("a") == 2);
+        REQUIRE(table.try_emplace(std::string("c"), 7).second);
+        REQUIRE_FALSE(table.try_emplace(std::string("c"), 8).second);
+        table["b"] = 5;
+        REQUIRE(table.size() == 3);
+        REQUIRE(table["b"] == 5);
+        REQUIRE(table["c"] == 7);
+    }
+
+    SECTION("Erase by key, iterator and range") {
+        SplitTable<int, int> table = {{1, 10}, {2, 20}, {3, 30}, {4, 40}, {5, 50}};
+        REQUIRE(table.erase(2) == 1);
+        REQUIRE(table.erase(2) == 0);
+        auto next = table.erase(table.find(1));
+        REQUIRE(next->key == 3);
+        auto after = table.erase(table.find(3), table.find(5));
+        REQUIRE(after->key == 5);
+        REQUIRE(after->value == 50);
+        REQUIRE(table.size() == 1);
+    }
+
+    SECTION("Copy, move and swap") {
+        SplitTable<int, int> original;
+        for (int i = 0; i < 100; i++) original.insert({i, i * i});
+        SplitTable<int, int> copy(original);
+        REQUIRE(copy == original);
+        SplitTable<int, int> moved(std::move(original));
+        REQUIRE(moved == copy);
+        REQUIRE(original.empty());
+        SplitTable<int, int> other = {{-1, 1}};
+        swap(other, moved);
+        REQUIRE(other == copy);
+        REQUIRE(moved.size() == 1);
+        moved = other;
+        REQUIRE(moved == copy);
+    }
+}
+
+TEST_CASE("SplitTable layout and iterators") {
+    SplitTable<std::string, int> table = {{"delta", 4}, {"alpha", 1}, {"charlie", 3}, {"bravo", 2}};
+
+    SECTION("Keys and values are stored in parallel sorted arrays") {
+        auto keys = table.keys();
+        auto values = table.values();
+        REQUIRE(keys.size() == 4);
+        REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+        REQUIRE(keys[0] == "alpha");
+        REQUIRE(values[0] == 1);
+        REQUIRE(keys[3] == "delta");
+        REQUIRE(values[3] == 4);
+    }
+
+    SECTION("Iterators yield pair-like references") {
+        int expected = 1;
+        for (auto pair : table) {
+            REQUIRE(pair.value == expected);
+            expected++;
+        }
+        for (auto it = table.begin(); it != table.end(); ++it) it->value *= 10;
+        REQUIRE(table.at("charlie") == 30);
+
+        auto it = table.begin() + 2;
+        REQUIRE(it.key() == "charlie");
+        REQUIRE(it[1].key == "delta");
+        REQUIRE(it - table.begin() == 2);
+        REQUIRE(table.begin() < it);
+
+        SplitTable<std::string, int>::const_iterator cit = it;
+        REQUIRE(cit->value == 30);
+        TablePair<std::string, int> copy = *cit;
+        REQUIRE(copy.key == "charlie");
+    }
+
+    SECTION("Reverse iteration") {
+        std::vector<std::string> names;
+        for (auto it = table.rbegin(); it != table.rend(); ++it) names.push_back(it->key);
+        REQUIRE(names == std::vector<std::string>{"delta", "charlie", "bravo", "alpha"});
+    }
+
+    SECTION("Heterogeneous lookup and bounds") {
+        REQUIRE(table.contains(std::string_view("bravo")));
+        REQUIRE(table.find(std::string_view("echo")) == table.end());
+        REQUIRE(table.lower_bound(std::string_view("b"))->key == "bravo");
+        REQUIRE(table.upper_bound(std::string_view("bravo"))->key == "charlie");
+        auto [first, last] = table.equal_range("alpha");
+        REQUIRE(last - first == 1);
+        REQUIRE(table.erase(std::string_view("alpha")) == 1);
+        REQUIRE(table.size() == 3);
+    }
+}
+
+TEST_CASE("SplitTable bulk insert, search modes and memory resource") {
+    SECTION("Bulk insert keeps existing keys and the first duplicate") {
+        SplitTable<int, int> table = {{2, 0}, {4, 0}};
+        std::vector<TablePair<int, int>> batch = {{5, 1}, {1, 1}, {4, 1}, {3, 1}, {1, 2}};
+        REQUIRE(table.insert_bulk(batch.begin(), batch.end()) == 3);
+        REQUIRE(table.size() == 5);
+        REQUIRE(table.at(1) == 1);
+        REQUIRE(table.at(4) == 0);
+        REQUIRE(std::is_sorted(table.keys().begin(), table.keys().end()));
+    }
+
+    SECTION("Eytzinger mode agrees with bisection") {
+        SplitTable<std::string, int> table;
+        table.set_search_mode(TableSearchMode::Eytzinger);
+        for (int i = 0; i < 2000; i += 2) table.insert({"name" + std::to_string(i), i});
+        for (int round = 0; round < 2; round++) {
+            for (int i = 0; i < 2000; i++) {
+                REQUIRE(table.contains("name" + std::to_string(i)) == (i % 2 == 0));
+            }
+        }
+        REQUIRE(table.search_mode() == TableSearchMode::Eytzinger);
+        SplitTable<std::string, int> copy(table);
+        REQUIRE(copy.search_mode() == TableSearchMode::Eytzinger);
+    }
+
+    SECTION("Memory resource") {
+        std::pmr::monotonic_buffer_resource arena;
+        SplitTable<int, int> table(&arena);
+        for (int i = 0; i < 100; i++) table.insert({i, i});
+        REQUIRE(table.get_resource() == &arena);
+        SplitTable<int, int> copy(table);
+        REQUIRE(copy.get_resource() == std::pmr::get_default_resource());
+        copy.swap(table);
+        REQUIRE(copy.get_resource() == std::pmr::get_default_resource());
+        REQUIRE(table.get_resource() == &arena);
+        REQUIRE(copy == table);
+    }
+}
+
+TEST_CASE("SplitTable stress against std::map") {
+    SplitTable<int, int> table;
+    std::map<int, int> reference;
+    std::mt19937 gen(4242);
+    std::uniform_int_distribution<int> keyDist(0, 1000);
+
+    for (int step = 0; step < 10000; step++) {
+        int key = keyDist(gen);
+        if (step % 3 == 0) {
+            REQUIRE(table.erase(key) == reference.erase(key));
+        } else {
+            bool inserted = table.insert({key, step}).second;
+            REQUIRE(inserted == reference.insert({key, step}).second);
+        }
+    }
+
+    REQUIRE(table.size() == reference.size());
+    auto it = table.begin();
+    for (const auto& [key, value] : reference) {
+        REQUIRE(it->key == key);
+        REQUIRE(it->value == value);
+        ++it;
+    }
+    REQUIRE(it == table.end());
+}
\ No newline at end of file
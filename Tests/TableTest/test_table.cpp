@@ -1,10 +1,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include "Table/table.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <thread>
 
 
 TEST_CASE("Constructors and assignment operators") {
@@ -152,6 +155,30 @@ TEST_CASE("Insert operations") {
         REQUIRE(table[2] == "b");
     }
 
+    SECTION("Bulk insert merges unsorted range") {
+        table.insert({{10, "ten"}, {30, "thirty"}});
+        std::vector<std::pair<int, std::string>> batch = {{25, "a"}, {5, "b"}, {30, "c"}, {5, "d"}, {40, "e"}, {15, "f"}};
+        REQUIRE(table.insert_bulk(batch.begin(), batch.end()) == 4);
+        REQUIRE(table.size() == 6);
+        REQUIRE(std::is_sorted(table.begin(), table.end(), [](const auto& a, const auto& b) { return a.key < b.key; }));
+        REQUIRE(table[5] == "b");
+        REQUIRE(table[30] == "thirty");
+        REQUIRE(table[40] == "e");
+        REQUIRE(table.insert_bulk(batch.begin(), batch.end()) == 0);
+    }
+
+    SECTION("Bulk insert of many elements") {
+        std::vector<std::pair<int, std::string>> batch;
+        for (int i = 5000; i > 0; i--) batch.push_back({i * 2, std::to_string(i)});
+        table.insert_bulk(batch.begin(), batch.end());
+        batch.clear();
+        for (int i = 0; i < 5000; i++) batch.push_back({i * 2 + 1, "odd"});
+        REQUIRE(table.insert_bulk(batch.begin(), batch.end()) == 5000);
+        REQUIRE(table.size() == 10000);
+        int expected = 1;
+        for (const auto& pair : table) REQUIRE(pair.key == expected++);
+    }
+
     SECTION("Insert or assign") {
         auto [it1, ins1] = table.insert_or_assign(1, "new");
         REQUIRE(ins1);
@@ -496,6 +523,342 @@ TEST_CASE("Search operations") {
     }
 }
 
+TEST_CASE("Heterogeneous lookup") {
+    Table<std::string, int> table = {{"alpha", 1}, {"beta", 2}, {"gamma", 3}};
+    const auto& const_table = table;
+
+    SECTION("Find by string_view") {
+        std::string_view key = "beta";
+        auto it = table.find(key);
+        REQUIRE(it != table.end());
+        REQUIRE(it->value == 2);
+        REQUIRE(const_table.find(std::string_view("gamma"))->value == 3);
+        REQUIRE(table.find(std::string_view("delta")) == table.end());
+    }
+
+    SECTION("Find by slice of a longer string") {
+        std::string_view path = "/alpha/beta";
+        REQUIRE(table.find(path.substr(1, 5))->value == 1);
+        REQUIRE(table.contains(path.substr(7)));
+        REQUIRE_FALSE(table.contains(path.substr(7, 3)));
+    }
+
+    SECTION("Bounds, count and erase by string_view") {
+        REQUIRE(table.count(std::string_view("alpha")) == 1);
+        REQUIRE(table.lower_bound(std::string_view("b"))->key == "beta");
+        REQUIRE(table.upper_bound(std::string_view("beta"))->key == "gamma");
+        REQUIRE(table.erase(std::string_view("beta")) == 1);
+        REQUIRE(table.erase(std::string_view("beta")) == 0);
+        REQUIRE(table.size() == 2);
+    }
+}
+
+TEST_CASE("Eytzinger search mode") {
+    SECTION("Mode switching") {
+        Table<int, int> table;
+        REQUIRE(table.search_mode() == TableSearchMode::Bisection);
+        table.set_search_mode(TableSearchMode::Eytzinger);
+        REQUIRE(table.search_mode() == TableSearchMode::Eytzinger);
+        Table<int, int> copy(table);
+        REQUIRE(copy.search_mode() == TableSearchMode::Eytzinger);
+        table.set_search_mode(TableSearchMode::Bisection);
+        REQUIRE(table.search_mode() == TableSearchMode::Bisection);
+    }
+
+    SECTION("Signed keys match bisection") {
+        Table<int, int> table;
+        table.set_search_mode(TableSearchMode::Eytzinger);
+        for (int i = -1000; i <= 1000; i += 3) table.insert({i, i * 2});
+        for (int round = 0; round < 2; round++) {
+            for (int i = -1005; i <= 1005; i++) {
+                bool expected = (i + 1000) % 3 == 0 && i >= -1000 && i <= 1000;
+                REQUIRE(table.contains(i) == expected);
+                auto it = table.lower_bound(i);
+                if (it != table.end()) REQUIRE(it->key >= i);
+                if (it != table.begin()) REQUIRE((it - 1)->key < i);
+            }
+        }
+        REQUIRE(table.at(-1000) == -2000);
+    }
+
+    SECTION("Strings with shared prefixes") {
+        Table<std::string, int> table;
+        table.set_search_mode(TableSearchMode::Eytzinger);
+        std::vector<std::string> keys;
+        for (int i = 0; i < 300; i++) keys.push_back("document_" + std::to_string(i * 7));
+        for (int i = 0; i < 100; i++) keys.push_back("f" + std::to_string(i));
+        keys.push_back("");
+        keys.push_back(std::string("ab\0", 3));
+        keys.push_back("ab");
+        for (size_t i = 0; i < keys.size(); i++) table.insert({keys[i], static_cast<int>(i)});
+
+        for (int round = 0; round < 2; round++) {
+            for (size_t i = 0; i < keys.size(); i++) {
+                auto it = table.find(std::string_view(keys[i]));
+                REQUIRE(it != table.end());
+                REQUIRE(it->value == static_cast<int>(i));
+            }
+            REQUIRE_FALSE(table.contains(std::string_view("document_1")));
+            REQUIRE_FALSE(table.contains(std::string_view("zzz")));
+            REQUIRE(table.upper_bound(std::string("document_0"))->key == "document_1001");
+        }
+    }
+
+    SECTION("Index is rebuilt after mutation") {
+        Table<int, int> table;
+        table.set_search_mode(TableSearchMode::Eytzinger);
+        for (int i = 0; i < 200; i++) table.insert({i * 2, i});
+        for (int round = 0; round < 100; round++) REQUIRE(table.contains(100));
+        REQUIRE(table.erase(100) == 1);
+        table.insert({101, 0});
+        for (int round = 0; round < 100; round++) {
+            REQUIRE_FALSE(table.contains(100));
+            REQUIRE(table.contains(101));
+            REQUIRE(table.find(398)->value == 199);
+        }
+        table.clear();
+        REQUIRE_FALSE(table.contains(101));
+    }
+
+    SECTION("Const lookups from several threads") {
+        Table<int, int> table;
+        table.set_search_mode(TableSearchMode::Eytzinger);
+        for (int i = 0; i < 1000; i++) table.insert({i * 2, i});
+        const Table<int, int>& view = table;
+        std::vector<int> found(4, 0);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; t++) {
+            readers.emplace_back([&view, &found, t] {
+                for (int i = 0; i < 2000; i++) {
+                    if (view.contains(i)) found[t]++;
+                }
+            });
+        }
+        for (auto& reader : readers) reader.join();
+        for (int count : found) REQUIRE(count == 1000);
+    }
+}
+
+TEST_CASE("Inline storage") {
+    using SmallTable = Table<std::string, std::string, std::less<>, 4>;
+
+    SECTION("Elements stay inline up to the inline capacity") {
+        SmallTable table;
+        REQUIRE(table.capacity() == 4);
+        for (int i = 0; i < 4; i++) table.insert({std::to_string(i), "v" + std::to_string(i)});
+        REQUIRE(table.capacity() == 4);
+        table.insert({"4", "v4"});
+        REQUIRE(table.capacity() > 4);
+        REQUIRE(table.size() == 5);
+        REQUIRE(table.at("0") == "v0");
+        REQUIRE(table.at("4") == "v4");
+    }
+
+    SECTION("Shrink returns to inline buffer") {
+        SmallTable table;
+        for (int i = 0; i < 10; i++) table.insert({std::to_string(i), std::string(40, 'x')});
+        for (int i = 0; i < 8; i++) table.erase(std::to_string(i));
+        table.shrink_to_fit();
+        REQUIRE(table.capacity() == 4);
+        REQUIRE(table.size() == 2);
+        REQUIRE(table.at("9") == std::string(40, 'x'));
+    }
+
+    SECTION("Copy, move and swap between inline and heap tables") {
+        SmallTable small = {{"a", "1"}, {"b", "2"}};
+        SmallTable large;
+        for (int i = 0; i < 20; i++) large.insert({"k" + std::to_string(i), std::to_string(i)});
+
+        SmallTable smallCopy(small);
+        SmallTable largeCopy(large);
+        REQUIRE(smallCopy == small);
+        REQUIRE(largeCopy == large);
+
+        SmallTable moved(std::move(small));
+        REQUIRE(moved.size() == 2);
+        REQUIRE(small.empty());
+        small.insert({"c", "3"});
+        REQUIRE(small.at("c") == "3");
+
+        swap(moved, large);
+        REQUIRE(moved == largeCopy);
+        REQUIRE(large == smallCopy);
+
+        large = std::move(moved);
+        REQUIRE(large == largeCopy);
+        REQUIRE(moved.empty());
+        moved = smallCopy;
+        REQUIRE(moved == smallCopy);
+    }
+
+    SECTION("Bulk insert merges in place when it fits") {
+        SmallTable table = {{"b", "2"}};
+        std::vector<std::pair<std::string, std::string>> batch = {{"d", "4"}, {"a", "1"}, {"b", "x"}};
+        REQUIRE(table.insert_bulk(batch.begin(), batch.end()) == 2);
+        REQUIRE(table.capacity() == 4);
+        REQUIRE(table.begin()->key == "a");
+        REQUIRE(table.at("b") == "2");
+        REQUIRE((table.end() - 1)->key == "d");
+    }
+}
+
+namespace {
+    /**
+     * @brief Ресурс памяти, считающий выделения и ещё не возвращённые байты.
+     */
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocations = 0;  ///< Количество выделений
+        size_t outstanding = 0;  ///< Выделенные и ещё не освобождённые байты
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            allocations++;
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+}
+
+TEST_CASE("Memory resource") {
+    CountingResource resource;
+
+    SECTION("Storage comes from the resource and is returned to it") {
+        {
+            Table<int, int> table(&resource);
+            REQUIRE(table.get_resource() == &resource);
+            for (int i = 0; i < 100; i++) table.insert({i, i});
+            REQUIRE(resource.allocations > 0);
+            REQUIRE(resource.outstanding >= 100 * sizeof(TablePair<int, int>));
+            table.shrink_to_fit();
+            REQUIRE(resource.outstanding == table.capacity() * sizeof(TablePair<int, int>));
+        }
+        REQUIRE(resource.outstanding == 0);
+    }
+
+    SECTION("Inline storage does not touch the resource") {
+        Table<int, int, std::less<>, 4> table(&resource);
+        table.insert({1, 1});
+        table.insert({2, 2});
+        REQUIRE(resource.allocations == 0);
+        for (int i = 3; i < 10; i++) table.insert({i, i});
+        REQUIRE(resource.allocations > 0);
+    }
+
+    SECTION("Copy uses the default resource, copy assignment keeps the target resource") {
+        Table<int, int> source(&resource);
+        for (int i = 0; i < 10; i++) source.insert({i, i});
+        Table<int, int> copy(source);
+        REQUIRE(copy.get_resource() == std::pmr::get_default_resource());
+        REQUIRE(copy == source);
+
+        CountingResource other;
+        Table<int, int> target(&other);
+        target = source;
+        REQUIRE(target.get_resource() == &other);
+        REQUIRE(target == source);
+        REQUIRE(other.outstanding > 0);
+    }
+
+    SECTION("Move and swap carry the resource with the memory") {
+        Table<int, int> source(&resource);
+        for (int i = 0; i < 10; i++) source.insert({i, i});
+        Table<int, int> moved(std::move(source));
+        REQUIRE(moved.get_resource() == &resource);
+        Table<int, int> other;
+        other.swap(moved);
+        REQUIRE(other.get_resource() == &resource);
+        REQUIRE(moved.get_resource() == std::pmr::get_default_resource());
+        REQUIRE(other.size() == 10);
+    }
+
+    SECTION("Monotonic arena") {
+        std::pmr::monotonic_buffer_resource arena;
+        Table<std::string, int> table({{"b", 2}, {"a", 1}, {"c", 3}}, &arena);
+        REQUIRE(table.get_resource() == &arena);
+        REQUIRE(table.at("a") == 1);
+        REQUIRE(table.size() == 3);
+    }
+}
+
+namespace {
+    size_t handle_moves = 0;  ///< Количество вызовов перемещающих конструкторов Handle
+
+    /**
+     * @brief Владеющий указатель с нетривиальным перемещением, считающий перемещения.
+     * @tparam Tag Различает версию с признаком перемещаемости и без него
+     */
+    template<int Tag>
+    struct Handle {
+        std::unique_ptr<int> ptr;  ///< Владеемое значение
+
+        explicit Handle(int v) : ptr(std::make_unique<int>(v)) {}
+        Handle(Handle&& other) noexcept : ptr(std::move(other.ptr)) { handle_moves++; }
+    };
+
+    using PlainHandle = Handle<0>;
+    using RelocatableHandle = Handle<1>;
+}
+
+template<>
+struct TriviallyRelocatable<RelocatableHandle> : std::true_type {};
+
+TEST_CASE("Trivially relocatable elements") {
+    SECTION("Trait") {
+        REQUIRE(trivially_relocatable_v<int*>);
+        REQUIRE(trivially_relocatable_v<std::unique_ptr<int>>);
+        REQUIRE(trivially_relocatable_v<TablePair<int, std::shared_ptr<int>>>);
+        REQUIRE(trivially_relocatable_v<TablePair<int, RelocatableHandle>>);
+        REQUIRE_FALSE(trivially_relocatable_v<PlainHandle>);
+        REQUIRE_FALSE(trivially_relocatable_v<TablePair<int, PlainHandle>>);
+    }
+
+    SECTION("Shifts and reallocation keep owned values intact") {
+        Table<int, std::unique_ptr<int>> table;
+        for (int i = 1000; i > 0; i--) table.insert({i, std::make_unique<int>(i * 2)});
+        for (int i = 1; i <= 1000; i += 2) REQUIRE(table.erase(i) == 1);
+        table.shrink_to_fit();
+        REQUIRE(table.size() == 500);
+        for (const auto& pair : table) REQUIRE(*pair.value == pair.key * 2);
+        REQUIRE(table.begin()->key == 2);
+    }
+
+    SECTION("Relocatable types are not moved element by element") {
+        Table<int, PlainHandle> plain;
+        Table<int, RelocatableHandle> relocatable;
+        handle_moves = 0;
+        for (int i = 200; i > 0; i--) plain.insert({i, PlainHandle(i)});
+        size_t plain_moves = handle_moves;
+        handle_moves = 0;
+        for (int i = 200; i > 0; i--) relocatable.insert({i, RelocatableHandle(i)});
+        size_t relocatable_moves = handle_moves;
+
+        REQUIRE(relocatable_moves <= 2 * 200);
+        REQUIRE(plain_moves > relocatable_moves * 10);
+        relocatable.erase(100);
+        for (const auto& pair : relocatable) REQUIRE(*pair.value.ptr == pair.key);
+    }
+
+    SECTION("Inline buffer") {
+        Table<int, std::unique_ptr<int>, std::less<>, 4> table;
+        for (int i = 3; i > 0; i--) table.insert({i, std::make_unique<int>(i)});
+        Table<int, std::unique_ptr<int>, std::less<>, 4> moved(std::move(table));
+        REQUIRE(table.empty());
+        for (int i = 4; i <= 10; i++) moved.insert({i, std::make_unique<int>(i)});
+        while (moved.size() > 2) moved.erase(moved.begin());
+        moved.shrink_to_fit();
+        REQUIRE(*moved.at(9) == 9);
+        REQUIRE(*moved.at(10) == 10);
+    }
+}
+
 TEST_CASE("Iterators") {
     Table<int, std::string> table = {{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}};
     const Table<int, std::string> const_table = {{1, "a"}, {2, "b"}, {3, "c"}};
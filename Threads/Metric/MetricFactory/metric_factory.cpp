@@ -4,10 +4,11 @@
 #include <vector>
 
 
-std::vector<std::unique_ptr<IMetric>> MetricFactory::createDefaultSet() {
+std::vector<std::unique_ptr<IMetric>> MetricFactory::createDefaultSet(IUserRepository* users) {
     std::vector<std::unique_ptr<IMetric>> metrics;
     metrics.push_back(std::make_unique<TypeCounterMetric>());
     metrics.push_back(std::make_unique<SizeMetric>());
-    metrics.push_back(std::make_unique<OwnerMetric>());
+    metrics.push_back(std::make_unique<OwnerMetric>(users));
+    metrics.push_back(std::make_unique<DedupMetric>());
     return metrics;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define LAB3_METRIC_FACTORY_H
 
 #include "Threads/Metric/StatMetrics/realisation/stat_metrics.h"
+#include "Repository/UserRep/interface/i_user_repository.h"
 #include <memory>
 #include <vector>
 
@@ -15,9 +16,10 @@ class MetricFactory {
 public:
     /**
      * @brief Создать стандартный набор метрик.
+     * @param users Репозиторий пользователей для вывода имён владельцев (nullptr - выводить идентификаторы)
      * @return Вектор уникальных указателей на метрики
      */
-    static std::vector<std::unique_ptr<IMetric>> createDefaultSet();
+    static std::vector<std::unique_ptr<IMetric>> createDefaultSet(IUserRepository* users = nullptr);
 };
 
 #endif
\ No newline at end of file
@@ -1,10 +1,13 @@
 #include "stat_metrics.h"
+#include "Entity/FSObject/interface/object_cast.h"
+#include "Entity/File/realisation/content_store.h"
+#include <iomanip>
 
 std::string SizeMetric::getName() const { return "Size Statistics"; }
 
 void SizeMetric::process(IFileSystemObject* obj, const ProcessingContext& context) {
     if (!obj) return;
-    auto* file = dynamic_cast<IFile*>(obj);
+    auto* file = asFile(obj);
     if (!file) return;
     unsigned int fileSize = file->getSize();
     totalSize += fileSize;
@@ -73,8 +76,7 @@ std::string OwnerMetric::getName() const { return "Owner Statistics"; }
 
 void OwnerMetric::process(IFileSystemObject* obj, const ProcessingContext& context) {
     if (!obj) return;
-    auto ownerName = obj->getOwner().getName();
-    ownerStats[ownerName]++;
+    ownerStats[obj->getOwnerId()]++;
     totalObjects++;
 }
 
@@ -91,14 +93,17 @@ std::vector<std::string> OwnerMetric::getResults() const {
         results.push_back("No objects found");
         return results;
     }
-    std::vector<std::pair<std::string, unsigned int>> sortedOwners(ownerStats.begin(), ownerStats.end());
+    std::vector<std::pair<unsigned int, unsigned int>> sortedOwners(ownerStats.begin(), ownerStats.end());
     std::sort(sortedOwners.begin(), sortedOwners.end(),[](const auto& a, const auto& b) { return a.second > b.second; });
     size_t limit = std::min<size_t>(5, sortedOwners.size());
     results.push_back("Top " + std::to_string(limit) + " owners:");
     for (size_t i = 0; i < limit; ++i) {
         std::ostringstream oss;
         double percentage = (totalObjects > 0) ? (100.0 * sortedOwners[i].second / totalObjects) : 0.0;
-        oss << sortedOwners[i].first << ": " << sortedOwners[i].second << " (" << std::fixed << std::setprecision(2) << percentage << "%)";
+        User* owner = users ? users->getUserById(sortedOwners[i].first) : nullptr;
+        if (owner) oss << owner->getName();
+        else oss << "uid " << sortedOwners[i].first;
+        oss << ": " << sortedOwners[i].second << " (" << std::fixed << std::setprecision(2) << percentage << "%)";
         results.push_back(oss.str());
     }
     results.push_back("Total objects: " + std::to_string(totalObjects));
@@ -112,7 +117,7 @@ void OwnerMetric::reset() {
 }
 
 std::unique_ptr<IMetric> OwnerMetric::createEmptyClone() const {
-    return std::make_unique<OwnerMetric>();
+    return std::make_unique<OwnerMetric>(users);
 }
 
 void OwnerMetric::mergeFrom(const IMetric& other) {
@@ -128,8 +133,11 @@ std::string TypeCounterMetric::getName() const { return "Type Statistics"; }
 
 void TypeCounterMetric::TypeCounterMetric::process(IFileSystemObject* obj, const ProcessingContext& context) {
     if (!obj) return;
-    auto dto = context.mapper.mapTo(*obj);
-    typeCounts[dto.type]++;
+    // Ключи совпадают с типами DTO мапперов ("FILE", "DIR"), но объект не сериализуется.
+    switch (obj->getType()) {
+        case ObjectType::File: typeCounts["FILE"]++; break;
+        case ObjectType::Directory: typeCounts["DIR"]++; break;
+    }
     totalObjects++;
 }
 
@@ -172,4 +180,64 @@ std::unique_ptr<IMetric> TypeCounterMetric::createEmptyClone() const {
 void TypeCounterMetric::reset() {
     typeCounts.clear();
     totalObjects = 0;
+}
+
+std::string DedupMetric::getName() const { return "Dedup Statistics"; }
+
+void DedupMetric::process(IFileSystemObject* obj, const ProcessingContext& context) {
+    if (!obj) return;
+    auto* file = asFile(obj);
+    if (!file) return;
+    ContentView content = file->viewContentAlways();
+    if (content.empty()) return;
+    ContentStore::BlobId id = 0;
+    ContentView blob = ContentStore::instance().intern(content, &id);
+    uniqueContents.try_emplace(id, std::move(blob));
+    logicalBytes += content.size();
+    fileCount++;
+}
+
+void DedupMetric::processGroup(const std::vector<IFileSystemObject*>& objects, const ProcessingContext& context) {
+    for (auto* obj : objects) {
+        process(obj, context);
+    }
+}
+
+std::vector<std::string> DedupMetric::getResults() const {
+    std::vector<std::string> results;
+    results.push_back("=== Dedup Statistics ===");
+    if (fileCount == 0) {
+        results.push_back("No files found");
+        return results;
+    }
+    unsigned long long uniqueBytes = 0;
+    for (const auto& [id, blob] : uniqueContents) uniqueBytes += blob.size();
+    unsigned long long saved = logicalBytes - uniqueBytes;
+    results.push_back("Logical size: " + std::to_string(logicalBytes) + " bytes in " + std::to_string(fileCount) + " files");
+    results.push_back("Unique content: " + std::to_string(uniqueBytes) + " bytes in " + std::to_string(uniqueContents.size()) + " blobs");
+    std::ostringstream oss;
+    double percentage = logicalBytes > 0 ? 100.0 * saved / logicalBytes : 0.0;
+    oss << "Bytes saved: " << saved << " (" << std::fixed << std::setprecision(2) << percentage << "%)";
+    results.push_back(oss.str());
+    ContentStore::Statistics store = ContentStore::instance().statistics();
+    results.push_back("Content store: " + std::to_string(store.bytes) + " bytes in " + std::to_string(store.blobs) + " blobs");
+    return results;
+}
+
+void DedupMetric::reset() {
+    uniqueContents.clear();
+    logicalBytes = 0;
+    fileCount = 0;
+}
+
+std::unique_ptr<IMetric> DedupMetric::createEmptyClone() const {
+    return std::make_unique<DedupMetric>();
+}
+
+void DedupMetric::mergeFrom(const IMetric& other) {
+    const DedupMetric* otherMetric = dynamic_cast<const DedupMetric*>(&other);
+    if (!otherMetric) return;
+    uniqueContents.insert(otherMetric->uniqueContents.begin(), otherMetric->uniqueContents.end());
+    logicalBytes += otherMetric->logicalBytes;
+    fileCount += otherMetric->fileCount;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef LAB3_STAT_METRICS_H
 #define LAB3_STAT_METRICS_H
 #include "Threads/Metric/StatMetrics/interface/i_metric.h"
+#include "Repository/UserRep/interface/i_user_repository.h"
+#include "Entity/File/realisation/content_store.h"
 #include <map>
 #include <vector>
 #include <memory>
@@ -41,15 +43,21 @@ public:
  * @brief Метрика для сбора статистики по владельцам объектов.
  *
  * Собирает информацию о распределении объектов по владельцам,
- * включая топ-5 владельцев и процентное соотношение.
+ * включая топ-5 владельцев и процентное соотношение. Объекты считаются по
+ * идентификатору владельца, имена разрешаются только при выводе результатов.
  */
 class OwnerMetric : public IMetric {
 private:
-    std::unordered_map<std::string, unsigned int> ownerStats; ///< Статистика по владельцам
+    std::unordered_map<unsigned int, unsigned int> ownerStats; ///< Статистика по идентификаторам владельцев
     unsigned int totalObjects{0}; ///< Общее количество объектов
+    IUserRepository* users{nullptr}; ///< Репозиторий для разрешения имён владельцев
 
 public:
-    OwnerMetric() = default;
+    /**
+     * @brief Конструктор.
+     * @param users Репозиторий пользователей (nullptr - выводить идентификаторы)
+     */
+    explicit OwnerMetric(IUserRepository* users = nullptr) : users(users) {}
     OwnerMetric(const OwnerMetric&) = delete;
     OwnerMetric& operator=(const OwnerMetric&) = delete;
     OwnerMetric(OwnerMetric&& other) noexcept = default;
@@ -98,6 +106,34 @@ public:
     void reset() override;
 };
 
+/**
+ * @brief Метрика дедупликации содержимого файлов.
+ *
+ * Группирует файлы по идентификатору блоба в ContentStore и сообщает, сколько байт
+ * экономится хранением одинакового содержимого одним блобом. Идентификатор выдаётся
+ * хранилищем после побайтового сравнения, поэтому коллизия хешей не объединяет разное
+ * содержимое, а уже зарегистрированное содержимое повторно не хешируется.
+ */
+class DedupMetric : public IMetric {
+private:
+    std::unordered_map<ContentStore::BlobId, ContentView> uniqueContents; ///< Блобы по идентификатору (удерживаются до конца сбора)
+    unsigned long long logicalBytes{0}; ///< Суммарный размер файлов
+    unsigned int fileCount{0};          ///< Количество непустых файлов
 
+public:
+    DedupMetric() = default;
+    DedupMetric(const DedupMetric&) = delete;
+    DedupMetric& operator=(const DedupMetric&) = delete;
+    DedupMetric(DedupMetric&& other) noexcept = default;
+    DedupMetric& operator=(DedupMetric&& other) noexcept = default;
+
+    std::string getName() const override;
+    void process(IFileSystemObject* obj, const ProcessingContext& context) override;
+    void processGroup(const std::vector<IFileSystemObject*>& objects, const ProcessingContext& context) override;
+    std::vector<std::string> getResults() const override;
+    void reset() override;
+    std::unique_ptr<IMetric> createEmptyClone() const override;
+    void mergeFrom(const IMetric& other) override;
+};
 
 #endif
\ No newline at end of file
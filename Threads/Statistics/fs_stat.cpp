@@ -1,4 +1,5 @@
 #include "fs_stat.h"
+#include "Entity/FSObject/interface/object_cast.h"
 #include "Entity/File/interface/i_lockable.h"
 #include <iostream>
 #include <algorithm>
@@ -6,16 +7,17 @@
 #include <vector>
 
 namespace {
-    bool checkAccess(IFileSystemObject* obj, const User* currentUser, const std::vector<unsigned int>& userGroups, bool ignorePermissions) {
+    bool checkAccess(IFileSystemObject* obj, const User* currentUser, const std::vector<unsigned int>& userGroups,
+                     const ACL& inherited, bool ignorePermissions) {
         if (!obj) return false;
         if (ignorePermissions) return true;
         if (!currentUser) return false;
-        return obj->checkPermission(currentUser->getId(), userGroups, PermissionType::Read);
+        return (obj->getPermissionMask(currentUser->getId(), userGroups, inherited) & permissionBit(PermissionType::Read)) != 0;
     }
 
     bool checkFileLock(IFileSystemObject* obj, bool ignorePermissions) {
         if (!obj || ignorePermissions) return true;
-        if (ILockable* lockable = dynamic_cast<ILockable*>(obj)) return lockable->isReadable();
+        if (ILockable* lockable = asLockable(obj)) return lockable->isReadable();
         return true;
     }
 }
@@ -25,15 +27,17 @@ void FileSystemScanner::scanDirectory(IDirectory* directory, Context& context) {
     std::vector<IDirectory*> subdirectories;
     std::vector<IFileSystemObject*> files;
 
-    auto allChildren = directory->listChild();
-    for (auto* child : allChildren) {
-        if (!checkAccess(child, currentUser, userGroups, ignorePermissions)) continue;
-        if (IDirectory* dir = dynamic_cast<IDirectory*>(child)) subdirectories.push_back(dir);
+    IDirectory::ChildSnapshot snapshot = directory->snapshotChildren();
+    // Наследуемые записи одинаковы для всех детей директории, поэтому вычисляются один раз.
+    ACL inherited = repository.resolveInheritance(*directory);
+    for (auto* child : *snapshot) {
+        if (!checkAccess(child, currentUser, userGroups, inherited, ignorePermissions)) continue;
+        if (IDirectory* dir = asDirectory(child)) subdirectories.push_back(dir);
         else if (checkFileLock(child, ignorePermissions)) files.push_back(child);
     }
 
     if (!files.empty()) context.processObjectGroup(files, procContext);
-    context.processObject(dynamic_cast<IFileSystemObject*>(directory), procContext);
+    context.processObject(asObject(directory), procContext);
     if (subdirectories.empty()) return;
 
     int currentThreads = context.getCurrentThreadCount();
@@ -16,6 +16,9 @@
  *
  * Осуществляет рекурсивный обход файловой системы, сбор статистики
  * через метрики и параллельную обработку поддиректорий.
+ *
+ * Потоки сканера только читают дерево. Изменять его во время scan() нельзя:
+ * снимки детей не продлевают жизнь удалённым объектам.
  */
 class FileSystemScanner {
 private:
@@ -1,6 +1,7 @@
 #ifndef LAB3_I_VIEW_H
 #define LAB3_I_VIEW_H
 
+#include "Entity/File/interface/content_view.h"
 #include <string>
 #include <vector>
 
@@ -26,6 +27,12 @@ public:
      */
     virtual void displayMessage(const std::vector<std::string>& messages) = 0;
 
+    /**
+     * @brief Отобразить содержимое файла без сборки в одну строку
+     * @param content Представление содержимого
+     */
+    virtual void displayContent(const ContentView& content) = 0;
+
     /**
      * @brief Отобразить сообщение об ошибке
      * @param error Текст ошибки
@@ -14,6 +14,10 @@ void ConsoleView::displayMessage(const std::vector<std::string> &messages) {
     }
 }
 
+void ConsoleView::displayContent(const ContentView &content) {
+    std::cout << content << std::endl;
+}
+
 void ConsoleView::displayError(const std::string &error) {
     std::cout << "Error: " << error << std::endl;
 }
@@ -26,6 +26,12 @@ public:
      */
     void displayMessage(const std::vector<std::string>& messages) override;
 
+    /**
+     * @brief Отобразить содержимое файла в консоли по фрагментам
+     * @param content Представление содержимого
+     */
+    void displayContent(const ContentView& content) override;
+
     /**
      * @brief Отобразить сообщение об ошибке в консоли
      * @param error Текст ошибки
@@ -1,6 +1,8 @@
 #ifndef LAB3_BASE_H
 #define LAB3_BASE_H
 
+#include "Entity/File/interface/content_view.h"
+#include <optional>
 #include <string>
 #include <vector>
 #include <map>
@@ -53,6 +55,15 @@ enum class PermissionEffect {
     Deny                ///< Запретить действие
 };
 
+/**
+ * @brief Область действия изменения разрешений
+ */
+enum class PermissionScope {
+    Object,             ///< Только сам объект
+    Subtree,            ///< Объект и все объекты его поддерева
+    Inheritable         ///< Наследуемые записи директории (действуют на поддерево)
+};
+
 /**
  * @brief Результат выполнения команды
  */
@@ -60,6 +71,7 @@ struct CommandResult {
     bool success;                     ///< Успешность выполнения команды
     std::vector<std::string> message; ///< Сообщения команды
     std::string error;                ///< Сообщение об ошибке (если есть)
+    std::optional<ContentView> content{}; ///< Содержимое файла, передаваемое без копирования (если есть)
 };
 
 /**
@@ -77,15 +89,18 @@ struct FileSystemResult {
     bool success;                     ///< Успешность выполнения операции
     std::vector<std::string> messages; ///< Сообщения от операции
     std::string error;                ///< Сообщение об ошибке (если есть)
+    std::optional<ContentView> content; ///< Содержимое файла, передаваемое без копирования (если есть)
 
     /**
      * @brief Конструктор результата
      * @param s Флаг успешности операции
      * @param msgs Список сообщений
      * @param err Сообщение об ошибке
+     * @param cont Содержимое файла
      */
-    FileSystemResult(bool s = false, const std::vector<std::string>& msgs = {}, const std::string& err = "")
-        : success(s), messages(msgs), error(err) {}
+    FileSystemResult(bool s = false, const std::vector<std::string>& msgs = {}, const std::string& err = "",
+                     std::optional<ContentView> cont = std::nullopt)
+        : success(s), messages(msgs), error(err), content(std::move(cont)) {}
 };
 
 /**